@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+namespace Detail {
+
+template<typename CodeUnit>
+using UnsignedCodeUnit = Conditional<sizeof(CodeUnit) == 1, u8, u16>;
+
+template<typename CodeUnit>
+ALWAYS_INLINE constexpr u16 code_unit_value(CodeUnit code_unit)
+{
+    return static_cast<UnsignedCodeUnit<CodeUnit>>(code_unit);
+}
+
+// Substring search over code units of either width, so that ASCII storage can be searched for UTF-16 needles and
+// vice versa. Candidate positions are found by comparing a whole vector of positions against the first and last code
+// unit of the needle at once (see http://0x80.pl/articles/simd-strfind.html); only those are compared in full.
+template<typename HaystackCodeUnit, typename NeedleCodeUnit>
+class CodeUnitSearcher {
+public:
+    using Lane = UnsignedCodeUnit<HaystackCodeUnit>;
+    using VectorType = Conditional<sizeof(HaystackCodeUnit) == 1, SIMD::u8x16, SIMD::u16x8>;
+    static constexpr size_t lane_count = sizeof(VectorType) / sizeof(Lane);
+
+    constexpr CodeUnitSearcher(ReadonlySpan<HaystackCodeUnit> haystack, ReadonlySpan<NeedleCodeUnit> needle)
+        : m_haystack(haystack)
+        , m_needle(needle)
+    {
+    }
+
+    // A needle with code units that don't fit into the haystack's code units can't occur in it.
+    constexpr bool needle_fits() const
+    {
+        if constexpr (sizeof(NeedleCodeUnit) > sizeof(HaystackCodeUnit)) {
+            for (auto code_unit : m_needle) {
+                if (code_unit_value(code_unit) > NumericLimits<Lane>::max())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool matches_at(size_t position) const
+    {
+        if constexpr (IsSame<HaystackCodeUnit, NeedleCodeUnit>) {
+            if (!is_constant_evaluated())
+                return __builtin_memcmp(m_haystack.data() + position, m_needle.data(), m_needle.size() * sizeof(NeedleCodeUnit)) == 0;
+        }
+        for (size_t i = 0; i < m_needle.size(); ++i) {
+            if (code_unit_value(m_haystack[position + i]) != code_unit_value(m_needle[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // Returns a vector with a non-zero lane for each of the lane_count positions starting at the given one at which
+    // the needle's first and last code units occur.
+    VectorType candidates_at(size_t position) const
+    {
+        VectorType first;
+        VectorType last;
+        for (size_t lane = 0; lane < lane_count; ++lane) {
+            first[lane] = static_cast<Lane>(code_unit_value(m_needle.first()));
+            last[lane] = static_cast<Lane>(code_unit_value(m_needle.last()));
+        }
+
+        auto firsts = SIMD::load_unaligned<VectorType>(m_haystack.data() + position);
+        auto lasts = SIMD::load_unaligned<VectorType>(m_haystack.data() + position + m_needle.size() - 1);
+        return bit_cast<VectorType>(firsts == first) & bit_cast<VectorType>(lasts == last);
+    }
+
+    static bool has_candidates(VectorType candidates)
+    {
+        auto words = bit_cast<SIMD::u64x2>(candidates);
+        return (words[0] | words[1]) != 0;
+    }
+
+private:
+    ReadonlySpan<HaystackCodeUnit> m_haystack;
+    ReadonlySpan<NeedleCodeUnit> m_needle;
+};
+
+// Comparing every candidate position in full is quadratic in the worst case (e.g. searching "aaa...ab" in "aaa...a"),
+// so once the comparisons have cost more than this many code units per position passed, we switch to Knuth-Morris-Pratt.
+static constexpr size_t verification_budget_per_position = 4;
+static constexpr size_t minimum_verification_budget = 1024;
+
+// Knuth-Morris-Pratt over the code units at haystack_at(0), haystack_at(1), ..., haystack_at(haystack_length - 1),
+// so the same code can search forwards and backwards. Returns the index after the first occurrence of the needle,
+// whose code units are needle_at(0), ..., needle_at(needle_length - 1).
+template<typename HaystackAt, typename NeedleAt>
+Optional<size_t> find_end_of_first_occurrence_with_kmp(size_t haystack_length, HaystackAt haystack_at, size_t needle_length, NeedleAt needle_at)
+{
+    // failure[i] is the length of the longest proper prefix of the needle's first i + 1 code units that is also their suffix.
+    Vector<size_t, 64> failure;
+    failure.resize(needle_length);
+    size_t matched = 0;
+    for (size_t i = 1; i < needle_length; ++i) {
+        while (matched > 0 && needle_at(i) != needle_at(matched))
+            matched = failure[matched - 1];
+        if (needle_at(i) == needle_at(matched))
+            ++matched;
+        failure[i] = matched;
+    }
+
+    matched = 0;
+    for (size_t i = 0; i < haystack_length; ++i) {
+        auto code_unit = haystack_at(i);
+        while (matched > 0 && code_unit != needle_at(matched))
+            matched = failure[matched - 1];
+        if (code_unit == needle_at(matched))
+            ++matched;
+        if (matched == needle_length)
+            return i + 1;
+    }
+    return {};
+}
+
+}
+
+// Returns the first offset at or after start_offset at which the needle occurs in the haystack.
+template<typename HaystackCodeUnit, typename NeedleCodeUnit>
+constexpr Optional<size_t> find_code_units(ReadonlySpan<HaystackCodeUnit> haystack, ReadonlySpan<NeedleCodeUnit> needle, size_t start_offset = 0)
+{
+    Checked maximum_offset { start_offset };
+    maximum_offset += needle.size();
+    if (maximum_offset.has_overflow() || maximum_offset.value() > haystack.size())
+        return {};
+
+    if (needle.is_empty())
+        return start_offset;
+
+    Detail::CodeUnitSearcher searcher { haystack, needle };
+    if (!searcher.needle_fits())
+        return {};
+
+    auto last_position = haystack.size() - needle.size();
+    auto position = start_offset;
+
+    if (!is_constant_evaluated()) {
+        size_t verified_code_units = 0;
+        for (; position + searcher.lane_count <= last_position + 1; position += searcher.lane_count) {
+            auto candidates = searcher.candidates_at(position);
+            if (!searcher.has_candidates(candidates))
+                continue;
+            for (size_t lane = 0; lane < searcher.lane_count; ++lane) {
+                if (candidates[lane] == 0)
+                    continue;
+                if (searcher.matches_at(position + lane))
+                    return position + lane;
+                verified_code_units += needle.size();
+            }
+
+            if (verified_code_units > Detail::minimum_verification_budget + (position - start_offset) * Detail::verification_budget_per_position) {
+                position += searcher.lane_count;
+                auto end = Detail::find_end_of_first_occurrence_with_kmp(
+                    haystack.size() - position, [&](size_t i) { return Detail::code_unit_value(haystack[position + i]); },
+                    needle.size(), [&](size_t i) { return Detail::code_unit_value(needle[i]); });
+                if (!end.has_value())
+                    return {};
+                return position + *end - needle.size();
+            }
+        }
+    }
+
+    for (; position <= last_position; ++position) {
+        if (searcher.matches_at(position))
+            return position;
+    }
+
+    return {};
+}
+
+// Returns the last offset at which the needle occurs in the haystack, such that the occurrence ends at or before end_offset.
+template<typename HaystackCodeUnit, typename NeedleCodeUnit>
+constexpr Optional<size_t> find_last_code_units(ReadonlySpan<HaystackCodeUnit> haystack, ReadonlySpan<NeedleCodeUnit> needle, size_t end_offset = NumericLimits<size_t>::max())
+{
+    end_offset = min(end_offset, haystack.size());
+    if (needle.size() > end_offset)
+        return {};
+
+    if (needle.is_empty())
+        return end_offset;
+
+    Detail::CodeUnitSearcher searcher { haystack, needle };
+    if (!searcher.needle_fits())
+        return {};
+
+    // The number of positions that are left to look at, i.e. the next one to look at is this minus one.
+    auto remaining_positions = end_offset - needle.size() + 1;
+
+    if (!is_constant_evaluated()) {
+        auto initial_remaining_positions = remaining_positions;
+        size_t verified_code_units = 0;
+        for (; remaining_positions >= searcher.lane_count; remaining_positions -= searcher.lane_count) {
+            auto position = remaining_positions - searcher.lane_count;
+            auto candidates = searcher.candidates_at(position);
+            if (!searcher.has_candidates(candidates))
+                continue;
+            for (size_t lane = searcher.lane_count; lane > 0; --lane) {
+                if (candidates[lane - 1] == 0)
+                    continue;
+                if (searcher.matches_at(position + lane - 1))
+                    return position + lane - 1;
+                verified_code_units += needle.size();
+            }
+
+            if (verified_code_units > Detail::minimum_verification_budget + (initial_remaining_positions - position) * Detail::verification_budget_per_position) {
+                // Search the code units before this block backwards, for the reversed needle. The occurrences that
+                // start before it end at or before position + needle.size() - 1.
+                auto search_end = position + needle.size() - 1;
+                auto end = Detail::find_end_of_first_occurrence_with_kmp(
+                    search_end, [&](size_t i) { return Detail::code_unit_value(haystack[search_end - 1 - i]); },
+                    needle.size(), [&](size_t i) { return Detail::code_unit_value(needle[needle.size() - 1 - i]); });
+                if (!end.has_value())
+                    return {};
+                return search_end - *end;
+            }
+        }
+    }
+
+    for (; remaining_positions > 0; --remaining_positions) {
+        if (searcher.matches_at(remaining_positions - 1))
+            return remaining_positions - 1;
+    }
+
+    return {};
+}
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::find_code_units;
+using AK::find_last_code_units;
+#endif
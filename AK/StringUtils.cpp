@@ -11,6 +11,7 @@
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <AK/StringSearch.h>
 #include <AK/StringUtils.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
@@ -232,10 +233,7 @@ Optional<size_t> find(StringView haystack, StringView needle, size_t start)
 {
     if (start > haystack.length())
         return {};
-    auto index = AK::memmem_optional(
-        haystack.characters_without_null_termination() + start, haystack.length() - start,
-        needle.characters_without_null_termination(), needle.length());
-    return index.has_value() ? (*index + start) : index;
+    return find_code_units(haystack.bytes(), needle.bytes(), start);
 }
 
 Optional<size_t> find_last(StringView haystack, char needle)
@@ -251,16 +249,7 @@ Optional<size_t> find_last(StringView haystack, StringView needle)
 {
     if (needle.length() > haystack.length())
         return {};
-
-    for (size_t i = haystack.length() - needle.length();; --i) {
-        if (haystack.substring_view(i, needle.length()) == needle)
-            return i;
-
-        if (i == 0)
-            break;
-    }
-
-    return {};
+    return find_last_code_units(haystack.bytes(), needle.bytes());
 }
 
 Optional<size_t> find_last_not(StringView haystack, char needle)
@@ -17,6 +17,7 @@
 #include <AK/String.h>
 #include <AK/StringConversions.h>
 #include <AK/StringHash.h>
+#include <AK/StringSearch.h>
 #include <AK/Traits.h>
 #include <AK/Types.h>
 #include <AK/UnicodeUtils.h>
@@ -489,28 +490,27 @@ public:
 
     constexpr Optional<size_t> find_code_unit_offset(Utf16View const& needle, size_t start_offset = 0) const
     {
-        if (has_ascii_storage() && needle.has_ascii_storage())
-            return ascii_span().index_of(needle.ascii_span(), start_offset);
-        if (!has_ascii_storage() && !needle.has_ascii_storage())
-            return utf16_span().index_of(needle.utf16_span(), start_offset);
-
-        Checked maximum_offset { start_offset };
-        maximum_offset += needle.length_in_code_units();
-        if (maximum_offset.has_overflow() || maximum_offset.value() > length_in_code_units())
-            return {};
-
-        if (needle.is_empty())
-            return start_offset;
-
-        for (size_t index = start_offset; index <= length_in_code_units() - needle.length_in_code_units();) {
-            auto slice = substring_view(index, needle.length_in_code_units());
-            if (slice == needle)
-                return index;
-
-            index += slice.begin().length_in_code_units();
+        if (has_ascii_storage()) {
+            if (needle.has_ascii_storage())
+                return find_code_units(ascii_span(), needle.ascii_span(), start_offset);
+            return find_code_units(ascii_span(), needle.utf16_span(), start_offset);
         }
+        if (needle.has_ascii_storage())
+            return find_code_units(utf16_span(), needle.ascii_span(), start_offset);
+        return find_code_units(utf16_span(), needle.utf16_span(), start_offset);
+    }
 
-        return {};
+    // Returns the offset of the last occurrence of the needle that ends at or before end_offset.
+    constexpr Optional<size_t> find_last_code_unit_offset(Utf16View const& needle, size_t end_offset = NumericLimits<size_t>::max()) const
+    {
+        if (has_ascii_storage()) {
+            if (needle.has_ascii_storage())
+                return find_last_code_units(ascii_span(), needle.ascii_span(), end_offset);
+            return find_last_code_units(ascii_span(), needle.utf16_span(), end_offset);
+        }
+        if (needle.has_ascii_storage())
+            return find_last_code_units(utf16_span(), needle.ascii_span(), end_offset);
+        return find_last_code_units(utf16_span(), needle.utf16_span(), end_offset);
     }
 
     constexpr Optional<size_t> find_code_unit_offset_ignoring_case(Utf16View const& needle, size_t start_offset = 0) const
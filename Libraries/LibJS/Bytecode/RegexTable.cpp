@@ -10,12 +10,12 @@ namespace JS::Bytecode {
 
 RegexTableIndex RegexTable::insert(ParsedRegex parsed_regex)
 {
-    Regex<ECMA262> regex(parsed_regex.regex, parsed_regex.pattern.to_byte_string(), parsed_regex.flags);
-    m_regexes.append(move(regex));
+    // Literals with the same source and flags share one compiled regex, across executables and realms.
+    m_regexes.append(SharedRegex<ECMA262>::compile(move(parsed_regex.regex), parsed_regex.pattern.to_byte_string(), parsed_regex.flags));
     return m_regexes.size() - 1;
 }
 
-Regex<ECMA262> const& RegexTable::get(RegexTableIndex index) const
+NonnullRefPtr<SharedRegex<ECMA262>> const& RegexTable::get(RegexTableIndex index) const
 {
     return m_regexes[index.value()];
 }
@@ -24,7 +24,7 @@ void RegexTable::dump() const
 {
     outln("Regex Table:");
     for (size_t i = 0; i < m_regexes.size(); i++)
-        outln("{}: {}", i, m_regexes[i].pattern_value);
+        outln("{}: {}", i, m_regexes[i]->regex().pattern_value);
 }
 
 }
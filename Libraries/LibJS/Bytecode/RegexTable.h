@@ -30,12 +30,12 @@ public:
     RegexTable() = default;
 
     RegexTableIndex insert(ParsedRegex);
-    Regex<ECMA262> const& get(RegexTableIndex) const;
+    NonnullRefPtr<SharedRegex<ECMA262>> const& get(RegexTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_regexes.is_empty(); }
 
 private:
-    Vector<Regex<ECMA262>> m_regexes;
+    Vector<NonnullRefPtr<SharedRegex<ECMA262>>> m_regexes;
 };
 
 }
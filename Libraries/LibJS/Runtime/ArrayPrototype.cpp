@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -109,6 +110,21 @@ void ArrayPrototype::initialize(Realm& realm)
     define_direct_property(vm.well_known_symbol_unscopables(), unscopable_list, Attribute::Configurable);
 }
 
+// OPTIMIZATION: Returns the simple element storage of an array whose indexed properties can be read and written
+//               directly, without observable difference to going through the property access methods.
+static SimpleIndexedPropertyStorage* fast_array_storage(Object& object)
+{
+    if (!is<Array>(object))
+        return nullptr;
+    auto& array = static_cast<Array&>(object);
+    if (array.is_proxy_target() || array.may_interfere_with_indexed_property_access() || !array.default_prototype_chain_intact())
+        return nullptr;
+    auto* storage = array.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage*>(storage);
+}
+
 // 10.4.2.3 ArraySpeciesCreate ( originalArray, length ), https://tc39.es/ecma262/#sec-arrayspeciescreate
 static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_array, size_t length)
 {
@@ -381,6 +397,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Write the elements directly if they all exist already, or the array can grow.
+    if (auto* storage = fast_array_storage(this_object); storage && to <= storage->array_like_size()) {
+        if (storage->is_packed() || TRY(this_object->is_extensible())) {
+            for (u64 i = from; i < to; i++)
+                storage->put(i, vm.argument(0));
+            return this_object;
+        }
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -744,6 +769,32 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Arrays that only contain numbers can be searched without looking at each element's type.
+    if (auto* storage = fast_array_storage(this_object); storage && length == storage->array_like_size()) {
+        auto kind = storage->element_kind();
+        if (kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32 || kind == SimpleIndexedPropertyStorage::ElementKind::PackedDouble) {
+            if (!value_to_find.is_number())
+                return Value(false);
+            auto const* elements = storage->elements().data();
+            if (value_to_find.is_nan()) {
+                if (kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32)
+                    return Value(false);
+                for (u64 i = from_index; i < length; ++i) {
+                    if (elements[i].is_nan())
+                        return Value(true);
+                }
+                return Value(false);
+            }
+            auto needle = value_to_find.as_double();
+            for (u64 i = from_index; i < length; ++i) {
+                if (elements[i].as_double() == needle)
+                    return Value(true);
+            }
+            return Value(false);
+        }
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -797,6 +848,23 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Arrays that only contain numbers can be searched without looking at each element's type.
+    if (auto* storage = fast_array_storage(object); storage && length == storage->array_like_size()) {
+        auto kind = storage->element_kind();
+        if (kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32 || kind == SimpleIndexedPropertyStorage::ElementKind::PackedDouble) {
+            // NOTE: NaN is not strictly equal to anything, including itself.
+            if (!search_element.is_number() || search_element.is_nan())
+                return Value(-1);
+            auto const* elements = storage->elements().data();
+            auto needle = search_element.as_double();
+            for (; k < length; ++k) {
+                if (elements[k].as_double() == needle)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -1007,6 +1075,19 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Append to the element storage directly, which also updates the length.
+    if (auto* storage = fast_array_storage(this_object);
+        storage
+        && length == storage->array_like_size()
+        && new_length <= NumericLimits<i32>::max()
+        && static_cast<Array&>(*this_object).length_is_writable()
+        && TRY(this_object->is_extensible())) {
+        for (size_t i = 0; i < argument_count; ++i)
+            storage->put(length + i, vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1410,6 +1491,38 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+static StringView int32_to_decimal(i32 value, AK::Array<char, 12>& buffer)
+{
+    size_t position = buffer.size();
+    auto magnitude = value < 0 ? -static_cast<i64>(value) : static_cast<i64>(value);
+    do {
+        buffer[--position] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0)
+        buffer[--position] = '-';
+    return { buffer.data() + position, buffer.size() - position };
+}
+
+// Sorts Int32 elements like CompareArrayElements without a comparefn, i.e. by their string representation.
+static void sort_int32_elements_as_strings(SimpleIndexedPropertyStorage& storage)
+{
+    Vector<i32> values;
+    values.ensure_capacity(storage.array_like_size());
+    for (auto const& element : storage.elements().span().trim(storage.array_like_size()))
+        values.unchecked_append(element.as_i32());
+
+    // NOTE: Distinct Int32s have distinct string representations, so the sort doesn't have to be stable.
+    quick_sort(values, [](i32 a, i32 b) {
+        AK::Array<char, 12> a_buffer;
+        AK::Array<char, 12> b_buffer;
+        return int32_to_decimal(a, a_buffer) < int32_to_decimal(b, b_buffer);
+    });
+
+    for (size_t i = 0; i < values.size(); ++i)
+        storage.inline_set(i, Value(values[i]));
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1424,6 +1537,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 3. Let len be ? LengthOfArrayLike(obj).
     auto length = TRY(length_of_array_like(vm, object));
 
+    // OPTIMIZATION: The default comparison of Int32s can be done on their decimal digits, without creating any strings.
+    if (comparefn.is_undefined()) {
+        if (auto* storage = fast_array_storage(object);
+            storage
+            && length == storage->array_like_size()
+            && storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::PackedInt32) {
+            sort_int32_elements_as_strings(*storage);
+            return object;
+        }
+    }
+
     // 4. Let SortCompare be a new Abstract Closure with parameters (x, y) that captures comparefn and performs the following steps when called:
     Function<ThrowCompletionOr<double>(Value, Value)> sort_compare = [&](auto x, auto y) -> ThrowCompletionOr<double> {
         // a. Return ? CompareArrayElements(x, y, comparefn).
@@ -17,6 +17,14 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     : IndexedPropertyStorage(IsSimpleStorage::Yes, initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto const& value : m_packed_elements) {
+        if (value.is_special_empty_value()) {
+            ++m_number_of_empty_elements;
+            m_element_kind = ElementKind::Holey;
+        } else {
+            generalize_element_kind(value);
+        }
+    }
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -47,7 +55,10 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
-        m_number_of_empty_elements += index - m_array_size;
+        if (index > m_array_size) {
+            m_number_of_empty_elements += index - m_array_size;
+            m_element_kind = ElementKind::Holey;
+        }
         m_array_size = index + 1;
         grow_storage_if_needed();
     } else {
@@ -58,6 +69,9 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     m_packed_elements[index] = value;
     if (value.is_special_empty_value()) {
         ++m_number_of_empty_elements;
+        m_element_kind = ElementKind::Holey;
+    } else {
+        generalize_element_kind(value);
     }
 }
 
@@ -66,6 +80,7 @@ void SimpleIndexedPropertyStorage::remove(u32 index)
     VERIFY(index < m_array_size);
     ++m_number_of_empty_elements;
     m_packed_elements[index] = js_special_empty_value();
+    m_element_kind = ElementKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -99,6 +114,7 @@ bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 
     if (old_size <= m_array_size) {
         m_number_of_empty_elements += m_array_size - old_size;
+        m_element_kind = ElementKind::Holey;
     } else {
         m_number_of_empty_elements = 0;
         for (auto& value : m_packed_elements) {
@@ -69,6 +69,15 @@ private:
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
+    // What kind of values the elements are known to be. Kinds only ever become more general, in declaration order,
+    // so fast paths can rely on the kind without looking at every element.
+    enum class ElementKind : u8 {
+        PackedInt32,   // Every element is an Int32.
+        PackedDouble,  // Every element is a Number.
+        PackedGeneric, // Every element is present.
+        Holey,         // Elements may be empty.
+    };
+
     SimpleIndexedPropertyStorage()
         : IndexedPropertyStorage(IsSimpleStorage::Yes)
     {
@@ -93,9 +102,22 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::Holey; }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
-        return index < m_array_size && !m_packed_elements.data()[index].is_special_empty_value();
+        if (index >= m_array_size)
+            return false;
+        return is_packed() || !m_packed_elements.data()[index].is_special_empty_value();
+    }
+
+    // Replaces an element that is known to be present.
+    ALWAYS_INLINE void inline_set(u32 index, Value value)
+    {
+        VERIFY(!value.is_special_empty_value());
+        m_packed_elements.data()[index] = value;
+        generalize_element_kind(value);
     }
 
     [[nodiscard]] Optional<ValueAndAttributes> inline_get(u32 index) const
@@ -112,8 +134,17 @@ private:
 
     void grow_storage_if_needed();
 
+    ALWAYS_INLINE void generalize_element_kind(Value value)
+    {
+        if (m_element_kind == ElementKind::PackedInt32 && !value.is_int32())
+            m_element_kind = value.is_number() ? ElementKind::PackedDouble : ElementKind::PackedGeneric;
+        else if (m_element_kind == ElementKind::PackedDouble && !value.is_number())
+            m_element_kind = ElementKind::PackedGeneric;
+    }
+
     Checked<size_t> m_number_of_empty_elements { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
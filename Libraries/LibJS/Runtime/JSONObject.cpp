@@ -4,11 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringConversions.h>
 #include <AK/TypeCasts.h>
+#include <AK/UnicodeUtils.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -18,6 +22,8 @@
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/IndexedProperties.h>
+#include <LibJS/Runtime/Intrinsics.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
@@ -141,11 +147,31 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::stringify)
 // Returns true if a value was serialized, false if the value was undefined (should be omitted).
 ThrowCompletionOr<bool> JSONObject::serialize_json_property(VM& vm, StringifyState& state, PropertyKey const& key, Object* holder)
 {
-    auto& builder = state.builder;
-
     // 1. Let value be ? Get(holder, key).
     auto value = TRY(holder->get(key));
 
+    return serialize_json_property_value(vm, state, key, holder, value);
+}
+
+// The remaining steps of SerializeJSONProperty, for a value that has already been read from the holder.
+ThrowCompletionOr<bool> JSONObject::serialize_json_property_value(VM& vm, StringifyState& state, PropertyKey const& key, Object* holder, Value value)
+{
+    auto& builder = state.builder;
+
+    // OPTIMIZATION: Plain objects and arrays without a toJSON method are not affected by any of the steps before the
+    //               actual serialization, so skip straight to that.
+    if (value.is_object()) {
+        auto& value_object = value.as_object();
+        if (auto const* plan = serialization_plan_for(vm, state, value_object)) {
+            TRY(serialize_json_object(vm, state, value_object, plan));
+            return true;
+        }
+        if (is_array_without_to_json(vm, state, value_object)) {
+            TRY(serialize_json_array(vm, state, value_object));
+            return true;
+        }
+    }
+
     // 2. If Type(value) is Object or BigInt, then
     if (value.is_object() || value.is_bigint()) {
         // a. Let toJSON be ? GetV(value, "toJSON").
@@ -258,8 +284,77 @@ static void write_indent(StringBuilder& builder, StringView gap, size_t depth)
         builder.append(gap);
 }
 
+// Returns the serialization plan for the shape of a plain object whose properties can be read straight from its
+// storage, or nullptr if the object has to go through the generic steps.
+JSONObject::ShapeSerializationPlan const* JSONObject::serialization_plan_for(VM& vm, StringifyState& state, Object const& object)
+{
+    // NOTE: A replacer function could observe and change every value, and a property list changes which keys are serialized.
+    if (state.replacer_function || state.property_list.has_value())
+        return nullptr;
+
+    if (object.is_function() || object.is_array_exotic_object() || object.is_raw_json_object() || object.is_global_object()
+        || object.is_number_object() || object.is_string_object() || object.is_boolean_object() || object.is_bigint_object())
+        return nullptr;
+    if (!object.eligible_for_own_property_enumeration_fast_path() || object.has_parameter_map() || object.has_intrinsic_accessors())
+        return nullptr;
+    if (!object.indexed_properties().is_empty())
+        return nullptr;
+
+    // NOTE: Dictionary shapes change without a transition, so a plan for them could go stale.
+    auto const& shape = object.shape();
+    if (shape.is_dictionary())
+        return nullptr;
+
+    // An inherited toJSON would have to be called, so only allow the unmodified %Object.prototype%.
+    auto& intrinsics = shape.realm().intrinsics();
+    auto const* prototype = shape.prototype();
+    if (prototype != intrinsics.object_prototype().ptr() || &prototype->shape() != intrinsics.default_object_prototype_shape().ptr())
+        return nullptr;
+    if (!prototype->indexed_properties().is_empty())
+        return nullptr;
+
+    auto& plan = state.shape_plans.ensure(&shape, [&] {
+        auto plan = make<ShapeSerializationPlan>();
+        plan->shape = GC::make_root(const_cast<Shape&>(shape));
+
+        for (auto const& [property_key, metadata] : shape.property_table()) {
+            if (!property_key.is_string())
+                continue;
+            if (property_key.as_string() == vm.names.toJSON.as_string())
+                plan->has_to_json = true;
+            if (!metadata.attributes.is_enumerable())
+                continue;
+
+            StringBuilder quoted_key;
+            quote_json_string(quoted_key, property_key.as_string().view());
+            quoted_key.append(':');
+            if (!state.gap.is_empty())
+                quoted_key.append(' ');
+            plan->properties.append({ property_key, metadata.offset, quoted_key.to_string_without_validation() });
+        }
+
+        return plan;
+    });
+
+    if (plan->has_to_json)
+        return nullptr;
+    return plan.ptr();
+}
+
+// Returns whether the object is an array that doesn't have, or inherit, a toJSON method.
+bool JSONObject::is_array_without_to_json(VM& vm, StringifyState const& state, Object const& object)
+{
+    if (state.replacer_function || state.property_list.has_value() || !is<Array>(object))
+        return false;
+
+    auto const& array = static_cast<Array const&>(object);
+    if (!array.default_prototype_chain_intact())
+        return false;
+    return array.shape().property_count() == 0 || !array.shape().lookup(vm.names.toJSON).has_value();
+}
+
 // 25.5.2.4 SerializeJSONObject ( state, value ), https://tc39.es/ecma262/#sec-serializejsonobject
-ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState& state, Object& object)
+ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState& state, Object& object, ShapeSerializationPlan const* plan)
 {
     if (state.seen_objects.contains(&object))
         return vm.throw_completion<TypeError>(ErrorType::JsonCircular);
@@ -272,7 +367,9 @@ ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState
     size_t position_after_open_brace = builder.length();
     bool first = true;
 
-    auto process_property = [&](PropertyKey const& key) -> ThrowCompletionOr<void> {
+    // NOTE: The quoted key includes the colon and the space after it, and the value is only given if it was already
+    //       read from the object.
+    auto process_property = [&](PropertyKey const& key, Optional<StringView> quoted_key = {}, Optional<Value> value = {}) -> ThrowCompletionOr<void> {
         if (key.is_symbol())
             return {};
 
@@ -292,13 +389,19 @@ ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState
         }
 
         // Write key and colon
-        quote_json_string(builder, key.to_string());
-        builder.append(':');
-        if (!state.gap.is_empty())
-            builder.append(' ');
+        if (quoted_key.has_value()) {
+            builder.append(*quoted_key);
+        } else {
+            quote_json_string(builder, key.to_string());
+            builder.append(':');
+            if (!state.gap.is_empty())
+                builder.append(' ');
+        }
 
         // Serialize value
-        bool wrote_value = TRY(serialize_json_property(vm, state, key, &object));
+        bool wrote_value = value.has_value()
+            ? TRY(serialize_json_property_value(vm, state, key, &object, *value))
+            : TRY(serialize_json_property(vm, state, key, &object));
 
         if (wrote_value) {
             first = false;
@@ -309,7 +412,16 @@ ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState
         return {};
     };
 
-    if (state.property_list.has_value()) {
+    if (plan) {
+        for (auto const& property : plan->properties) {
+            // NOTE: Serializing an earlier property may have run code that changed the object. If its shape is still
+            //       the same, the property is at the same offset; otherwise we have to go through [[Get]].
+            auto value = &object.shape() == plan->shape.ptr() ? object.get_direct(property.offset) : TRY(object.get(property.key));
+            if (value.is_accessor())
+                value = TRY(object.get(property.key));
+            TRY(process_property(property.key, property.quoted_key.bytes_as_string_view(), value));
+        }
+    } else if (state.property_list.has_value()) {
         auto property_list = state.property_list.value();
         for (auto& property : property_list)
             TRY(process_property(property));
@@ -358,8 +470,17 @@ ThrowCompletionOr<void> JSONObject::serialize_json_array(VM& vm, StringifyState&
             write_indent(builder, state.gap, state.indent_depth);
         }
 
+        // OPTIMIZATION: Elements in simple storage are plain data properties, and can be read directly.
+        Optional<Value> element;
+        if (auto const* storage = object.indexed_properties().storage(); storage && storage->is_simple_storage() && !object.may_interfere_with_indexed_property_access()) {
+            if (auto value_and_attributes = static_cast<SimpleIndexedPropertyStorage const*>(storage)->inline_get(i); value_and_attributes.has_value())
+                element = value_and_attributes->value;
+        }
+
         // Serialize value (undefined becomes null for arrays)
-        bool wrote_value = TRY(serialize_json_property(vm, state, i, &object));
+        bool wrote_value = element.has_value()
+            ? TRY(serialize_json_property_value(vm, state, i, &object, *element))
+            : TRY(serialize_json_property(vm, state, i, &object));
         if (!wrote_value)
             builder.append("null"sv);
     }
@@ -376,14 +497,44 @@ ThrowCompletionOr<void> JSONObject::serialize_json_array(VM& vm, StringifyState&
     return {};
 }
 
+// Returns the offset of the first code unit at or after the given one that QuoteJSONString doesn't copy as is, i.e.
+// control characters, quotation marks, backslashes and surrogates.
+template<typename CodeUnit>
+static size_t find_code_unit_to_escape(ReadonlySpan<CodeUnit> string, size_t offset)
+{
+    using VectorType = Conditional<sizeof(CodeUnit) == 1, AK::SIMD::u8x16, AK::SIMD::u16x8>;
+    using Lane = Conditional<sizeof(CodeUnit) == 1, u8, u16>;
+    static constexpr size_t lane_count = sizeof(VectorType) / sizeof(Lane);
+
+    // OPTIMIZATION: Look at a whole vector of code units at once, and only at the individual ones once one of them
+    //               needs escaping.
+    for (; offset + lane_count <= string.size(); offset += lane_count) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(string.data() + offset);
+        auto special = bit_cast<VectorType>(chunk < 0x20) | bit_cast<VectorType>(chunk == '"') | bit_cast<VectorType>(chunk == '\\');
+        if constexpr (sizeof(CodeUnit) == 2)
+            special |= bit_cast<VectorType>((chunk & 0xf800) == 0xd800);
+
+        auto words = bit_cast<AK::SIMD::u64x2>(special);
+        if ((words[0] | words[1]) != 0)
+            break;
+    }
+
+    for (; offset < string.size(); ++offset) {
+        auto code_unit = static_cast<Lane>(string[offset]);
+        if (code_unit < 0x20 || code_unit == '"' || code_unit == '\\' || is_unicode_surrogate(code_unit))
+            return offset;
+    }
+
+    return string.size();
+}
+
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
 void JSONObject::quote_json_string(StringBuilder& builder, Utf16View const& string)
 {
     // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     builder.append('"');
 
-    // 2. For each code point C of StringToCodePoints(value), do
-    for (auto code_point : string) {
+    auto append_code_point = [&](u32 code_point) {
         // a. If C is listed in the "Code Point" column of Table 70, then
         // i. Set product to the string-concatenation of product and the escape sequence for C as specified in the "Escape Sequence" column of the corresponding row.
         switch (code_point) {
@@ -421,6 +572,39 @@ void JSONObject::quote_json_string(StringBuilder& builder, Utf16View const& stri
                 builder.append_code_point(code_point);
             }
         }
+    };
+
+    // 2. For each code point C of StringToCodePoints(value), do
+    // OPTIMIZATION: Runs of code points that are copied as is are appended all at once.
+    if (string.has_ascii_storage()) {
+        auto code_units = string.ascii_span();
+        for (size_t offset = 0; offset < code_units.size();) {
+            auto run_end = find_code_unit_to_escape(code_units, offset);
+            builder.append(StringView { code_units.data() + offset, run_end - offset });
+            if (run_end == code_units.size())
+                break;
+            append_code_point(code_units[run_end]);
+            offset = run_end + 1;
+        }
+    } else {
+        auto code_units = string.utf16_span();
+        for (size_t offset = 0; offset < code_units.size();) {
+            auto run_end = find_code_unit_to_escape(code_units, offset);
+            builder.append(string.substring_view(offset, run_end - offset));
+            if (run_end == code_units.size())
+                break;
+
+            // NOTE: Surrogate pairs form a single code point, which is copied as is.
+            auto code_unit = code_units[run_end];
+            if (AK::UnicodeUtils::is_utf16_high_surrogate(code_unit) && run_end + 1 < code_units.size() && AK::UnicodeUtils::is_utf16_low_surrogate(code_units[run_end + 1])) {
+                append_code_point(AK::UnicodeUtils::decode_utf16_surrogate_pair(code_unit, code_units[run_end + 1]));
+                offset = run_end + 2;
+                continue;
+            }
+
+            append_code_point(code_unit);
+            offset = run_end + 1;
+        }
     }
 
     // 3. Set product to the string-concatenation of product and the code unit 0x0022 (QUOTATION MARK).
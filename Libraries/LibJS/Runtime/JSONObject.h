@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibGC/Root.h>
 #include <LibJS/Export.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
 
 namespace JS {
 
@@ -28,6 +32,19 @@ public:
 private:
     explicit JSONObject(Realm&);
 
+    // The enumerable properties of all plain objects with the same shape, with their keys already quoted.
+    struct ShapeSerializationPlan {
+        struct Property {
+            PropertyKey key;
+            u32 offset { 0 };
+            String quoted_key;
+        };
+
+        GC::Root<Shape> shape;
+        bool has_to_json { false };
+        Vector<Property> properties;
+    };
+
     struct StringifyState {
         GC::Ptr<FunctionObject> replacer_function;
         HashTable<GC::Ptr<Object>> seen_objects;
@@ -35,12 +52,16 @@ private:
         String gap;
         Optional<Vector<Utf16String>> property_list;
         StringBuilder builder;
+        HashMap<Shape const*, NonnullOwnPtr<ShapeSerializationPlan>> shape_plans;
     };
 
     // Stringify helpers
     static ThrowCompletionOr<bool> serialize_json_property(VM&, StringifyState&, PropertyKey const& key, Object* holder);
-    static ThrowCompletionOr<void> serialize_json_object(VM&, StringifyState&, Object&);
+    static ThrowCompletionOr<bool> serialize_json_property_value(VM&, StringifyState&, PropertyKey const& key, Object* holder, Value);
+    static ThrowCompletionOr<void> serialize_json_object(VM&, StringifyState&, Object&, ShapeSerializationPlan const* = nullptr);
     static ThrowCompletionOr<void> serialize_json_array(VM&, StringifyState&, Object&);
+    static ShapeSerializationPlan const* serialization_plan_for(VM&, StringifyState&, Object const&);
+    static bool is_array_without_to_json(VM&, StringifyState const&, Object const&);
     static void quote_json_string(StringBuilder&, Utf16View const&);
 
     // Parse helpers
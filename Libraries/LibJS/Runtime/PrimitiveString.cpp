@@ -211,6 +211,15 @@ size_t PrimitiveString::length_in_utf16_code_units() const
     return utf16_string_view().length_in_code_units();
 }
 
+Optional<size_t> PrimitiveString::find_code_unit_offset(Utf16View const& needle) const
+{
+    if (m_is_rope && !needle.is_empty()) {
+        auto const& rope_string = static_cast<RopeString const&>(*this);
+        return rope_string.find_code_unit_offset_in_pieces(needle);
+    }
+    return utf16_string_view().find_code_unit_offset(needle);
+}
+
 bool PrimitiveString::operator==(PrimitiveString const& other) const
 {
     if (this == &other)
@@ -370,6 +379,80 @@ void RopeString::resolve(EncodingPreference preference) const
     m_rhs = nullptr;
 }
 
+Optional<size_t> RopeString::find_code_unit_offset_in_pieces(Utf16View const& needle) const
+{
+    // Occurrences that span several pieces are found by searching a small window around each piece boundary.
+    // Long needles would make those windows expensive, so just resolve the rope for them.
+    static constexpr size_t max_needle_length_for_piecewise_search = 64;
+    if (needle.length_in_code_units() > max_needle_length_for_piecewise_search)
+        return utf16_string_view().find_code_unit_offset(needle);
+
+    // Searching the pieces means walking the whole rope every time, and a rope made of many small pieces is better
+    // searched (and searched again) as one string. So past this many pieces, resolve the rope instead.
+    static constexpr size_t max_pieces_for_piecewise_search = 64;
+
+    Vector<Utf16View, 8> pieces;
+    Vector<PrimitiveString const*, 8> stack;
+    stack.append(m_rhs);
+    stack.append(m_lhs);
+    while (!stack.is_empty()) {
+        auto const* current = stack.take_last();
+        if (current->m_is_rope) {
+            auto& current_rope_string = static_cast<RopeString const&>(*current);
+            stack.append(current_rope_string.m_rhs);
+            stack.append(current_rope_string.m_lhs);
+            continue;
+        }
+        if (pieces.size() == max_pieces_for_piecewise_search)
+            return utf16_string_view().find_code_unit_offset(needle);
+        pieces.append(current->utf16_string_view());
+    }
+
+    auto overlap = needle.length_in_code_units() - 1;
+    StringBuilder window_builder(StringBuilder::Mode::UTF16);
+
+    size_t piece_offset = 0;
+    for (size_t piece_index = 0; piece_index < pieces.size(); ++piece_index) {
+        auto const& piece = pieces[piece_index];
+
+        // Look for occurrences that start before this piece and end inside or after it. Anything before has already
+        // been searched, so the window is made of the last needle length - 1 code units before the boundary and the
+        // first needle length - 1 code units after it, which only the pieces next to the boundary contribute to.
+        if (piece_index > 0 && overlap > 0) {
+            auto first_piece_index = piece_index;
+            size_t code_units_before = 0;
+            while (first_piece_index > 0 && code_units_before < overlap)
+                code_units_before += pieces[--first_piece_index].length_in_code_units();
+
+            window_builder.clear();
+            auto skipped_code_units = code_units_before - min(code_units_before, overlap);
+            size_t code_units_after = 0;
+            for (auto index = first_piece_index; index < pieces.size() && code_units_after < overlap; ++index) {
+                auto window_piece = pieces[index];
+                if (index == first_piece_index)
+                    window_piece = window_piece.substring_view(skipped_code_units);
+                if (index >= piece_index) {
+                    window_piece = window_piece.substring_view(0, min(window_piece.length_in_code_units(), overlap - code_units_after));
+                    code_units_after += window_piece.length_in_code_units();
+                }
+                window_builder.append(window_piece);
+            }
+
+            auto window_start = piece_offset - min(piece_offset, overlap);
+            auto window = window_builder.utf16_string_view();
+            if (auto index = window.find_code_unit_offset(needle); index.has_value() && window_start + *index < piece_offset)
+                return window_start + *index;
+        }
+
+        if (auto index = piece.find_code_unit_offset(needle); index.has_value())
+            return piece_offset + *index;
+
+        piece_offset += piece.length_in_code_units();
+    }
+
+    return {};
+}
+
 RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rhs)
     : PrimitiveString(RopeTag::Rope)
     , m_lhs(lhs)
@@ -54,6 +54,10 @@ public:
 
     size_t length_in_utf16_code_units() const;
 
+    // Returns the code unit offset of the first occurrence of the needle. Ropes are searched piece by piece, so they
+    // don't have to be resolved if the needle is found.
+    Optional<size_t> find_code_unit_offset(Utf16View const& needle) const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
     [[nodiscard]] bool operator==(PrimitiveString const&) const;
@@ -99,6 +103,7 @@ private:
     virtual void visit_edges(Visitor&) override;
 
     void resolve(EncodingPreference) const;
+    Optional<size_t> find_code_unit_offset_in_pieces(Utf16View const& needle) const;
 
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
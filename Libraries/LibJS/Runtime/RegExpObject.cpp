@@ -138,7 +138,7 @@ GC::Ref<RegExpObject> RegExpObject::create(Realm& realm)
     return realm.create<RegExpObject>(realm.intrinsics().regexp_prototype());
 }
 
-GC::Ref<RegExpObject> RegExpObject::create(Realm& realm, Regex<ECMA262> regex, Utf16String pattern, Utf16String flags)
+GC::Ref<RegExpObject> RegExpObject::create(Realm& realm, NonnullRefPtr<SharedRegex<ECMA262>> regex, Utf16String pattern, Utf16String flags)
 {
     return realm.create<RegExpObject>(move(regex), move(pattern), move(flags), realm.intrinsics().regexp_prototype());
 }
@@ -168,14 +168,14 @@ static RegExpObject::Flags to_flag_bits(Utf16View const& flags)
     return flag_bits;
 }
 
-RegExpObject::RegExpObject(Regex<ECMA262> regex, Utf16String pattern, Utf16String flags, Object& prototype)
+RegExpObject::RegExpObject(NonnullRefPtr<SharedRegex<ECMA262>> regex, Utf16String pattern, Utf16String flags, Object& prototype)
     : Object(ConstructWithPrototypeTag::Tag, prototype)
     , m_pattern(move(pattern))
     , m_flags(move(flags))
     , m_flag_bits(to_flag_bits(m_flags))
     , m_regex(move(regex))
 {
-    VERIFY(m_regex->parser_result.error == regex::Error::NoError);
+    VERIFY(m_regex->regex().parser_result.error == regex::Error::NoError);
 }
 
 void RegExpObject::initialize(Realm& realm)
@@ -226,12 +226,12 @@ ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm,
     }
 
     // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
-    Regex<ECMA262> regex(parsed_pattern.to_byte_string(), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
-        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
+    auto regex = SharedRegex<ECMA262>::compile(parsed_pattern.to_byte_string(), parsed_flags);
+    if (regex->regex().parser_result.error != regex::Error::NoError)
+        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex->regex().error_string());
 
     // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+    VERIFY(regex->regex().parser_result.error == regex::Error::NoError);
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -51,7 +51,7 @@ public:
     };
 
     static GC::Ref<RegExpObject> create(Realm&);
-    static GC::Ref<RegExpObject> create(Realm&, Regex<ECMA262> regex, Utf16String pattern, Utf16String flags);
+    static GC::Ref<RegExpObject> create(Realm&, NonnullRefPtr<SharedRegex<ECMA262>> regex, Utf16String pattern, Utf16String flags);
 
     ThrowCompletionOr<GC::Ref<RegExpObject>> regexp_initialize(VM&, Value pattern, Value flags);
     String escape_regexp_pattern() const;
@@ -62,8 +62,8 @@ public:
     Utf16String const& pattern() const { return m_pattern; }
     Utf16String const& flags() const { return m_flags; }
     Flags flag_bits() const { return m_flag_bits; }
-    Regex<ECMA262> const& regex() { return *m_regex; }
-    Regex<ECMA262> const& regex() const { return *m_regex; }
+    Regex<ECMA262> const& regex() { return m_regex->regex(); }
+    Regex<ECMA262> const& regex() const { return m_regex->regex(); }
     Realm& realm() { return *m_realm; }
     Realm const& realm() const { return *m_realm; }
     bool legacy_features_enabled() const { return m_legacy_features_enabled; }
@@ -72,7 +72,7 @@ public:
 
 private:
     RegExpObject(Object& prototype);
-    RegExpObject(Regex<ECMA262> regex, Utf16String pattern, Utf16String flags, Object& prototype);
+    RegExpObject(NonnullRefPtr<SharedRegex<ECMA262>> regex, Utf16String pattern, Utf16String flags, Object& prototype);
 
     virtual bool is_regexp_object() const final { return true; }
     virtual void visit_edges(Visitor&) override;
@@ -83,7 +83,8 @@ private:
     bool m_legacy_features_enabled { false }; // [[LegacyFeaturesEnabled]]
     // Note: This is initialized in RegExpAlloc, but will be non-null afterwards
     GC::Ptr<Realm> m_realm; // [[Realm]]
-    Optional<Regex<ECMA262>> m_regex;
+    // Shared with every other RegExp object (and regex literal) compiled from the same source and flags.
+    RefPtr<SharedRegex<ECMA262>> m_regex;
 };
 
 template<>
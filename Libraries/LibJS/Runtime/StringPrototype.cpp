@@ -49,21 +49,6 @@ static ThrowCompletionOr<GC::Ref<PrimitiveString>> primitive_string_from(VM& vm)
     return TRY(this_value.to_primitive_string(vm));
 }
 
-// 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
-// FIXME: This no longer exists in the spec!
-static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
-{
-    auto r = needle.length_in_code_units();
-    auto s = haystack.length_in_code_units();
-    if (start + r > s)
-        return {};
-    for (size_t i = 0; i < r; ++i) {
-        if (haystack.code_unit_at(start + i) != needle.code_unit_at(i))
-            return {};
-    }
-    return start + r;
-}
-
 // 6.1.4.1 StringIndexOf ( string, searchValue, fromIndex ), https://tc39.es/ecma262/#sec-stringindexof
 Optional<size_t> string_index_of(Utf16View const& string, Utf16View const& search_value, size_t from_index)
 {
@@ -82,17 +67,11 @@ Optional<size_t> string_index_of(Utf16View const& string, Utf16View const& searc
         return {};
 
     // 4. For each integer i such that fromIndex ≤ i ≤ len - searchLen, in ascending order, do
-    for (size_t i = from_index; i <= string_length - search_length; ++i) {
-        // a. Let candidate be the substring of string from i to i + searchLen.
-        auto candidate = string.substring_view(i, search_length);
-
-        // b. If candidate is searchValue, return i.
-        if (candidate == search_value)
-            return i;
-    }
-
+    //     a. Let candidate be the substring of string from i to i + searchLen.
+    //     b. If candidate is searchValue, return i.
     // 5. Return -1.
-    return {};
+    // OPTIMIZATION: This is a vectorized search for the first candidate that is searchValue.
+    return string.find_code_unit_offset(search_value, from_index);
 }
 
 // 6.1.4.2 StringLastIndexOf ( string, searchValue, fromIndex ),
@@ -108,17 +87,11 @@ Optional<size_t> string_last_index_of(Utf16View const& string, Utf16View const&
     VERIFY(from_index + search_length <= string_length);
 
     // 4. For each integer i such that 0 ≤ i ≤ fromIndex, in descending order, do
-    for (size_t i = from_index + 1; i > 0; --i) {
-        // a. Let candidate be the substring of string from i to i + searchLen.
-        auto candidate = string.substring_view(i - 1, search_length);
-
-        // b. If candidate is searchValue, return i.
-        if (candidate == search_value)
-            return i - 1;
-    }
-
+    //     a. Let candidate be the substring of string from i to i + searchLen.
+    //     b. If candidate is searchValue, return i.
     // 5. Return NOT-FOUND.
-    return {};
+    // OPTIMIZATION: This is a vectorized search for the last candidate that is searchValue.
+    return string.find_last_code_unit_offset(search_value, from_index + search_length);
 }
 
 // 7.2.9 Static Semantics: IsStringWellFormedUnicode ( string )
@@ -447,6 +420,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::includes)
     // 5. Let searchStr be ? ToString(searchString).
     auto search_string = TRY(search_string_value.to_primitive_string(vm));
 
+    // OPTIMIZATION: Without a position, a rope can be searched without resolving it.
+    if (position.is_undefined())
+        return Value(string->find_code_unit_offset(search_string->utf16_string_view()).has_value());
+
     size_t start = 0;
     if (!position.is_undefined()) {
         // 6. Let pos be ? ToIntegerOrInfinity(position).
@@ -476,6 +453,12 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::index_of)
     // 3. Let searchStr be ? ToString(searchString).
     auto search_string = TRY(vm.argument(0).to_primitive_string(vm));
 
+    // OPTIMIZATION: Without a position, a rope can be searched without resolving it.
+    if (vm.argument_count() <= 1) {
+        auto index = string->find_code_unit_offset(search_string->utf16_string_view());
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     auto utf16_string_view = string->utf16_string_view();
     auto utf16_search_view = search_string->utf16_string_view();
 
@@ -1211,10 +1194,24 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
     // 8. Let separatorLength be the length of R.
     auto separator_length = separator->length_in_utf16_code_units();
 
+    auto string_view = string->utf16_string_view();
+    auto separator_view = separator->utf16_string_view();
+
+    // 9. If separatorLength = 0, then
+    if (separator_length == 0) {
+        // a. Let head be the substring of S from 0 to lim.
+        auto head_length = min<size_t>(string_length, limit);
+
+        // b. Let codeUnits be a List consisting of the sequence of code units that are the elements of head.
+        // c. Return CreateArrayFromList(codeUnits).
+        for (size_t i = 0; i < head_length; ++i)
+            MUST(array->create_data_property_or_throw(i, PrimitiveString::create(vm, string_view.substring_view(i, 1))));
+        return array;
+    }
+
     // 10. If S is the empty String, return CreateArrayFromList(« S »).
     if (string_length == 0) {
-        if (separator_length > 0)
-            MUST(array->create_data_property_or_throw(0, string));
+        MUST(array->create_data_property_or_throw(0, string));
         return array;
     }
 
@@ -1222,17 +1219,12 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
     size_t start = 0;
 
     // 13. Let j be StringIndexOf(S, R, 0).
-    auto position = start;
+    auto position = string_index_of(string_view, separator_view, 0);
 
     // 14. Repeat, while j ≠ -1,
-    while (position != string_length) {
+    while (position.has_value()) {
         // a. Let T be the substring of S from i to j.
-        auto match = split_match(string->utf16_string_view(), position, separator->utf16_string_view());
-        if (!match.has_value() || match.value() == start) {
-            ++position;
-            continue;
-        }
-        auto segment = string->utf16_string_view().substring_view(start, position - start);
+        auto segment = string_view.substring_view(start, *position - start);
 
         // b. Append T to substrings.
         MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, segment)));
@@ -1243,14 +1235,14 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
             return array;
 
         // d. Set i to j + separatorLength.
-        start = match.value();
+        start = *position + separator_length;
 
         // e. Set j to StringIndexOf(S, R, i).
-        position = start;
+        position = string_index_of(string_view, separator_view, start);
     }
 
     // 15. Let T be the substring of S from i.
-    auto rest = string->utf16_string_view().substring_view(start);
+    auto rest = string_view.substring_view(start);
 
     // 16. Append T to substrings.
     MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, rest)));
@@ -19,6 +19,22 @@ test("basic functionality", () => {
     expect(Array(3).fill(4)).toEqual([4, 4, 4]);
 });
 
+test("changes the kind of elements", () => {
+    var array = [1, 2, 3];
+    array.fill(0.5, 1);
+    expect(array).toEqual([1, 0.5, 0.5]);
+    expect(array.indexOf(0.5)).toBe(1);
+    array.fill("a", 0, 1);
+    expect(array).toEqual(["a", 0.5, 0.5]);
+    expect(array.includes("a")).toBeTrue();
+});
+
+test("non-extensible holey array", () => {
+    var array = [1, , 3];
+    Object.preventExtensions(array);
+    expect(() => array.fill(0)).toThrow(TypeError);
+});
+
 test("is unscopable", () => {
     expect(Array.prototype[Symbol.unscopables].fill).toBeTrue();
     const array = [];
@@ -17,6 +17,29 @@ test("basic functionality", () => {
     expect(array.includes("friends", 100)).toBeFalse();
 });
 
+test("arrays of numbers", () => {
+    var array = [1, 2, 3];
+    expect(array.includes(2)).toBeTrue();
+    expect(array.includes(2.0)).toBeTrue();
+    expect(array.includes("2")).toBeFalse();
+    expect(array.includes(NaN)).toBeFalse();
+    expect(array.includes(2, 2)).toBeFalse();
+
+    array.push(1.5, NaN, -0);
+    expect(array.includes(1.5)).toBeTrue();
+    expect(array.includes(NaN)).toBeTrue();
+    expect(array.includes(0)).toBeTrue();
+    expect(array.includes(4)).toBeFalse();
+
+    array.push("foo");
+    expect(array.includes("foo")).toBeTrue();
+    expect(array.includes(NaN)).toBeTrue();
+
+    var holey = [1, 2, , 4];
+    expect(holey.includes(undefined)).toBeTrue();
+    expect(holey.includes(4)).toBeTrue();
+});
+
 test("is unscopable", () => {
     expect(Array.prototype[Symbol.unscopables].includes).toBeTrue();
     const array = [];
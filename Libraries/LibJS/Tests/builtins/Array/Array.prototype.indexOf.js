@@ -23,3 +23,19 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("arrays of numbers", () => {
+    var array = [1, 2, 3, 2];
+    expect(array.indexOf(2)).toBe(1);
+    expect(array.indexOf(2, 2)).toBe(3);
+    expect(array.indexOf("2")).toBe(-1);
+
+    array.push(0.5, NaN, -0);
+    expect(array.indexOf(0.5)).toBe(4);
+    expect(array.indexOf(NaN)).toBe(-1);
+    expect(array.indexOf(0)).toBe(6);
+
+    var holey = [1, , 3];
+    expect(holey.indexOf(undefined)).toBe(-1);
+    expect(holey.indexOf(3)).toBe(2);
+});
@@ -20,4 +20,18 @@ describe("normal behavior", () => {
         expect(a.push(1, 2, 3)).toBe(5);
         expect(a).toEqual(["hello", "friends", 1, 2, 3]);
     });
+
+    test("array of numbers", () => {
+        var a = [1, 2];
+        expect(a.push(3, 4.5, "five")).toBe(5);
+        expect(a).toEqual([1, 2, 3, 4.5, "five"]);
+        expect(a.includes("five")).toBeTrue();
+    });
+
+    test("non-extensible array", () => {
+        var a = [1, 2];
+        Object.preventExtensions(a);
+        expect(() => a.push(3)).toThrow(TypeError);
+        expect(a).toEqual([1, 2]);
+    });
 });
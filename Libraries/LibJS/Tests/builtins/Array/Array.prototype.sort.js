@@ -172,4 +172,10 @@ describe("Array.prototype.sort", () => {
         );
         Array.prototype.sort.call(obj);
     });
+
+    test("that it sorts Int32 arrays by their string representation", () => {
+        expect([10, 9, -1, 1, -20].sort()).toEqual([-1, -20, 1, 10, 9]);
+        expect([2147483647, -2147483648, 0, 100, 21].sort()).toEqual([-2147483648, 0, 100, 21, 2147483647]);
+        expect([3, 1.5, 2].sort()).toEqual([1.5, 2, 3]);
+    });
 });
@@ -123,6 +123,80 @@ describe("correct behavior", () => {
     test("sparse arrays", () => {
         expect(JSON.stringify(Array(3))).toBe("[null,null,null]");
     });
+
+    test("objects with the same shape", () => {
+        const points = [];
+        for (let i = 0; i < 3; ++i) points.push({ x: i, "y\n": "\"" + i, z: undefined });
+        expect(JSON.stringify(points)).toBe('[{"x":0,"y\\n":"\\"0"},{"x":1,"y\\n":"\\"1"},{"x":2,"y\\n":"\\"2"}]');
+        expect(JSON.stringify(points, null, 1)).toBe(
+            '[\n {\n  "x": 0,\n  "y\\n": "\\"0"\n },\n {\n  "x": 1,\n  "y\\n": "\\"1"\n },\n {\n  "x": 2,\n  "y\\n": "\\"2"\n }\n]'
+        );
+    });
+
+    test("getters and toJSON", () => {
+        const withGetter = { a: 1, b: 2 };
+        Object.defineProperty(withGetter, "b", { get: () => "got", enumerable: true });
+        expect(JSON.stringify(withGetter)).toBe('{"a":1,"b":"got"}');
+
+        expect(JSON.stringify({ a: 1, toJSON: () => "own" })).toBe('"own"');
+
+        const array = [1, 2];
+        array.toJSON = () => "array";
+        expect(JSON.stringify([array])).toBe('["array"]');
+
+        Object.prototype.toJSON = function () {
+            return "inherited";
+        };
+        try {
+            expect(JSON.stringify({ a: 1 })).toBe('"inherited"');
+            expect(JSON.stringify([{ a: 1 }])).toBe('["inherited"]');
+        } finally {
+            delete Object.prototype.toJSON;
+        }
+        expect(JSON.stringify({ a: 1 })).toBe('{"a":1}');
+    });
+
+    test("objects changed during serialization", () => {
+        const object = {
+            a: {
+                toJSON() {
+                    delete object.b;
+                    Object.defineProperty(object, "c", { get: () => "getter", enumerable: true });
+                    object.d = "added";
+                    return "a";
+                },
+            },
+            b: "b",
+            c: "c",
+        };
+        expect(JSON.stringify(object)).toBe('{"a":"a","c":"getter"}');
+
+        const array = [
+            {
+                toJSON() {
+                    array.length = 2;
+                    Array.prototype[2] = "inherited";
+                    return 0;
+                },
+            },
+            1,
+            2,
+            3,
+        ];
+        try {
+            expect(JSON.stringify(array)).toBe('[0,1,"inherited",null]');
+        } finally {
+            delete Array.prototype[2];
+        }
+    });
+
+    test("long strings", () => {
+        const text = "The quick brown fox jumps over the lazy dog. ";
+        expect(JSON.stringify(text.repeat(4))).toBe('"' + text.repeat(4) + '"');
+        expect(JSON.stringify(text + '"quoted"\t\\' + text)).toBe('"' + text + '\\"quoted\\"\\t\\\\' + text + '"');
+        expect(JSON.stringify(text + "\u0001😀\ud800" + text)).toBe('"' + text + "\\u0001😀\\ud800" + text + '"');
+        expect(JSON.stringify("😀".repeat(10) + "\udc00")).toBe('"' + "😀".repeat(10) + '\\udc00"');
+    });
 });
 
 describe("errors", () => {
@@ -18,3 +18,14 @@ test("UTF-16", () => {
     expect(s.includes("\ude00")).toBeTrue();
     expect(s.includes("a")).toBeFalse();
 });
+
+test("concatenated strings", () => {
+    var s = "a".repeat(20);
+    s += "b";
+    s += "c".repeat(20);
+    expect(s.includes("ab")).toBeTrue();
+    expect(s.includes("abc")).toBeTrue();
+    expect(s.includes("bc")).toBeTrue();
+    expect(s.includes("ba")).toBeFalse();
+    expect(s.includes("a".repeat(21))).toBeFalse();
+});
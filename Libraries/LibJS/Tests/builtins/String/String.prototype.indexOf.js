@@ -29,3 +29,30 @@ test("UTF-16", () => {
     expect(s.indexOf("\ude00")).toBe(1);
     expect(s.indexOf("a")).toBe(-1);
 });
+
+test("concatenated strings", () => {
+    var s = "hello ";
+    s += "fri";
+    s += "ends";
+    s += "! 😀";
+    expect(s.indexOf("hello")).toBe(0);
+    expect(s.indexOf("o fr")).toBe(4);
+    expect(s.indexOf("friends")).toBe(6);
+    expect(s.indexOf("iend")).toBe(8);
+    expect(s.indexOf("s! ")).toBe(12);
+    expect(s.indexOf("😀")).toBe(15);
+    expect(s.indexOf("enemies")).toBe(-1);
+    expect(s.indexOf("")).toBe(0);
+    expect(s).toBe("hello friends! 😀");
+});
+
+test("strings concatenated from many pieces", () => {
+    var s = "";
+    for (var i = 0; i < 200; ++i) s += i % 10;
+    s += "needle";
+    for (var i = 0; i < 3; ++i) {
+        expect(s.indexOf("89012")).toBe(8);
+        expect(s.indexOf("9needle")).toBe(199);
+        expect(s.indexOf("needles")).toBe(-1);
+    }
+});
@@ -28,3 +28,13 @@ test("UTF-16", () => {
     expect(s.lastIndexOf("\ude00")).toBe(1);
     expect(s.lastIndexOf("a")).toBe(-1);
 });
+
+test("long strings", () => {
+    var s = "the quick brown fox jumps over the lazy dog, the quick brown cat";
+    expect(s.lastIndexOf("quick")).toBe(49);
+    expect(s.lastIndexOf("quick", 48)).toBe(4);
+    expect(s.lastIndexOf("the", 30)).toBe(0);
+    expect(s.lastIndexOf("cat")).toBe(61);
+    expect(s.lastIndexOf("dog", 100)).toBe(40);
+    expect(s.lastIndexOf("cow")).toBe(-1);
+});
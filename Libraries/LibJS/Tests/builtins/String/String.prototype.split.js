@@ -66,3 +66,11 @@ test("UTF-16", () => {
     expect(s.split(/\ud83d/)).toEqual(["", "\ude00", "\ude00", "\ude00"]);
     expect(s.split(/\ude00/)).toEqual(["\ud83d", "\ud83d", "\ud83d", ""]);
 });
+
+test("long strings", () => {
+    var s = "alpha, beta, gamma, delta, epsilon, zeta, eta, theta, iota, kappa";
+    expect(s.split(", ")).toEqual(["alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta", "iota", "kappa"]);
+    expect(s.split(", ", 3)).toEqual(["alpha", "beta", "gamma"]);
+    expect(s.split("", 3)).toEqual(["a", "l", "p"]);
+    expect(s.split("a, ")).toEqual(["alph", "bet", "gamm", "delt", "epsilon, zet", "et", "thet", "iot", "kappa"]);
+});
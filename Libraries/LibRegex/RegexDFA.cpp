@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <AK/UnicodeUtils.h>
+#include <LibRegex/RegexDFA.h>
+
+namespace regex {
+
+static constexpr u64 make_thread(size_t instruction_position, u32 string_offset = 0)
+{
+    return (static_cast<u64>(instruction_position) << 32) | string_offset;
+}
+
+static constexpr size_t instruction_position_of(u64 thread)
+{
+    return thread >> 32;
+}
+
+static constexpr u32 string_offset_of(u64 thread)
+{
+    return thread & 0xffffffff;
+}
+
+static size_t compare_size(FlatByteCode const& bytecode, size_t instruction_position)
+{
+    // Compare <argc> <args_size> <args>*, CompareSimple <args_size> <args>*
+    if (static_cast<OpCodeId>(bytecode[instruction_position]) == OpCodeId::Compare)
+        return bytecode[instruction_position + 2] + 3;
+    return bytecode[instruction_position + 1] + 2;
+}
+
+static Vector<CompareTypeAndValuePair> flat_compares_of(OpCode<FlatByteCode>& opcode)
+{
+    if (opcode.opcode_id() == OpCodeId::Compare)
+        return to<OpCode_Compare>(opcode).flat_compares();
+    return to<OpCode_CompareSimple>(opcode).flat_compares();
+}
+
+bool LazyDFA::is_supported(FlatByteCode const& bytecode)
+{
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+        case OpCodeId::CompareSimple: {
+            auto compares = flat_compares_of(opcode);
+            for (auto const& compare : compares) {
+                switch (compare.type) {
+                case CharacterCompareType::Reference:
+                case CharacterCompareType::NamedReference:
+                case CharacterCompareType::StringSet:
+                    return false;
+                case CharacterCompareType::String:
+                    if (compares.size() != 1 || bytecode.get_u16_string(compare.value).is_empty())
+                        return false;
+                    break;
+                default:
+                    break;
+                }
+            }
+            break;
+        }
+        case OpCodeId::Jump:
+        case OpCodeId::JumpNonEmpty:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::FailIfEmpty:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::Exit:
+            break;
+        default:
+            return false;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return true;
+}
+
+NonnullOwnPtr<LazyDFA> LazyDFA::create(FlatByteCode const& bytecode)
+{
+    auto dfa = adopt_own(*new LazyDFA);
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+            dfa->m_has_anchors = true;
+            break;
+        case OpCodeId::Compare:
+        case OpCodeId::CompareSimple: {
+            auto compares = flat_compares_of(opcode);
+            if (compares.size() != 1 || compares.first().type != CharacterCompareType::String)
+                break;
+
+            // Multi-character strings are matched one character per DFA step.
+            auto string = bytecode.get_u16_string(compares.first().value);
+            if (string.length_in_code_units() == 1)
+                break;
+
+            StringCompare compare;
+            auto view = string.view();
+            for (size_t i = 0; i < view.length_in_code_units(); ++i)
+                compare.code_units.append(view.code_unit_at(i));
+            for (auto code_point : view)
+                compare.code_points.append(code_point);
+            dfa->m_string_compares.set(state.instruction_position, move(compare));
+            break;
+        }
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    return dfa;
+}
+
+bool LazyDFA::can_run_with(RegexStringView const& view, AllOptions options) const
+{
+    // Only UTF-16 input is decoded per code point here, leave Unicode-mode UTF-8 input to the VM.
+    if (view.unicode() && !view.is_u16_view())
+        return false;
+
+    // Anchors are only modelled as "start of input" and "end of input".
+    if (m_has_anchors
+        && (options.has_flag_set(AllFlags::Multiline)
+            || options.has_flag_set(AllFlags::MatchNotBeginOfLine)
+            || options.has_flag_set(AllFlags::MatchNotEndOfLine)))
+        return false;
+
+    // Case-insensitive string compares may fold to a different number of characters.
+    if (!m_string_compares.is_empty() && options.has_flag_set(AllFlags::Insensitive))
+        return false;
+
+    return true;
+}
+
+LazyDFA::Result LazyDFA::find_match_starting_at(FlatByteCode const& bytecode, RegexStringView const& view, AllOptions options, size_t code_unit_index)
+{
+    return run(bytecode, view, options, code_unit_index, false);
+}
+
+LazyDFA::Result LazyDFA::find_match_at_or_after(FlatByteCode const& bytecode, RegexStringView const& view, AllOptions options, size_t code_unit_index)
+{
+    return run(bytecode, view, options, code_unit_index, true);
+}
+
+void LazyDFA::reset_for(RegexStringView const& view, AllOptions options)
+{
+    // Compares depend on the options (case insensitivity, dot semantics, ...) and on whether we read
+    // code points or code units, so a cache built for one configuration can't be used for another.
+    if (m_is_configured && m_options.value() == options.value() && m_unicode == view.unicode())
+        return;
+
+    m_options = options;
+    m_unicode = view.unicode();
+    m_is_configured = true;
+    flush_cache();
+}
+
+void LazyDFA::flush_cache()
+{
+    m_states.clear();
+    m_state_indices.clear();
+    m_start_states.fill({});
+}
+
+LazyDFA::Result LazyDFA::run(FlatByteCode const& bytecode, RegexStringView const& view, AllOptions options, size_t code_unit_index, bool unanchored)
+{
+    reset_for(view, options);
+    m_cache_flushes_in_current_search = 0;
+
+    Optional<u32> current = start_state(bytecode, unanchored, code_unit_index == 0);
+    auto length_in_code_units = view.length_in_code_units();
+
+    for (;;) {
+        auto const& state = m_states[*current];
+        if (state.is_match)
+            return Result::Match;
+        if (state.is_dead)
+            return Result::NoMatch;
+        if (code_unit_index >= length_in_code_units)
+            return state.is_match_at_end ? Result::Match : Result::NoMatch;
+
+        u32 code_point;
+        if (m_unicode) {
+            code_point = view.code_point_at(code_unit_index);
+            code_unit_index += view.length_of_code_point(code_point);
+        } else {
+            code_point = view.unicode_aware_code_point_at(code_unit_index);
+            ++code_unit_index;
+        }
+
+        current = transition(bytecode, *current, code_point);
+        if (!current.has_value())
+            return Result::GaveUp;
+    }
+}
+
+u32 LazyDFA::start_state(FlatByteCode const& bytecode, bool unanchored, bool at_begin)
+{
+    auto& start_state = m_start_states[(unanchored ? 2 : 0) + (at_begin ? 1 : 0)];
+    if (!start_state.has_value()) {
+        Vector<Thread> seeds { make_thread(0) };
+        start_state = state_for(bytecode, move(seeds), unanchored, at_begin);
+    }
+    return *start_state;
+}
+
+u32 LazyDFA::state_for(FlatByteCode const& bytecode, Vector<Thread>&& seeds, bool unanchored, bool at_begin)
+{
+    StateKey key { {}, unanchored, at_begin };
+    auto is_match = closure(bytecode, seeds, at_begin, false, &key.threads);
+
+    if (auto index = m_state_indices.get(key); index.has_value())
+        return *index;
+
+    State state;
+    state.is_match = is_match;
+    state.is_match_at_end = is_match;
+    if (!is_match && !key.threads.is_empty()) {
+        // The only difference at the end of input is that pending CheckEnd threads get to continue.
+        auto worklist = key.threads;
+        state.is_match_at_end = closure(bytecode, worklist, at_begin, true, nullptr);
+    }
+    state.is_dead = !is_match && !unanchored && key.threads.is_empty();
+    state.ascii_transitions.fill(unknown_transition);
+
+    u32 index = m_states.size();
+    m_state_indices.set(key, index);
+    state.key = move(key);
+    m_states.append(move(state));
+    return index;
+}
+
+Optional<u32> LazyDFA::transition(FlatByteCode const& bytecode, u32 state_index, u32 code_point)
+{
+    {
+        auto const& state = m_states[state_index];
+        if (code_point < state.ascii_transitions.size()) {
+            if (auto next = state.ascii_transitions[code_point]; next != unknown_transition)
+                return next;
+        } else if (auto next = state.transitions.get(code_point); next.has_value()) {
+            return *next;
+        }
+    }
+
+    if (m_states.size() >= max_cached_states) {
+        // Patterns with an explosive number of states would just keep refilling the cache, so give up
+        // on them and let the VM do its thing.
+        if (++m_cache_flushes_in_current_search > max_cache_flushes_per_search)
+            return {};
+
+        auto key = m_states[state_index].key;
+        flush_cache();
+        ++m_cache_flush_count;
+        state_index = state_for(bytecode, move(key.threads), key.unanchored, key.at_begin);
+    }
+
+    Vector<Thread> seeds;
+    auto unanchored = m_states[state_index].key.unanchored;
+    for (auto thread : m_states[state_index].key.threads) {
+        auto instruction_position = instruction_position_of(thread);
+        auto opcode_id = static_cast<OpCodeId>(bytecode[instruction_position]);
+        if (opcode_id != OpCodeId::Compare && opcode_id != OpCodeId::CompareSimple)
+            continue; // Pending CheckEnd, which fails as soon as we consume anything.
+
+        auto next_instruction_position = instruction_position + compare_size(bytecode, instruction_position);
+
+        if (auto it = m_string_compares.find(instruction_position); it != m_string_compares.end()) {
+            auto const& characters = m_unicode ? it->value.code_points : it->value.code_units;
+            auto offset = string_offset_of(thread);
+            if (characters[offset] != code_point)
+                continue;
+            if (offset + 1 < characters.size())
+                seeds.append(make_thread(instruction_position, offset + 1));
+            else
+                seeds.append(make_thread(next_instruction_position));
+            continue;
+        }
+
+        if (compare_matches(bytecode, instruction_position, code_point))
+            seeds.append(make_thread(next_instruction_position));
+    }
+
+    // An unanchored search may start a new match attempt at every position.
+    if (unanchored)
+        seeds.append(make_thread(0));
+
+    auto next = state_for(bytecode, move(seeds), unanchored, false);
+
+    auto& state = m_states[state_index];
+    if (code_point < state.ascii_transitions.size())
+        state.ascii_transitions[code_point] = next;
+    else
+        state.transitions.set(code_point, next);
+    return next;
+}
+
+bool LazyDFA::closure(FlatByteCode const& bytecode, Vector<Thread>& worklist, bool at_begin, bool at_end, Vector<Thread>* threads) const
+{
+    bool is_match = false;
+    HashTable<Thread> visited;
+    auto state = MatchState::only_for_enumeration();
+
+    auto add_thread = [&](Thread thread) {
+        if (threads)
+            threads->append(thread);
+    };
+
+    while (!worklist.is_empty()) {
+        auto thread = worklist.take_last();
+        if (visited.set(thread) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        auto instruction_position = instruction_position_of(thread);
+        if (instruction_position >= bytecode.size()) {
+            is_match = true;
+            continue;
+        }
+
+        // In the middle of a string compare, this thread can only consume more input.
+        if (string_offset_of(thread) != 0) {
+            add_thread(thread);
+            continue;
+        }
+
+        state.instruction_position = instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next = instruction_position + opcode.size();
+        auto jump_target = [&] { return next + static_cast<ssize_t>(opcode.argument(0)); };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+        case OpCodeId::CompareSimple:
+            add_thread(thread);
+            break;
+        case OpCodeId::Jump:
+            worklist.append(make_thread(jump_target()));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::JumpNonEmpty:
+            // NOTE: JumpNonEmpty and FailIfEmpty only prune loop iterations that consumed nothing, which end up
+            //       at the same input position as skipping the loop would. Following every edge here can thus
+            //       only add paths the VM prunes, never lose a match the VM would find.
+            worklist.append(make_thread(next));
+            worklist.append(make_thread(jump_target()));
+            break;
+        case OpCodeId::Checkpoint:
+        case OpCodeId::FailIfEmpty:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            worklist.append(make_thread(next));
+            break;
+        case OpCodeId::CheckBegin:
+            if (at_begin)
+                worklist.append(make_thread(next));
+            break;
+        case OpCodeId::CheckEnd:
+            if (at_end)
+                worklist.append(make_thread(next));
+            else
+                add_thread(thread);
+            break;
+        case OpCodeId::Exit:
+            // Only running off the end of the bytecode is a match, an explicit Exit fails.
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    if (threads)
+        quick_sort(*threads);
+    return is_match;
+}
+
+bool LazyDFA::compare_matches(FlatByteCode const& bytecode, size_t instruction_position, u32 code_point) const
+{
+    // Run the compare against a single-character input, so it behaves exactly like it does in the VM.
+    char16_t code_units[2];
+    size_t length = 0;
+    if (m_unicode) {
+        length = AK::UnicodeUtils::code_point_to_utf16(code_point, [&, index = 0uz](char16_t code_unit) mutable { code_units[index++] = code_unit; });
+    } else {
+        code_units[0] = static_cast<char16_t>(code_point);
+        length = 1;
+    }
+
+    MatchInput input;
+    input.view = Utf16View { code_units, length };
+    input.view.set_unicode(m_unicode);
+    input.regex_options = m_options;
+
+    MatchState state { 0, m_options };
+    state.instruction_position = instruction_position;
+
+    auto& opcode = bytecode.get_opcode(state);
+    auto result = opcode.execute(input, state);
+    return result == ExecutionResult::Continue && state.string_position == 1;
+}
+
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibRegex/RegexByteCode.h>
+#include <LibRegex/RegexMatch.h>
+#include <LibRegex/RegexOptions.h>
+
+namespace regex {
+
+struct LazyDFAStateKey {
+    // Bytecode position in the upper 32 bits, offset into a multi-character string compare in the lower 32 bits.
+    Vector<u64> threads;
+    bool unanchored { false };
+    bool at_begin { false };
+
+    bool operator==(LazyDFAStateKey const&) const = default;
+};
+
+}
+
+template<>
+struct AK::Traits<regex::LazyDFAStateKey> : public AK::DefaultTraits<regex::LazyDFAStateKey> {
+    static unsigned hash(regex::LazyDFAStateKey const& key)
+    {
+        unsigned hash = pair_int_hash(key.unanchored, key.at_begin);
+        for (auto thread : key.threads)
+            hash = pair_int_hash(hash, u64_hash(thread));
+        return hash;
+    }
+};
+
+namespace regex {
+
+// A DFA that is built lazily from the flat bytecode of patterns that do not need any of the
+// backtracking-only features (backreferences, lookaround, counted repetition, modifiers, ...).
+//
+// Each DFA state is the set of bytecode positions the VM could be at after consuming the same input,
+// so scanning an input is linear in its length regardless of how the pattern would backtrack.
+// The DFA only answers whether a match exists; the VM is still used to produce the actual match
+// span and capture groups, but only from positions where a match is known to start.
+class REGEX_API LazyDFA {
+public:
+    enum class Result : u8 {
+        NoMatch,
+        Match,
+        GaveUp, // The state cache was thrashing, the caller should fall back to the VM.
+    };
+
+    static bool is_supported(FlatByteCode const&);
+
+    static NonnullOwnPtr<LazyDFA> create(FlatByteCode const&);
+
+    bool can_run_with(RegexStringView const&, AllOptions) const;
+
+    // Is there a match starting exactly at the given position?
+    Result find_match_starting_at(FlatByteCode const&, RegexStringView const&, AllOptions, size_t code_unit_index);
+
+    // Is there a match starting at or anywhere after the given position?
+    Result find_match_at_or_after(FlatByteCode const&, RegexStringView const&, AllOptions, size_t code_unit_index);
+
+    size_t cached_state_count() const { return m_states.size(); }
+    size_t cache_flush_count() const { return m_cache_flush_count; }
+
+private:
+    using Thread = u64;
+    using StateKey = LazyDFAStateKey;
+
+    static constexpr u32 unknown_transition = NumericLimits<u32>::max();
+    static constexpr size_t max_cached_states = 2048;
+    static constexpr size_t max_cache_flushes_per_search = 4;
+
+    struct State {
+        StateKey key;
+        bool is_match { false };
+        bool is_match_at_end { false };
+        bool is_dead { false };
+        Array<u32, 128> ascii_transitions;
+        HashMap<u32, u32> transitions;
+    };
+
+    struct StringCompare {
+        Vector<u32> code_units;
+        Vector<u32> code_points;
+    };
+
+    LazyDFA() = default;
+
+    void reset_for(RegexStringView const&, AllOptions);
+    void flush_cache();
+
+    u32 start_state(FlatByteCode const&, bool unanchored, bool at_begin);
+    u32 state_for(FlatByteCode const&, Vector<Thread>&& seeds, bool unanchored, bool at_begin);
+    Optional<u32> transition(FlatByteCode const&, u32 state_index, u32 code_point);
+    bool closure(FlatByteCode const&, Vector<Thread>& worklist, bool at_begin, bool at_end, Vector<Thread>* threads) const;
+    bool compare_matches(FlatByteCode const&, size_t instruction_position, u32 code_point) const;
+
+    Result run(FlatByteCode const&, RegexStringView const&, AllOptions, size_t code_unit_index, bool unanchored);
+
+    HashMap<size_t, StringCompare> m_string_compares;
+    bool m_has_anchors { false };
+
+    AllOptions m_options {};
+    bool m_unicode { false };
+    bool m_is_configured { false };
+
+    Vector<State> m_states;
+    HashMap<StateKey, u32> m_state_indices;
+    Array<Optional<u32>, 4> m_start_states;
+
+    size_t m_cache_flush_count { 0 };
+    size_t m_cache_flushes_in_current_search { 0 };
+};
+
+}
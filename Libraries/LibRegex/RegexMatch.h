@@ -51,6 +51,11 @@ public:
         return m_view.get<Utf16View>();
     }
 
+    StringView string_view() const
+    {
+        return m_view.get<StringView>();
+    }
+
     bool is_u16_view() const
     {
         return m_view.has<Utf16View>();
@@ -42,25 +42,90 @@ struct CacheKey {
     }
 };
 template<class Parser>
-static OrderedHashMap<CacheKey<Parser>, regex::Parser::Result> s_parser_cache;
+static OrderedHashMap<CacheKey<Parser>, NonnullRefPtr<SharedRegex<Parser>>> s_regex_cache;
 
 template<class Parser>
-static size_t s_cached_bytecode_size = 0;
+static RegexCacheStatistics s_regex_cache_statistics;
 
 static constexpr auto MaxRegexCachedBytecodeSize = 1 * MiB;
 
 template<class Parser>
-static void cache_parse_result(regex::Parser::Result const& result, CacheKey<Parser> const& key)
+static size_t cached_bytecode_size_of(SharedRegex<Parser> const& shared_regex)
 {
-    auto bytecode_size = result.bytecode.visit([](auto& bytecode) { return bytecode.size() * sizeof(ByteCodeValueType); });
+    return shared_regex.regex().parser_result.bytecode.visit([](auto& bytecode) { return bytecode.size() * sizeof(ByteCodeValueType); });
+}
+
+template<class Parser>
+static RefPtr<SharedRegex<Parser>> find_cached_regex(CacheKey<Parser> const& key)
+{
+    auto& statistics = s_regex_cache_statistics<Parser>;
+    auto cached = s_regex_cache<Parser>.take(key);
+    if (!cached.has_value()) {
+        ++statistics.misses;
+        return nullptr;
+    }
+
+    // Move the entry to the back, so the least recently used entries are evicted first.
+    ++statistics.hits;
+    s_regex_cache<Parser>.set(key, *cached);
+    return cached.release_value();
+}
+
+template<class Parser>
+static void cache_regex(NonnullRefPtr<SharedRegex<Parser>> const& shared_regex, CacheKey<Parser> const& key)
+{
+    auto& statistics = s_regex_cache_statistics<Parser>;
+    auto bytecode_size = cached_bytecode_size_of(*shared_regex);
     if (bytecode_size > MaxRegexCachedBytecodeSize)
         return;
 
-    while (bytecode_size + s_cached_bytecode_size<Parser> > MaxRegexCachedBytecodeSize)
-        s_cached_bytecode_size<Parser> -= s_parser_cache<Parser>.take_first().bytecode.visit([](auto& bytecode) { return bytecode.size() * sizeof(ByteCodeValueType); });
+    while (bytecode_size + statistics.bytecode_size > MaxRegexCachedBytecodeSize) {
+        statistics.bytecode_size -= cached_bytecode_size_of(*s_regex_cache<Parser>.take_first());
+        ++statistics.evictions;
+    }
 
-    s_parser_cache<Parser>.set(key, result);
-    s_cached_bytecode_size<Parser> += bytecode_size;
+    s_regex_cache<Parser>.set(key, shared_regex);
+    statistics.bytecode_size += bytecode_size;
+    statistics.entry_count = s_regex_cache<Parser>.size();
+}
+
+template<class Parser>
+NonnullRefPtr<SharedRegex<Parser>> SharedRegex<Parser>::compile(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
+{
+    CacheKey<Parser> key { pattern, regex_options };
+    if (auto cached = find_cached_regex(key))
+        return cached.release_nonnull();
+
+    auto shared_regex = adopt_ref(*new SharedRegex(Regex<Parser>({}, move(pattern), regex_options)));
+    if (shared_regex->regex().parser_result.error == regex::Error::NoError)
+        cache_regex(shared_regex, key);
+    return shared_regex;
+}
+
+template<class Parser>
+NonnullRefPtr<SharedRegex<Parser>> SharedRegex<Parser>::compile(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
+{
+    CacheKey<Parser> key { pattern, regex_options };
+    if (auto cached = find_cached_regex(key))
+        return cached.release_nonnull();
+
+    auto shared_regex = adopt_ref(*new SharedRegex(Regex<Parser>(move(parse_result), move(pattern), regex_options)));
+    if (shared_regex->regex().parser_result.error == regex::Error::NoError)
+        cache_regex(shared_regex, key);
+    return shared_regex;
+}
+
+template<class Parser>
+RegexCacheStatistics SharedRegex<Parser>::cache_statistics()
+{
+    return s_regex_cache_statistics<Parser>;
+}
+
+template<class Parser>
+void SharedRegex<Parser>::clear_cache()
+{
+    s_regex_cache<Parser>.clear();
+    s_regex_cache_statistics<Parser> = {};
 }
 
 template<class Parser>
@@ -68,20 +133,26 @@ Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsT
     : pattern_value(move(pattern))
     , parser_result(ByteCode {})
 {
-    if (auto cache_entry = s_parser_cache<Parser>.get({ pattern_value, regex_options }); cache_entry.has_value()) {
-        parser_result = cache_entry.value();
-    } else {
-        regex::Lexer lexer(pattern_value);
+    // Compiled programs are shared through the cache, this instance gets its own copy so it can be freely modified.
+    auto shared_regex = SharedRegex<Parser>::compile(pattern_value, regex_options);
+    parser_result = shared_regex->regex().parser_result;
+
+    if (parser_result.error == regex::Error::NoError)
+        matcher = make<Matcher<Parser>>(this, static_cast<decltype(regex_options.value())>(parser_result.options.value()));
+}
 
-        Parser parser(lexer, regex_options);
-        parser_result = parser.parse();
-        parser_result.bytecode.template get<ByteCode>().flatten();
+template<class Parser>
+Regex<Parser>::Regex(Badge<SharedRegex<Parser>>, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
+    : pattern_value(move(pattern))
+    , parser_result(ByteCode {})
+{
+    regex::Lexer lexer(pattern_value);
 
-        run_optimization_passes();
+    Parser parser(lexer, regex_options);
+    parser_result = parser.parse();
+    parser_result.bytecode.template get<ByteCode>().flatten();
 
-        if (parser_result.error == regex::Error::NoError)
-            cache_parse_result<Parser>(parser_result, { pattern_value, regex_options });
-    }
+    run_optimization_passes();
 
     if (parser_result.error == regex::Error::NoError)
         matcher = make<Matcher<Parser>>(this, static_cast<decltype(regex_options.value())>(parser_result.options.value()));
@@ -152,6 +223,17 @@ ByteString Regex<Parser>::error_string(Optional<ByteString> message) const
     return eb.to_byte_string();
 }
 
+template<typename Parser>
+LazyDFA* Matcher<Parser>::lazy_dfa_for(AllOptions options) const
+{
+    if (!m_pattern->parser_result.optimization_data.can_use_lazy_dfa || options.has_flag_set(AllFlags::Internal_NoLazyDFA))
+        return nullptr;
+
+    if (!m_lazy_dfa)
+        m_lazy_dfa = LazyDFA::create(m_pattern->parser_result.bytecode.template get<FlatByteCode>());
+    return m_lazy_dfa.ptr();
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -225,6 +307,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    auto* lazy_dfa = lazy_dfa_for(input.regex_options);
+    auto const& literal_prefilter = m_pattern->parser_result.optimization_data.literal_prefilter;
+    auto const& bytecode = m_pattern->parser_result.bytecode.template get<FlatByteCode>();
+
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
         auto lower_case_needle = needle;
@@ -265,6 +351,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         }
         bool succeeded = false;
 
+        // The lazy DFA tells us cheaply whether running the VM from a given position can succeed at all.
+        auto use_lazy_dfa = lazy_dfa && lazy_dfa->can_run_with(view, input.regex_options);
+        auto match_exists_ahead = false;
+
+        // Every match starts with one of the prefilter's literals, so we can jump straight to the next occurrence of one.
+        auto use_literal_prefilter = literal_prefilter.has_value() && continue_search && !only_start_of_line && literal_prefilter->can_search(view, input.regex_options);
+
         if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
@@ -302,6 +395,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                     break;
             }
 
+            if (use_literal_prefilter) {
+                auto candidate = literal_prefilter->find_candidate(input.view, view_index);
+                if (!candidate.has_value())
+                    break;
+                if (*candidate != view_index) {
+                    view_index = *candidate;
+                    input.in_the_middle_of_a_line = true;
+                }
+            }
+
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
             //        the vm. Add new OpCode for MinMatchLengthFromSp with the value of
@@ -324,6 +427,30 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                     goto done_matching;
             }
 
+            if (use_lazy_dfa) {
+                auto code_unit_index = view_index;
+                if (input.view.unicode())
+                    code_unit_index = view_index < view_length ? input.view.code_unit_offset_of(view_index) : input.view.length_in_code_units();
+
+                if (continue_search && !only_start_of_line && !match_exists_ahead) {
+                    auto result = lazy_dfa->find_match_at_or_after(bytecode, input.view, input.regex_options, code_unit_index);
+                    if (result == LazyDFA::Result::NoMatch)
+                        break;
+                    if (result == LazyDFA::Result::GaveUp)
+                        use_lazy_dfa = false;
+                    else
+                        match_exists_ahead = true;
+                }
+
+                if (use_lazy_dfa) {
+                    auto result = lazy_dfa->find_match_starting_at(bytecode, input.view, input.regex_options, code_unit_index);
+                    if (result == LazyDFA::Result::NoMatch)
+                        goto done_matching;
+                    if (result == LazyDFA::Result::GaveUp)
+                        use_lazy_dfa = false;
+                }
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -359,6 +486,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                 dbgln_if(REGEX_DEBUG, "[match] Found a match (length={}): '{}'", state.string_position - view_index, input.view.substring_view(view_index, state.string_position - view_index));
 
                 ++match_count;
+                match_exists_ahead = false;
 
                 if (continue_search) {
                     append_match(input, state, view_index);
@@ -705,12 +833,15 @@ Matcher<Parser>::ExecuteResult Matcher<Parser>::execute(MatchInput const& input,
 
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
+template class SharedRegex<PosixBasicParser>;
 
 template class Matcher<PosixExtendedParser>;
 template class Regex<PosixExtendedParser>;
+template class SharedRegex<PosixExtendedParser>;
 
 template class Matcher<ECMA262Parser>;
 template class Regex<ECMA262Parser>;
+template class SharedRegex<ECMA262Parser>;
 
 }
 
@@ -7,12 +7,16 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
 
+#include <AK/Badge.h>
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <ctype.h>
 
@@ -78,8 +82,22 @@ private:
     };
     ExecuteResult execute(MatchInput const& input, MatchState& state, size_t& operations) const;
 
+    LazyDFA* lazy_dfa_for(AllOptions) const;
+
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
+};
+
+template<class Parser>
+class REGEX_API SharedRegex;
+
+struct RegexCacheStatistics {
+    size_t hits { 0 };
+    size_t misses { 0 };
+    size_t evictions { 0 };
+    size_t entry_count { 0 };
+    size_t bytecode_size { 0 };
 };
 
 template<class Parser>
@@ -94,6 +112,7 @@ public:
 
     explicit Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
+    Regex(Badge<SharedRegex<Parser>>, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options);
     Regex(Regex const&);
     ~Regex() = default;
     Regex(Regex&&);
@@ -243,6 +262,28 @@ private:
     void fill_optimization_data(BasicBlockList const&);
 };
 
+// A compiled regex that is shared between all users asking for the same pattern and options while it stays in the
+// process-wide compiled regex cache, e.g. every RegExp object created for the same source. It must not be modified.
+template<class Parser>
+class REGEX_API SharedRegex final : public RefCounted<SharedRegex<Parser>> {
+public:
+    static NonnullRefPtr<SharedRegex> compile(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
+    static NonnullRefPtr<SharedRegex> compile(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
+
+    static RegexCacheStatistics cache_statistics();
+    static void clear_cache();
+
+    Regex<Parser> const& regex() const { return m_regex; }
+
+private:
+    explicit SharedRegex(Regex<Parser>&& regex)
+        : m_regex(move(regex))
+    {
+    }
+
+    Regex<Parser> m_regex;
+};
+
 // free standing functions for match, search and has_match
 template<class Parser>
 RegexResult match(RegexStringView view, Regex<Parser>& pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {})
@@ -310,3 +351,4 @@ using regex::has_match;
 using regex::match;
 using regex::Regex;
 using regex::RegexResult;
+using regex::SharedRegex;
@@ -17,6 +17,7 @@
 #include <AK/Vector.h>
 #include <LibRegex/Regex.h>
 #include <LibRegex/RegexBytecodeStreamOptimizer.h>
+#include <LibRegex/RegexDFA.h>
 #include <LibUnicode/CharacterTypes.h>
 #if REGEX_DEBUG
 #    include <AK/ScopeGuard.h>
@@ -362,6 +363,9 @@ void Regex<Parser>::run_optimization_passes()
 {
     ScopeGuard switch_to_flat = [&] {
         parser_result.bytecode = FlatByteCode::from(move(parser_result.bytecode.template get<ByteCode>()));
+        auto const& flat_bytecode = parser_result.bytecode.template get<FlatByteCode>();
+        parser_result.optimization_data.can_use_lazy_dfa = LazyDFA::is_supported(flat_bytecode);
+        parser_result.optimization_data.literal_prefilter = LiteralPrefilter::create_from(flat_bytecode);
     };
     rewrite_with_useless_jumps_removed();
 
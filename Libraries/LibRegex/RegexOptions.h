@@ -34,6 +34,7 @@ enum class AllFlags {
     Internal_BrowserExtended = __Regex_Internal_BrowserExtended,         // Only for ECMA262, Enable the behaviors defined in section B.1.4. of the ECMA262 spec.
     Internal_ConsiderNewline = __Regex_Internal_ConsiderNewline,         // Only for ECMA262, Allow multiline matches to consider newlines as line boundaries.
     Internal_ECMA262DotSemantics = __Regex_Internal_ECMA262DotSemantics, // Use ECMA262 dot semantics: disallow matching CR/LF/LS/PS instead of just CR.
+    Internal_NoLazyDFA = __Regex_Internal_NoLazyDFA,                     // Always run the backtracking VM, even if the pattern could use the lazy DFA.
     Last = Internal_BrowserExtended,
 };
 
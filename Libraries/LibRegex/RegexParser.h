@@ -10,6 +10,7 @@
 #include "RegexError.h"
 #include "RegexLexer.h"
 #include "RegexOptions.h"
+#include "RegexPrefilter.h"
 
 #include <AK/FlyString.h>
 #include <AK/Forward.h>
@@ -68,6 +69,11 @@ public:
             Vector<CharRange> starting_ranges;
             Vector<CharRange> starting_ranges_insensitive;
             bool only_start_of_line = false;
+            // If set, the pattern has no backreferences, lookaround or other backtracking-only features, and can be
+            // pre-screened with a LazyDFA.
+            bool can_use_lazy_dfa = false;
+            // If populated, every match starts with one of a few literals that can be searched for directly.
+            Optional<LiteralPrefilter> literal_prefilter;
         } optimization_data {};
     };
 
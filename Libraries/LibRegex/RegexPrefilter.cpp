@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/UnicodeUtils.h>
+#include <LibRegex/RegexPrefilter.h>
+
+namespace regex {
+
+// Returns the literal a compare matches, if it matches exactly one fixed sequence of characters.
+static Optional<Vector<u16>> literal_of(FlatByteCode const& bytecode, OpCode<FlatByteCode>& opcode)
+{
+    auto compares = opcode.opcode_id() == OpCodeId::Compare
+        ? to<OpCode_Compare>(opcode).flat_compares()
+        : to<OpCode_CompareSimple>(opcode).flat_compares();
+    if (compares.size() != 1)
+        return {};
+
+    Vector<u16> literal;
+    auto const& compare = compares.first();
+    switch (compare.type) {
+    case CharacterCompareType::Char:
+        AK::UnicodeUtils::code_point_to_utf16(compare.value, [&](char16_t code_unit) { literal.append(code_unit); });
+        break;
+    case CharacterCompareType::String: {
+        auto string = bytecode.get_u16_string(compare.value);
+        auto view = string.view();
+        for (size_t i = 0; i < view.length_in_code_units(); ++i)
+            literal.append(view.code_unit_at(i));
+        break;
+    }
+    default:
+        return {};
+    }
+
+    if (literal.is_empty())
+        return {};
+    return literal;
+}
+
+Optional<LiteralPrefilter> LiteralPrefilter::create_from(FlatByteCode const& bytecode)
+{
+    // Walk every path from the start of the pattern through instructions that do not consume input. Each path must
+    // end in a literal compare, otherwise the pattern can start matching with something we can't search for.
+    Vector<Vector<u16>> literals;
+    HashTable<size_t> visited;
+    Vector<size_t> worklist { 0 };
+    auto state = MatchState::only_for_enumeration();
+
+    while (!worklist.is_empty()) {
+        auto instruction_position = worklist.take_last();
+        if (visited.set(instruction_position) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        // Running off the end of the bytecode means the pattern can match the empty string.
+        if (instruction_position >= bytecode.size())
+            return {};
+
+        state.instruction_position = instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next = instruction_position + opcode.size();
+        auto jump_target = [&] { return next + static_cast<ssize_t>(opcode.argument(0)); };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+        case OpCodeId::CompareSimple: {
+            auto literal = literal_of(bytecode, opcode);
+            if (!literal.has_value())
+                return {};
+
+            // Extend the literal with any literal compares that directly follow it.
+            for (state.instruction_position = next; state.instruction_position < bytecode.size() && literal->size() < max_literal_length;) {
+                auto& next_opcode = bytecode.get_opcode(state);
+                auto id = next_opcode.opcode_id();
+                if (id == OpCodeId::SaveLeftCaptureGroup || id == OpCodeId::SaveRightCaptureGroup || id == OpCodeId::SaveRightNamedCaptureGroup) {
+                    state.instruction_position += next_opcode.size();
+                    continue;
+                }
+                if (id != OpCodeId::Compare && id != OpCodeId::CompareSimple)
+                    break;
+                auto continuation = literal_of(bytecode, next_opcode);
+                if (!continuation.has_value())
+                    break;
+                literal->extend(continuation.release_value());
+                state.instruction_position += next_opcode.size();
+            }
+            if (literal->size() > max_literal_length)
+                literal->shrink(max_literal_length);
+
+            if (!literals.contains_slow(*literal))
+                literals.append(literal.release_value());
+            if (literals.size() > max_literal_count)
+                return {};
+            break;
+        }
+        case OpCodeId::Jump:
+            worklist.append(jump_target());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::JumpNonEmpty:
+            worklist.append(next);
+            worklist.append(jump_target());
+            break;
+        case OpCodeId::Checkpoint:
+        case OpCodeId::FailIfEmpty:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            worklist.append(next);
+            break;
+        case OpCodeId::Exit:
+            // An explicit Exit fails, so this path never matches.
+            break;
+        default:
+            return {};
+        }
+    }
+
+    if (literals.is_empty())
+        return {};
+    return LiteralPrefilter { move(literals) };
+}
+
+LiteralPrefilter::LiteralPrefilter(Vector<Vector<u16>> literals)
+    : m_literals(move(literals))
+{
+    for (auto const& literal : m_literals) {
+        if (!m_first_code_units.contains_slow(literal.first()))
+            m_first_code_units.append(literal.first());
+        for (auto code_unit : literal) {
+            if (!is_ascii(code_unit))
+                m_is_ascii = false;
+        }
+    }
+}
+
+bool LiteralPrefilter::can_search(RegexStringView const& view, AllOptions options) const
+{
+    // FIXME: Case-insensitive compares may match non-ASCII case variants of a literal (e.g. KELVIN SIGN for 'k'),
+    //        which a plain search can't find.
+    if (options.has_flag_set(AllFlags::Insensitive))
+        return false;
+
+    if (!view.is_u16_view()) {
+        // Non-ASCII literals would have to be matched against the byte-wise view of the input; just leave that to the VM.
+        // In Unicode mode, positions are code points, which are expensive to map to byte offsets and back.
+        return m_is_ascii && !view.unicode();
+    }
+
+    // In Unicode mode, positions are code points; only search inputs where those coincide with code units.
+    if (view.unicode())
+        return view.length() == view.length_in_code_units();
+    return true;
+}
+
+template<typename CodeUnit>
+Optional<size_t> LiteralPrefilter::find_candidate_in(ReadonlySpan<CodeUnit> haystack, size_t start) const
+{
+    using VectorType = Conditional<sizeof(CodeUnit) == 1, AK::SIMD::u8x16, AK::SIMD::u16x8>;
+    using Lane = AK::SIMD::ElementOf<VectorType>;
+    static constexpr size_t lane_count = AK::SIMD::vector_length<VectorType>;
+
+    Array<VectorType, max_literal_count> first_code_units;
+    for (size_t i = 0; i < m_first_code_units.size(); ++i) {
+        for (size_t lane = 0; lane < lane_count; ++lane)
+            first_code_units[i][lane] = static_cast<Lane>(m_first_code_units[i]);
+    }
+
+    auto matches_literal_at = [&](size_t position) {
+        for (auto const& literal : m_literals) {
+            if (position + literal.size() > haystack.size())
+                continue;
+            bool matches = true;
+            for (size_t i = 0; i < literal.size() && matches; ++i)
+                matches = static_cast<u16>(haystack[position + i]) == literal[i];
+            if (matches)
+                return true;
+        }
+        return false;
+    };
+
+    auto position = start;
+    while (position < haystack.size()) {
+        // Compare a whole vector of code units against every first code unit at once, and only look at the
+        // individual positions once one of them hit.
+        if (position + lane_count <= haystack.size()) {
+            auto chunk = AK::SIMD::load_unaligned<VectorType>(haystack.data() + position);
+            VectorType hits {};
+            for (size_t i = 0; i < m_first_code_units.size(); ++i)
+                hits |= bit_cast<VectorType>(chunk == first_code_units[i]);
+
+            auto words = bit_cast<AK::SIMD::u64x2>(hits);
+            if ((words[0] | words[1]) == 0) {
+                position += lane_count;
+                continue;
+            }
+
+            for (size_t lane = 0; lane < lane_count; ++lane) {
+                if (hits[lane] != 0 && matches_literal_at(position + lane))
+                    return position + lane;
+            }
+            position += lane_count;
+            continue;
+        }
+
+        if (m_first_code_units.contains_slow(static_cast<u16>(haystack[position])) && matches_literal_at(position))
+            return position;
+        ++position;
+    }
+
+    return {};
+}
+
+Optional<size_t> LiteralPrefilter::find_candidate(RegexStringView const& view, size_t index) const
+{
+    // NOTE: can_search() only allows views where the index is a code unit offset.
+    if (!view.is_u16_view())
+        return find_candidate_in(view.string_view().bytes(), index);
+
+    auto const& u16_view = view.u16_view();
+    if (u16_view.has_ascii_storage())
+        return find_candidate_in(u16_view.bytes(), index);
+    return find_candidate_in(u16_view.utf16_span(), index);
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibRegex/RegexByteCode.h>
+#include <LibRegex/RegexMatch.h>
+#include <LibRegex/RegexOptions.h>
+
+namespace regex {
+
+// A small set of literals that every match must start with, e.g. "foo" for /foo\d+/ or {"cat", "dog"} for /(cat|dog)s?/.
+// The matcher uses it to skip straight to the next position at which one of the literals occurs, instead of starting
+// the VM at every position in between.
+class REGEX_API LiteralPrefilter {
+public:
+    static constexpr size_t max_literal_count = 8;
+    static constexpr size_t max_literal_length = 32;
+
+    static Optional<LiteralPrefilter> create_from(FlatByteCode const&);
+
+    bool can_search(RegexStringView const&, AllOptions) const;
+
+    // Returns the first position at or after the given one (in the view's own units) at which one of the literals
+    // occurs, or nothing if there is no such position. Only valid if can_search() returned true for the view.
+    Optional<size_t> find_candidate(RegexStringView const&, size_t index) const;
+
+    Vector<Vector<u16>> const& literals() const { return m_literals; }
+
+private:
+    explicit LiteralPrefilter(Vector<Vector<u16>> literals);
+
+    template<typename CodeUnit>
+    Optional<size_t> find_candidate_in(ReadonlySpan<CodeUnit> haystack, size_t start) const;
+
+    // UTF-16 code units of each literal.
+    Vector<Vector<u16>> m_literals;
+    // The distinct first code units of all literals.
+    Vector<u16> m_first_code_units;
+    bool m_is_ascii { true };
+};
+
+}
@@ -756,6 +756,48 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation_f
     return invalidation;
 }
 
+// Animations that only change these properties (e.g. spinners and fades) never affect layout, and none of these
+// properties are inherited unless a descendant asks for it explicitly (e.g. `opacity: inherit`), so usually only the
+// target's own layout node and paintable have to be updated for every frame.
+// FIXME: Hand these animations over to the rendering thread, so they keep running while the main thread is busy.
+//        That needs the rendering thread to produce frames on its own, rather than only when the main thread
+//        enqueues a display list, and the display list to refer to transforms and opacities that can be swapped out
+//        without recording it again.
+static constexpr Array transform_and_opacity_properties {
+    CSS::PropertyID::Opacity,
+    CSS::PropertyID::Transform,
+    CSS::PropertyID::Rotate,
+    CSS::PropertyID::Scale,
+    CSS::PropertyID::Translate,
+    CSS::PropertyID::TransformOrigin,
+};
+
+static bool is_transform_or_opacity_property(CSS::PropertyID property_id)
+{
+    return transform_and_opacity_properties.contains_slow(property_id);
+}
+
+static bool inherits_any_transform_or_opacity_property(DOM::Element const& element)
+{
+    auto computed_properties = element.computed_properties();
+    if (!computed_properties)
+        return false;
+    for (auto property_id : transform_and_opacity_properties) {
+        if (computed_properties->is_property_inherited(property_id))
+            return true;
+    }
+    return false;
+}
+
+static bool only_transform_or_opacity_properties_are_animated(HashMap<CSS::PropertyID, NonnullRefPtr<CSS::StyleValue const>> const& properties)
+{
+    for (auto const& [property_id, _] : properties) {
+        if (!is_transform_or_opacity_property(property_id))
+            return false;
+    }
+    return true;
+}
+
 AnimationUpdateContext::~AnimationUpdateContext()
 {
     for (auto& it : elements) {
@@ -769,8 +811,15 @@ AnimationUpdateContext::~AnimationUpdateContext()
         if (invalidation.is_none())
             continue;
 
+        bool only_transform_or_opacity_animated = only_transform_or_opacity_properties_are_animated(it.value->animated_properties_before_update)
+            && only_transform_or_opacity_properties_are_animated(style->animated_property_values());
+
         // Traversal of the subtree is necessary to update the animated properties inherited from the target element.
         target->for_each_in_subtree_of_type<DOM::Element>([&](auto& element) {
+            // OPTIMIZATION: Transform and opacity properties only reach the descendants that explicitly inherit them,
+            //               and through those, only their own descendants that do the same.
+            if (only_transform_or_opacity_animated && !inherits_any_transform_or_opacity_property(element))
+                return TraversalDecision::SkipChildrenAndContinue;
             auto element_invalidation = element.recompute_inherited_style();
             if (element_invalidation.is_none())
                 return TraversalDecision::SkipChildrenAndContinue;
@@ -778,12 +827,18 @@ AnimationUpdateContext::~AnimationUpdateContext()
             return TraversalDecision::Continue;
         });
 
+        auto apply_style = [&](Layout::NodeWithStyle& layout_node) {
+            if (only_transform_or_opacity_animated)
+                layout_node.apply_transform_and_opacity_style(*style);
+            else
+                layout_node.apply_style(*style);
+        };
         if (!element.pseudo_element().has_value()) {
             if (target->layout_node())
-                target->layout_node()->apply_style(*style);
+                apply_style(*target->layout_node());
         } else {
             if (auto pseudo_element_node = target->get_pseudo_element_node(element.pseudo_element().value()))
-                pseudo_element_node->apply_style(*style);
+                apply_style(*pseudo_element_node);
         }
 
         if (invalidation.relayout && target->layout_node())
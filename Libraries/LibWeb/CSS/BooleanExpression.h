@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
@@ -87,6 +88,8 @@ public:
     virtual MatchResult evaluate(DOM::Document const*) const = 0;
     virtual String to_string() const = 0;
     virtual void dump(StringBuilder&, int indent_levels = 0) const = 0;
+
+    virtual void for_each_child(Function<void(BooleanExpression const&)> const&) const { }
 };
 
 // https://www.w3.org/TR/mediaqueries-4/#typedef-general-enclosed
@@ -124,6 +127,7 @@ public:
     virtual MatchResult evaluate(DOM::Document const*) const override;
     virtual String to_string() const override;
     virtual void dump(StringBuilder&, int indent_levels = 0) const override;
+    virtual void for_each_child(Function<void(BooleanExpression const&)> const& callback) const override { callback(*m_child); }
 
 private:
     BooleanNotExpression(NonnullOwnPtr<BooleanExpression>&& child)
@@ -145,6 +149,7 @@ public:
     virtual MatchResult evaluate(DOM::Document const*) const override;
     virtual String to_string() const override;
     virtual void dump(StringBuilder&, int indent_levels = 0) const override;
+    virtual void for_each_child(Function<void(BooleanExpression const&)> const& callback) const override { callback(*m_child); }
 
 private:
     BooleanExpressionInParens(NonnullOwnPtr<BooleanExpression>&& child)
@@ -166,6 +171,11 @@ public:
     virtual MatchResult evaluate(DOM::Document const*) const override;
     virtual String to_string() const override;
     virtual void dump(StringBuilder&, int indent_levels = 0) const override;
+    virtual void for_each_child(Function<void(BooleanExpression const&)> const& callback) const override
+    {
+        for (auto const& child : m_children)
+            callback(*child);
+    }
 
 private:
     BooleanAndExpression(Vector<NonnullOwnPtr<BooleanExpression>>&& children)
@@ -187,6 +197,11 @@ public:
     virtual MatchResult evaluate(DOM::Document const*) const override;
     virtual String to_string() const override;
     virtual void dump(StringBuilder&, int indent_levels = 0) const override;
+    virtual void for_each_child(Function<void(BooleanExpression const&)> const& callback) const override
+    {
+        for (auto const& child : m_children)
+            callback(*child);
+    }
 
 private:
     BooleanOrExpression(Vector<NonnullOwnPtr<BooleanExpression>>&& children)
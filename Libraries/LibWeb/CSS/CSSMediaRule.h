@@ -30,7 +30,7 @@ public:
 
     MediaList* media() const { return m_media; }
 
-    bool evaluate(DOM::Document const& document) { return m_media->evaluate(document); }
+    bool evaluate(DOM::Document const& document, MediaFeatureDependencies changed_features = MediaFeatureDependencies::All) { return m_media->evaluate(document, changed_features); }
 
 private:
     CSSMediaRule(JS::Realm&, MediaList&, CSSRuleList&);
@@ -62,7 +62,9 @@ public:
 
     void for_each_effective_rule(TraversalOrder, Function<void(CSSRule const&)> const& callback) const;
     // Returns whether the match state of any media queries changed after evaluation.
-    bool evaluate_media_queries(DOM::Document const&);
+    // Only evaluates the media queries that are affected by the changed media features, and adds the media features
+    // that any of the visited media queries depend on to `dependencies`.
+    bool evaluate_media_queries(DOM::Document const&, MediaFeatureDependencies changed_features, MediaFeatureDependencies& dependencies);
 
     void set_owner_rule(GC::Ref<CSSRule> owner_rule) { m_owner_rule = owner_rule; }
     void set_rules(Badge<CSSStyleSheet>, Vector<GC::Ref<CSSRule>> rules) { m_rules = move(rules); }
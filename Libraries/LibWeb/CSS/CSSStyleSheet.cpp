@@ -10,12 +10,15 @@
 #include <LibWeb/Bindings/CSSStyleSheetPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/CSS/CSSImportRule.h>
+#include <LibWeb/CSS/CSSStyleRule.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/FontComputer.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/DOM/StyleInvalidator.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
@@ -159,7 +162,10 @@ WebIDL::ExceptionOr<unsigned> CSSStyleSheet::insert_rule(StringView rule, unsign
         // NOTE: The spec doesn't say where to set the parent style sheet, so we'll do it here.
         parsed_rule->set_parent_style_sheet(this);
 
-        invalidate_owners(DOM::StyleInvalidationReason::StyleSheetInsertRule);
+        if (auto* style_rule = as_if<CSSStyleRule>(*parsed_rule))
+            invalidate_owners_for_style_rule(*style_rule, StyleRuleChange::Inserted, DOM::StyleInvalidationReason::StyleSheetInsertRule);
+        else
+            invalidate_owners(DOM::StyleInvalidationReason::StyleSheetInsertRule);
     }
 
     return result;
@@ -174,10 +180,15 @@ WebIDL::ExceptionOr<void> CSSStyleSheet::delete_rule(unsigned index)
     if (disallow_modification())
         return WebIDL::NotAllowedError::create(realm(), "Can't call delete_rule() on non-modifiable stylesheets."_utf16);
 
+    GC::Ptr<CSSRule> old_rule = m_rules->item(index);
+
     // 3. Remove a CSS rule in the CSS rules at index.
     auto result = m_rules->remove_a_css_rule(index);
     if (!result.is_exception()) {
-        invalidate_owners(DOM::StyleInvalidationReason::StyleSheetDeleteRule);
+        if (auto* style_rule = as_if<CSSStyleRule>(old_rule.ptr()))
+            invalidate_owners_for_style_rule(*style_rule, StyleRuleChange::Removed, DOM::StyleInvalidationReason::StyleSheetDeleteRule);
+        else
+            invalidate_owners(DOM::StyleInvalidationReason::StyleSheetDeleteRule);
     }
     return result;
 }
@@ -359,6 +370,102 @@ void CSSStyleSheet::invalidate_owners(DOM::StyleInvalidationReason reason)
     }
 }
 
+// Returns an invalidation set that includes every element that one of the rule's selectors could match, or nothing if
+// that can't be narrowed down from all elements.
+static Optional<InvalidationSet> invalidation_set_for_subjects_of_style_rule(CSSStyleRule const& rule)
+{
+    InvalidationSet invalidation_set;
+    for (auto const& selector : rule.absolutized_selectors()) {
+        // ::part() and ::slotted() rules match elements in other trees than the one the style sheet belongs to (part
+        // elements in shadow trees, and slotted light DOM elements), which the invalidator doesn't walk into. Rules
+        // with :host match the shadow host rather than an element with the last compound selector's simple selectors.
+        if (selector->has_part_pseudo_element() || selector->is_slotted() || selector->contains_pseudo_class(PseudoClass::Host))
+            return {};
+
+        // Any element the selector matches has all of the simple selectors in its last compound selector, so we can
+        // pick whichever of those narrows the elements down the most.
+        Selector::SimpleSelector const* id = nullptr;
+        Selector::SimpleSelector const* class_name = nullptr;
+        Selector::SimpleSelector const* attribute = nullptr;
+        Selector::SimpleSelector const* tag_name = nullptr;
+        for (auto const& simple_selector : selector->compound_selectors().last().simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Id:
+                id = &simple_selector;
+                break;
+            case Selector::SimpleSelector::Type::Class:
+                class_name = &simple_selector;
+                break;
+            case Selector::SimpleSelector::Type::Attribute: {
+                // NOTE: The invalidator compares names as-is, so mixed-case names (e.g. SVG's viewBox) can't be used.
+                auto const& name = simple_selector.attribute().qualified_name.name;
+                if (name.name == name.lowercase_name)
+                    attribute = &simple_selector;
+                break;
+            }
+            case Selector::SimpleSelector::Type::TagName: {
+                auto const& name = simple_selector.qualified_name().name;
+                if (name.name == name.lowercase_name)
+                    tag_name = &simple_selector;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        if (id)
+            invalidation_set.set_needs_invalidate_id(id->name());
+        else if (class_name)
+            invalidation_set.set_needs_invalidate_class(class_name->name());
+        else if (attribute)
+            invalidation_set.set_needs_invalidate_attribute(attribute->attribute().qualified_name.name.lowercase_name);
+        else if (tag_name)
+            invalidation_set.set_needs_invalidate_tag_name(tag_name->qualified_name().name.lowercase_name);
+        else
+            return {};
+    }
+    return invalidation_set;
+}
+
+// Like invalidate_owners(), but for a single style rule that was inserted or removed. Instead of rebuilding the rule
+// caches and restyling everything, the rule is added to or removed from the caches, and only elements it could match
+// are restyled.
+void CSSStyleSheet::invalidate_owners_for_style_rule(CSSStyleRule const& rule, StyleRuleChange change, DOM::StyleInvalidationReason reason)
+{
+    auto invalidation_set = invalidation_set_for_subjects_of_style_rule(rule);
+
+    for (auto& document_or_shadow_root : m_owning_documents_or_shadow_roots) {
+        auto* shadow_root = as_if<DOM::ShadowRoot>(*document_or_shadow_root);
+        auto& style_scope = shadow_root ? shadow_root->style_scope() : document_or_shadow_root->document().style_scope();
+
+        // Rules from a shadow root's style sheets can also match its host, through :host, and the host's light DOM
+        // children, through ::slotted(). Invalidating the host covers those along with the shadow tree.
+        GC::Ref<DOM::Node> invalidation_root = *document_or_shadow_root;
+        if (shadow_root && shadow_root->host())
+            invalidation_root = *shadow_root->host();
+
+        bool did_update_rule_cache = change == StyleRuleChange::Inserted
+            ? style_scope.add_style_rule_to_rule_cache(*this, rule)
+            : style_scope.remove_style_rule_from_rule_cache(rule);
+        if (!did_update_rule_cache) {
+            m_did_match = {};
+            invalidation_root->invalidate_style(reason);
+            style_scope.invalidate_rule_cache();
+            continue;
+        }
+
+        // Class and id selectors are matched case-insensitively in quirks mode, which the invalidator doesn't do.
+        if (!invalidation_set.has_value() || document_or_shadow_root->document().in_quirks_mode()) {
+            invalidation_root->invalidate_style(reason);
+            continue;
+        }
+
+        auto invalidation_set_for_owner = *invalidation_set;
+        document_or_shadow_root->document().style_invalidator().add_pending_invalidation(invalidation_root, move(invalidation_set_for_owner));
+    }
+}
+
 GC::Ptr<DOM::Document> CSSStyleSheet::owning_document() const
 {
     if (!m_owning_documents_or_shadow_roots.is_empty())
@@ -371,13 +478,23 @@ GC::Ptr<DOM::Document> CSSStyleSheet::owning_document() const
 }
 
 bool CSSStyleSheet::evaluate_media_queries(DOM::Document const& document)
+{
+    auto dependencies = MediaFeatureDependencies::None;
+    return evaluate_media_queries(document, MediaFeatureDependencies::All, dependencies);
+}
+
+bool CSSStyleSheet::evaluate_media_queries(DOM::Document const& document, MediaFeatureDependencies changed_features, MediaFeatureDependencies& dependencies)
 {
     bool any_media_queries_changed_match_state = false;
 
-    bool now_matches = m_media->evaluate(document);
+    bool now_matches = m_media->evaluate(document, changed_features);
+    dependencies |= m_media->dependencies();
     if (!m_did_match.has_value() || m_did_match.value() != now_matches)
         any_media_queries_changed_match_state = true;
-    if (now_matches && m_rules->evaluate_media_queries(document))
+
+    // NOTE: The media queries of our rules weren't kept up to date while we didn't match, so evaluate all of them then.
+    auto changed_features_for_rules = m_did_match == true ? changed_features : MediaFeatureDependencies::All;
+    if (now_matches && m_rules->evaluate_media_queries(document, changed_features_for_rules, dependencies))
         any_media_queries_changed_match_state = true;
 
     m_did_match = now_matches;
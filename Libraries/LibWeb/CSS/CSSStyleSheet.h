@@ -63,6 +63,9 @@ public:
     void for_each_effective_style_producing_rule(Function<void(CSSRule const&)> const& callback) const;
     // Returns whether the match state of any media queries changed after evaluation.
     bool evaluate_media_queries(DOM::Document const&);
+    // Like the above, but only evaluates the media queries that are affected by the changed media features, and adds
+    // the media features that any of the visited media queries depend on to `dependencies`.
+    bool evaluate_media_queries(DOM::Document const&, MediaFeatureDependencies changed_features, MediaFeatureDependencies& dependencies);
     void for_each_effective_keyframes_at_rule(Function<void(CSSKeyframesRule const&)> const& callback) const;
 
     HashTable<GC::Ptr<DOM::Node>> owning_documents_or_shadow_roots() const { return m_owning_documents_or_shadow_roots; }
@@ -106,6 +109,12 @@ private:
 
     void recalculate_rule_caches();
 
+    enum class StyleRuleChange {
+        Inserted,
+        Removed,
+    };
+    void invalidate_owners_for_style_rule(CSSStyleRule const&, StyleRuleChange, DOM::StyleInvalidationReason);
+
     void set_constructed(bool constructed) { m_constructed = constructed; }
     void set_disallow_modification(bool disallow_modification) { m_disallow_modification = disallow_modification; }
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/GenericShorthands.h>
+#include <LibWeb/CSS/CSSNamespaceRule.h>
+#include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/CompiledSelector.h>
+#include <LibWeb/CSS/SelectorEngine.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+
+namespace Web::CSS {
+
+OwnPtr<CompiledSelector> CompiledSelector::compile(Selector const& selector)
+{
+    using NamespaceType = Selector::SimpleSelector::QualifiedName::NamespaceType;
+
+    if (selector.compound_selectors().is_empty() || selector.pseudo_element().has_value())
+        return {};
+
+    Vector<Compound, 2> compounds;
+    compounds.ensure_capacity(selector.compound_selectors().size());
+
+    // NOTE: The combinator of a compound selector joins it to the compound selector before it, so it ends up on the
+    //       compound to the right of the one it's stored on.
+    for (size_t i = selector.compound_selectors().size(); i > 0; --i) {
+        auto const& compound_selector = selector.compound_selectors()[i - 1];
+        auto combinator_to_the_left = i > 1 ? compound_selector.combinator : Selector::Combinator::None;
+        if (!first_is_one_of(combinator_to_the_left, Selector::Combinator::None, Selector::Combinator::Descendant, Selector::Combinator::ImmediateChild))
+            return {};
+
+        Compound compound { .combinator = combinator_to_the_left };
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Universal:
+            case Selector::SimpleSelector::Type::TagName: {
+                auto const& qualified_name = simple_selector.qualified_name();
+                if (qualified_name.namespace_type == NamespaceType::Named)
+                    return {};
+                compound.namespace_type = qualified_name.namespace_type;
+                if (simple_selector.type == Selector::SimpleSelector::Type::TagName)
+                    compound.tag_name = qualified_name.name;
+                break;
+            }
+            case Selector::SimpleSelector::Type::Id:
+                if (compound.id.has_value() && compound.id != simple_selector.name())
+                    return {};
+                compound.id = simple_selector.name();
+                break;
+            case Selector::SimpleSelector::Type::Class:
+                compound.classes.append(simple_selector.name());
+                break;
+            case Selector::SimpleSelector::Type::Attribute: {
+                auto const& attribute = simple_selector.attribute();
+                if (!first_is_one_of(attribute.qualified_name.namespace_type, NamespaceType::Default, NamespaceType::None))
+                    return {};
+
+                Attribute compiled_attribute { .name = attribute.qualified_name.name.name };
+                switch (attribute.match_type) {
+                case Selector::SimpleSelector::Attribute::MatchType::HasAttribute:
+                    break;
+                case Selector::SimpleSelector::Attribute::MatchType::ExactValueMatch:
+                    compiled_attribute.value = attribute.value;
+                    break;
+                default:
+                    return {};
+                }
+
+                switch (attribute.case_type) {
+                case Selector::SimpleSelector::Attribute::CaseType::DefaultMatch:
+                    compiled_attribute.has_case_insensitive_value_in_html = attribute.qualified_name.namespace_type == NamespaceType::Default
+                        && SelectorEngine::is_attribute_with_case_insensitive_value_in_html(compiled_attribute.name);
+                    break;
+                case Selector::SimpleSelector::Attribute::CaseType::CaseSensitiveMatch:
+                    compiled_attribute.case_sensitivity = CaseSensitivity::CaseSensitive;
+                    break;
+                case Selector::SimpleSelector::Attribute::CaseType::CaseInsensitiveMatch:
+                    compiled_attribute.case_sensitivity = CaseSensitivity::CaseInsensitive;
+                    break;
+                }
+
+                compound.attributes.append(move(compiled_attribute));
+                break;
+            }
+            default:
+                return {};
+            }
+        }
+        compounds.unchecked_append(move(compound));
+    }
+
+    return adopt_own(*new CompiledSelector(move(compounds)));
+}
+
+bool CompiledSelector::matches(DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, GC::Ptr<CSSStyleSheet const> style_sheet_for_rule) const
+{
+    // NOTE: All elements visited while matching are in the same document, so what depends on the document is looked
+    //       up once per match, rather than once for every compound.
+    auto const& document = element.document();
+    MatchState<DOM::Element> state {
+        .shadow_host = shadow_host.ptr(),
+        .is_html_document = document.is_html_document(),
+        .class_case_sensitivity = document.in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive,
+    };
+    if (style_sheet_for_rule && style_sheet_for_rule->default_namespace_rule())
+        state.default_namespace = style_sheet_for_rule->default_namespace_rule()->namespace_uri();
+
+    return matches(element, state);
+}
+
+}
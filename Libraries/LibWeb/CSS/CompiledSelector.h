@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Namespace.h>
+
+namespace Web::CSS {
+
+// A selector made only of type, class, ID and [attr] / [attr=value] selectors, joined by descendant and child
+// combinators (e.g. `div.foo`, `.a .b` or `ul > li[hidden]`), compiled into a flat list of compounds when it's added to
+// a rule cache. Every name is resolved up front, and each compound checks the cheapest things first: the ID, then the
+// classes, then the type and the attributes. Anything else isn't compiled, and keeps being matched by the selector
+// engine.
+//
+// NOTE: Rules are rejected with the ancestor bloom filter before they're matched, so compiled selectors don't repeat
+//       that check.
+class CompiledSelector {
+public:
+    static OwnPtr<CompiledSelector> compile(Selector const&);
+
+    bool matches(DOM::Element const&, GC::Ptr<DOM::Element const> shadow_host, GC::Ptr<CSSStyleSheet const> style_sheet_for_rule) const;
+
+    // What matching depends on that's the same for every element visited while matching a selector.
+    template<typename ElementType>
+    struct MatchState {
+        ElementType const* shadow_host { nullptr };
+        // The namespace of the style sheet's default namespace rule, if it has one.
+        Optional<FlyString const&> default_namespace;
+        bool is_html_document { false };
+        CaseSensitivity class_case_sensitivity { CaseSensitivity::CaseSensitive };
+    };
+
+    // NOTE: This is generic over the element type so that matching can be benchmarked without a DOM. The element type has
+    //       to provide the accessors of DOM::Element that are used here.
+    template<typename ElementType>
+    bool matches(ElementType const&, MatchState<ElementType> const&) const;
+
+private:
+    struct Attribute {
+        FlyString name;
+        // Only set for [attr=value], [attr] just has to be present.
+        Optional<String> value;
+        // Only set if the case sensitivity was given explicitly, e.g. [attr=value i].
+        Optional<CaseSensitivity> case_sensitivity;
+        // Whether the value is compared case-insensitively on HTML elements in HTML documents, if no case sensitivity
+        // was given.
+        bool has_case_insensitive_value_in_html { false };
+    };
+
+    struct Compound {
+        // The combinator between this compound and the next one, which is to the left of it in the selector.
+        Selector::Combinator combinator { Selector::Combinator::None };
+        Selector::SimpleSelector::QualifiedName::NamespaceType namespace_type { Selector::SimpleSelector::QualifiedName::NamespaceType::Any };
+        Optional<Selector::SimpleSelector::Name> tag_name;
+        Optional<FlyString> id;
+        Vector<FlyString, 2> classes;
+        Vector<Attribute, 1> attributes;
+    };
+
+    explicit CompiledSelector(Vector<Compound, 2> compounds)
+        : m_compounds(move(compounds))
+    {
+    }
+
+    template<typename ElementType>
+    static bool matches_compound(Compound const&, ElementType const&, MatchState<ElementType> const&);
+
+    // Ordered right to left, i.e. the first one is the subject of the selector.
+    Vector<Compound, 2> m_compounds;
+};
+
+template<typename ElementType>
+bool CompiledSelector::matches_compound(Compound const& compound, ElementType const& element, MatchState<ElementType> const& state)
+{
+    // From within a shadow tree, only :host can match the shadow host, which is never compiled.
+    if (&element == state.shadow_host)
+        return false;
+
+    if (compound.id.has_value() && compound.id != element.id())
+        return false;
+
+    for (auto const& class_name : compound.classes) {
+        // Class selectors are matched case insensitively in quirks mode.
+        // See: https://drafts.csswg.org/selectors-4/#class-html
+        if (!element.has_class(class_name, state.class_case_sensitivity))
+            return false;
+    }
+
+    bool is_html_element_in_html_document = state.is_html_document && element.namespace_uri() == Namespace::HTML;
+
+    if (compound.tag_name.has_value()) {
+        // https://html.spec.whatwg.org/multipage/semantics-other.html#case-sensitivity-of-selectors
+        auto const& tag_name = is_html_element_in_html_document ? compound.tag_name->lowercase_name : compound.tag_name->name;
+        if (tag_name != element.local_name())
+            return false;
+    }
+
+    switch (compound.namespace_type) {
+    case Selector::SimpleSelector::QualifiedName::NamespaceType::Default:
+        if (state.default_namespace.has_value() && element.namespace_uri() != *state.default_namespace)
+            return false;
+        break;
+    case Selector::SimpleSelector::QualifiedName::NamespaceType::None:
+        if (element.namespace_uri().has_value())
+            return false;
+        break;
+    case Selector::SimpleSelector::QualifiedName::NamespaceType::Any:
+        break;
+    case Selector::SimpleSelector::QualifiedName::NamespaceType::Named:
+        VERIFY_NOT_REACHED();
+    }
+
+    for (auto const& attribute : compound.attributes) {
+        auto value = element.get_attribute(attribute.name);
+        if (!value.has_value())
+            return false;
+        if (!attribute.value.has_value())
+            continue;
+
+        auto case_sensitivity = attribute.case_sensitivity.value_or(
+            attribute.has_case_insensitive_value_in_html && is_html_element_in_html_document ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive);
+        if (case_sensitivity == CaseSensitivity::CaseInsensitive ? !value->equals_ignoring_ascii_case(*attribute.value) : *value != *attribute.value)
+            return false;
+    }
+
+    return true;
+}
+
+template<typename ElementType>
+bool CompiledSelector::matches(ElementType const& element, MatchState<ElementType> const& state) const
+{
+    if (!matches_compound(m_compounds.first(), element, state))
+        return false;
+
+    // NOTE: With only descendant and child combinators, if matching fails after a child combinator, it's enough to
+    //       retry from the last descendant combinator, with the next ancestor that matches the compound to its left.
+    ElementType const* current = &element;
+    ElementType const* backtrack_element = nullptr;
+    size_t backtrack_index = 0;
+
+    for (size_t index = 0; index + 1 < m_compounds.size();) {
+        auto const& next_compound = m_compounds[index + 1];
+
+        if (m_compounds[index].combinator == Selector::Combinator::Descendant) {
+            ElementType const* ancestor = current->parent_element();
+            while (ancestor && !matches_compound(next_compound, *ancestor, state))
+                ancestor = ancestor->parent_element();
+            if (!ancestor)
+                return false;
+            backtrack_element = ancestor;
+            backtrack_index = index;
+            current = ancestor;
+            ++index;
+            continue;
+        }
+
+        VERIFY(m_compounds[index].combinator == Selector::Combinator::ImmediateChild);
+        if (ElementType const* parent = current->parent_element(); parent && matches_compound(next_compound, *parent, state)) {
+            current = parent;
+            ++index;
+            continue;
+        }
+
+        if (!backtrack_element)
+            return false;
+        current = backtrack_element;
+        index = backtrack_index;
+        backtrack_element = nullptr;
+    }
+
+    return true;
+}
+
+}
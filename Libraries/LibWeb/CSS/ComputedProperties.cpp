@@ -50,7 +50,11 @@ namespace Web::CSS {
 
 GC_DEFINE_ALLOCATOR(ComputedProperties);
 
-ComputedProperties::ComputedProperties() = default;
+ComputedProperties::ComputedProperties()
+{
+    for (size_t group = 0; group < number_of_computed_value_groups; ++group)
+        m_property_value_groups[group] = ComputedPropertyValueGroup::create(static_cast<ComputedValueGroup>(group));
+}
 
 ComputedProperties::~ComputedProperties() = default;
 
@@ -59,6 +63,31 @@ void ComputedProperties::visit_edges(Visitor& visitor)
     Base::visit_edges(visitor);
 }
 
+RefPtr<StyleValue const> const& ComputedProperties::property_value_slot(PropertyID id) const
+{
+    auto slot = computed_value_slot(id);
+    return m_property_value_groups[to_underlying(slot.group)]->values[slot.index];
+}
+
+RefPtr<StyleValue const>& ComputedProperties::mutable_property_value_slot(PropertyID id)
+{
+    auto slot = computed_value_slot(id);
+    auto& group = m_property_value_groups[to_underlying(slot.group)];
+    if (group->ref_count() > 1)
+        group = group->clone();
+    return group->values[slot.index];
+}
+
+void ComputedProperties::share_property_values_with(ComputedProperties const& other)
+{
+    for (size_t i = 0; i < number_of_computed_value_groups; ++i) {
+        auto& group = m_property_value_groups[i];
+        auto const& other_group = other.m_property_value_groups[i];
+        if (group != other_group && group->has_same_values_as(*other_group))
+            group = other_group;
+    }
+}
+
 bool ComputedProperties::is_property_important(PropertyID property_id) const
 {
     VERIFY(property_id >= first_longhand_property_id && property_id <= last_longhand_property_id);
@@ -153,7 +182,7 @@ void ComputedProperties::set_property_without_modifying_flags(PropertyID id, Non
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = move(value);
+    mutable_property_value_slot(id) = move(value);
 
     if (property_affects_computed_font_list(id))
         clear_computed_font_list_cache();
@@ -163,7 +192,7 @@ void ComputedProperties::revert_property(PropertyID id, ComputedProperties const
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = style_for_revert.m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)];
+    mutable_property_value_slot(id) = style_for_revert.property_value_slot(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -212,7 +241,7 @@ StyleValue const& ComputedProperties::property(PropertyID property_id, WithAnima
     }
 
     // By the time we call this method, the property should have been assigned
-    return *m_property_values[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    return *property_value_slot(property_id);
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -984,9 +1013,10 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    for (size_t i = 0; i < m_property_values.size(); ++i) {
-        auto const& my_style = m_property_values[i];
-        auto const& other_style = other.m_property_values[i];
+    for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+        auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+        auto const& my_style = property_value_slot(property_id);
+        auto const& other_style = other.property_value_slot(property_id);
         if (!my_style) {
             if (other_style)
                 return false;
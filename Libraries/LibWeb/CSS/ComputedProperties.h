@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <AK/FixedArray.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Font/Font.h>
@@ -39,6 +41,39 @@ enum class AnimatedPropertyResultOfTransition : u8 {
     Yes
 };
 
+// A group of computed property values that can be shared between elements, see ComputedProperties::share_property_values_with().
+// Once shared, a group is copied before it gets modified.
+class ComputedPropertyValueGroup : public RefCounted<ComputedPropertyValueGroup> {
+public:
+    static NonnullRefPtr<ComputedPropertyValueGroup> create(ComputedValueGroup group)
+    {
+        auto values = MUST(FixedArray<RefPtr<StyleValue const>>::create(computed_value_group_sizes[to_underlying(group)]));
+        return adopt_ref(*new ComputedPropertyValueGroup(move(values)));
+    }
+    NonnullRefPtr<ComputedPropertyValueGroup> clone() const { return adopt_ref(*new ComputedPropertyValueGroup(MUST(values.clone()))); }
+
+    bool has_same_values_as(ComputedPropertyValueGroup const& other) const
+    {
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i] == other.values[i])
+                continue;
+            if (!values[i] || !other.values[i] || *values[i] != *other.values[i])
+                return false;
+        }
+        return true;
+    }
+
+    size_t memory_usage() const { return sizeof(*this) + values.size() * sizeof(RefPtr<StyleValue const>); }
+
+    FixedArray<RefPtr<StyleValue const>> values;
+
+private:
+    explicit ComputedPropertyValueGroup(FixedArray<RefPtr<StyleValue const>> values)
+        : values(move(values))
+    {
+    }
+};
+
 class WEB_API ComputedProperties final : public JS::Cell {
     GC_CELL(ComputedProperties, JS::Cell);
     GC_DECLARE_ALLOCATOR(ComputedProperties);
@@ -51,12 +86,20 @@ public:
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_property_values.size(); ++i) {
-            if (m_property_values[i])
-                callback(static_cast<PropertyID>(i + to_underlying(first_longhand_property_id)), *m_property_values[i]);
+        for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+            auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+            if (auto const& value = property_value_slot(property_id))
+                callback(property_id, *value);
         }
     }
 
+    // Most elements have the same inherited property values as their parent, and many have the same non-inherited
+    // ones as a sibling. Rather than every element holding a pointer for each longhand, the values are kept in groups
+    // of related properties (font, text, box, border, ...), and this shares each group with the other style if all of
+    // its values are the same. Changing a single property then only unshares the group it's in.
+    void share_property_values_with(ComputedProperties const&);
+    ComputedPropertyValueGroup const& property_value_group(ComputedValueGroup group) const { return *m_property_value_groups[to_underlying(group)]; }
+
     enum class Inherited {
         No,
         Yes
@@ -290,7 +333,10 @@ private:
     Vector<ShadowData> shadow(PropertyID, Layout::Node const&) const;
     Position position_value(PropertyID) const;
 
-    Array<RefPtr<StyleValue const>, number_of_longhand_properties> m_property_values;
+    RefPtr<StyleValue const> const& property_value_slot(PropertyID) const;
+    RefPtr<StyleValue const>& mutable_property_value_slot(PropertyID);
+
+    Array<RefPtr<ComputedPropertyValueGroup>, number_of_computed_value_groups> m_property_value_groups;
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_important {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_inherited {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_animated_property_inherited {};
@@ -110,10 +110,12 @@ void MediaList::delete_medium(StringView medium)
     // FIXME: If nothing was removed, then throw a NotFoundError exception.
 }
 
-bool MediaList::evaluate(DOM::Document const& document)
+bool MediaList::evaluate(DOM::Document const& document, MediaFeatureDependencies changed_features)
 {
-    for (auto& media : m_media)
-        media->evaluate(document);
+    for (auto& media : m_media) {
+        if (media->needs_evaluation(changed_features))
+            media->evaluate(document);
+    }
 
     return matches();
 }
@@ -130,6 +132,14 @@ bool MediaList::matches() const
     return false;
 }
 
+MediaFeatureDependencies MediaList::dependencies() const
+{
+    auto dependencies = MediaFeatureDependencies::None;
+    for (auto const& media : m_media)
+        dependencies |= media->dependencies();
+    return dependencies;
+}
+
 Optional<JS::Value> MediaList::item_value(size_t index) const
 {
     if (index >= m_media.size())
@@ -33,8 +33,10 @@ public:
 
     virtual Optional<JS::Value> item_value(size_t index) const override;
 
-    bool evaluate(DOM::Document const&);
+    // Only evaluates the media queries that depend on one of the changed media features, or weren't evaluated yet.
+    bool evaluate(DOM::Document const&, MediaFeatureDependencies changed_features = MediaFeatureDependencies::All);
     bool matches() const;
+    MediaFeatureDependencies dependencies() const;
 
     void set_associated_style_sheet(GC::Ref<StyleSheet> style_sheet) { m_associated_style_sheet = style_sheet; }
 
@@ -289,8 +289,68 @@ String MediaQuery::to_string() const
     return MUST(builder.to_string());
 }
 
+MediaFeatureDependencies MediaFeature::dependencies() const
+{
+    auto dependencies = [&] {
+        switch (m_id) {
+        case MediaFeatureID::AspectRatio:
+        case MediaFeatureID::DeviceAspectRatio:
+        case MediaFeatureID::DeviceHeight:
+        case MediaFeatureID::DeviceWidth:
+        case MediaFeatureID::Height:
+        case MediaFeatureID::HorizontalViewportSegments:
+        case MediaFeatureID::Orientation:
+        case MediaFeatureID::VerticalViewportSegments:
+        case MediaFeatureID::Width:
+            // NOTE: The screen size usually changes together with the viewport, e.g. when moving to another screen.
+            return MediaFeatureDependencies::Viewport;
+        case MediaFeatureID::Resolution:
+            return MediaFeatureDependencies::Resolution;
+        case MediaFeatureID::ForcedColors:
+        case MediaFeatureID::InvertedColors:
+        case MediaFeatureID::PrefersColorScheme:
+        case MediaFeatureID::PrefersContrast:
+        case MediaFeatureID::PrefersReducedData:
+        case MediaFeatureID::PrefersReducedMotion:
+        case MediaFeatureID::PrefersReducedTransparency:
+            return MediaFeatureDependencies::UserPreferences;
+        default:
+            return MediaFeatureDependencies::Other;
+        }
+    }();
+
+    // Lengths we compare against may be relative to the viewport.
+    auto depends_on_length = [&](Optional<MediaFeatureValue> const& value) {
+        return value.has_value() && value->is_length();
+    };
+    bool compares_lengths = m_value.visit(
+        [](Empty const&) { return false; },
+        [&](MediaFeatureValue const& value) { return depends_on_length(value); },
+        [&](Range const& range) { return depends_on_length(range.left_value) || depends_on_length(range.right_value); });
+    if (compares_lengths)
+        dependencies |= MediaFeatureDependencies::Viewport;
+
+    return dependencies;
+}
+
+static void collect_media_feature_dependencies(BooleanExpression const& expression, MediaFeatureDependencies& dependencies)
+{
+    if (auto const* media_feature = as_if<MediaFeature>(expression))
+        dependencies |= media_feature->dependencies();
+    expression.for_each_child([&](BooleanExpression const& child) {
+        collect_media_feature_dependencies(child, dependencies);
+    });
+}
+
 bool MediaQuery::evaluate(DOM::Document const& document)
 {
+    if (!m_dependencies.has_value()) {
+        auto dependencies = MediaFeatureDependencies::None;
+        if (m_media_condition)
+            collect_media_feature_dependencies(*m_media_condition, dependencies);
+        m_dependencies = dependencies;
+    }
+
     auto matches_media = [](MediaType const& media) -> MatchResult {
         if (!media.known_type.has_value())
             return MatchResult::False;
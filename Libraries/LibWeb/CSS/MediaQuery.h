@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/EnumBits.h>
 #include <AK/FlyString.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
@@ -101,6 +102,20 @@ private:
     Variant<Keyword, LengthOrCalculated, Ratio, ResolutionOrCalculated, IntegerOrCalculated, Vector<Parser::ComponentValue>> m_value;
 };
 
+// The parts of the environment that the result of a media query depends on. These let the document only evaluate the
+// media queries that can be affected by a change, e.g. only the ones that depend on the viewport when it is resized.
+enum class MediaFeatureDependencies : u8 {
+    None = 0,
+    Viewport = 1 << 0,
+    Resolution = 1 << 1,
+    UserPreferences = 1 << 2,
+    // Everything that isn't expected to change while a document is displayed, like the pointer or scripting.
+    Other = 1 << 3,
+    All = Viewport | Resolution | UserPreferences | Other,
+};
+
+AK_ENUM_BITWISE_OPERATORS(MediaFeatureDependencies);
+
 // https://www.w3.org/TR/mediaqueries-4/#mq-features
 class MediaFeature final : public BooleanExpression {
 public:
@@ -165,6 +180,8 @@ public:
     virtual String to_string() const override;
     virtual void dump(StringBuilder&, int indent_levels = 0) const override;
 
+    MediaFeatureDependencies dependencies() const;
+
 private:
     enum class Type : u8 {
         IsTrue,
@@ -221,6 +238,13 @@ public:
     bool evaluate(DOM::Document const&);
     String to_string() const;
 
+    // Whether evaluate() could return something else than last time, given the media features that changed since.
+    bool needs_evaluation(MediaFeatureDependencies changed_features) const
+    {
+        return !m_dependencies.has_value() || has_any_flag(*m_dependencies, changed_features);
+    }
+    MediaFeatureDependencies dependencies() const { return m_dependencies.value_or(MediaFeatureDependencies::All); }
+
     void dump(StringBuilder&, int indent_levels = 0) const;
 
 private:
@@ -233,6 +257,9 @@ private:
 
     // Cached value, updated by evaluate()
     bool m_matches { false };
+
+    // Determined by the first call to evaluate().
+    Optional<MediaFeatureDependencies> m_dependencies;
 };
 
 String serialize_a_media_query_list(Vector<NonnullRefPtr<MediaQuery>> const&);
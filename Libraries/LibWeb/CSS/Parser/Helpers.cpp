@@ -44,6 +44,43 @@ GC::Ref<JS::Realm> internal_css_realm()
     return *realm;
 }
 
+struct CachedStyleSheetRules : public RefCounted<CachedStyleSheetRules> {
+    CachedStyleSheetRules(String source, Vector<CSS::Parser::Rule> rules)
+        : source(move(source))
+        , rules(move(rules))
+    {
+    }
+
+    String source;
+    Vector<CSS::Parser::Rule> rules;
+};
+
+// The same external style sheet is often loaded by several documents in one process, e.g. a page and its iframes, or
+// successive pages of the same site. Tokenizing and consuming the rules of a large style sheet is a good part of the
+// cost of parsing it, so we keep the raw rules of the most recently loaded style sheets around, keyed by their contents.
+// Every document still gets its own CSSStyleSheet and CSSRule objects, so CSSOM mutations are never shared.
+static constexpr size_t max_cached_style_sheet_rules = 16;
+
+static NonnullRefPtr<CachedStyleSheetRules const> cached_style_sheet_rules(StringView css)
+{
+    // NOTE: Ordered from least to most recently used.
+    static Vector<NonnullRefPtr<CachedStyleSheetRules const>> s_cached_style_sheet_rules;
+
+    for (size_t i = 0; i < s_cached_style_sheet_rules.size(); ++i) {
+        if (s_cached_style_sheet_rules[i]->source != css)
+            continue;
+        auto cached_rules = s_cached_style_sheet_rules.take(i);
+        s_cached_style_sheet_rules.append(cached_rules);
+        return cached_rules;
+    }
+
+    auto cached_rules = adopt_ref(*new CachedStyleSheetRules(MUST(String::from_utf8(css)), CSS::Parser::Parser::create(CSS::Parser::ParsingParams {}, css).parse_as_css_stylesheet_rules()));
+    if (s_cached_style_sheet_rules.size() == max_cached_style_sheet_rules)
+        s_cached_style_sheet_rules.take_first();
+    s_cached_style_sheet_rules.append(cached_rules);
+    return cached_rules;
+}
+
 GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams const& context, StringView css, Optional<::URL::URL> location, GC::Ptr<CSS::MediaList> media_list)
 {
     if (css.is_empty()) {
@@ -54,9 +91,18 @@ GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams cons
         style_sheet->set_source_text({});
         return style_sheet;
     }
-    auto style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location, move(media_list));
-    // FIXME: Avoid this copy
-    style_sheet->set_source_text(MUST(String::from_utf8(css)));
+
+    // External style sheets are only cached at the top level, where the raw rules can't depend on the rule context.
+    if (!location.has_value() || !context.rule_context.is_empty()) {
+        auto style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location, move(media_list));
+        // FIXME: Avoid this copy
+        style_sheet->set_source_text(MUST(String::from_utf8(css)));
+        return style_sheet;
+    }
+
+    auto cached_rules = cached_style_sheet_rules(css);
+    auto style_sheet = CSS::Parser::Parser::create(context, ""sv).convert_to_css_stylesheet(cached_rules->rules, location, move(media_list));
+    style_sheet->set_source_text(cached_rules->source);
     return style_sheet;
 }
 
@@ -172,7 +172,17 @@ GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet(Optional<::URL::URL>
     // To parse a CSS stylesheet, first parse a stylesheet.
     auto const& style_sheet = parse_a_stylesheet(m_token_stream, location);
 
-    auto rule_list = CSSRuleList::create(realm(), convert_rules(style_sheet.rules));
+    return convert_to_css_stylesheet(style_sheet.rules, move(location), media_list);
+}
+
+Vector<Rule> Parser::parse_as_css_stylesheet_rules()
+{
+    return parse_a_stylesheet(m_token_stream, {}).rules;
+}
+
+GC::Ref<CSS::CSSStyleSheet> Parser::convert_to_css_stylesheet(Vector<Rule> const& raw_rules, Optional<::URL::URL> location, GC::Ptr<MediaList> media_list)
+{
+    auto rule_list = CSSRuleList::create(realm(), convert_rules(raw_rules));
     if (!media_list)
         media_list = MediaList::create(realm(), {});
     return CSSStyleSheet::create(realm(), rule_list, *media_list, move(location));
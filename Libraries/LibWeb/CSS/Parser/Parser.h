@@ -119,6 +119,11 @@ public:
     GC::RootVector<GC::Ref<CSSRule>> convert_rules(Vector<Rule> const& raw_rules);
     GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet(Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
 
+    // Parse a CSS stylesheet in two steps. The raw rules only depend on the input, so they can be kept around and
+    // converted into a style sheet again for another document, without tokenizing the input again.
+    Vector<Rule> parse_as_css_stylesheet_rules();
+    GC::Ref<CSS::CSSStyleSheet> convert_to_css_stylesheet(Vector<Rule> const& raw_rules, Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
+
     struct PropertiesAndCustomProperties {
         Vector<StyleProperty> properties;
         OrderedHashMap<FlyString, StyleProperty> custom_properties;
@@ -7,6 +7,7 @@
 
 #include "Selector.h"
 #include <AK/GenericShorthands.h>
+#include <LibWeb/CSS/CompiledSelector.h>
 #include <LibWeb/CSS/Parser/ErrorReporter.h>
 #include <LibWeb/CSS/Serialize.h>
 
@@ -128,6 +129,16 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     m_can_use_fast_matches = can_selector_use_fast_matches(*this);
 }
 
+Selector::~Selector() = default;
+
+void Selector::compile_if_possible() const
+{
+    if (m_did_try_to_compile)
+        return;
+    m_did_try_to_compile = true;
+    m_compiled_selector = CompiledSelector::compile(*this);
+}
+
 void Selector::collect_ancestor_hashes()
 {
     if (is_slotted()) {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/FlyString.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
@@ -19,6 +20,8 @@
 
 namespace Web::CSS {
 
+class CompiledSelector;
+
 using SelectorList = Vector<NonnullRefPtr<class Selector>>;
 
 // This is a <complex-selector> in the spec. https://www.w3.org/TR/selectors-4/#complex
@@ -212,7 +215,7 @@ public:
         return adopt_ref(*new Selector(move(compound_selectors)));
     }
 
-    ~Selector() = default;
+    ~Selector();
 
     Vector<CompoundSelector> const& compound_selectors() const { return m_compound_selectors; }
     Optional<PseudoElementSelector> const& pseudo_element() const { return m_pseudo_element; }
@@ -229,6 +232,11 @@ public:
     bool can_use_fast_matches() const { return m_can_use_fast_matches; }
     bool can_use_ancestor_filter() const { return m_can_use_ancestor_filter; }
 
+    // Compiles the selector if it's simple enough, so that it can be matched without interpreting it. This is done when
+    // building rule caches, rather than for every parsed selector.
+    void compile_if_possible() const;
+    CompiledSelector const* compiled_selector() const { return m_compiled_selector.ptr(); }
+
     size_t sibling_invalidation_distance() const;
 
     bool is_slotted() const { return m_pseudo_element.has_value() && m_pseudo_element->type() == PseudoElement::Slotted; }
@@ -244,6 +252,8 @@ private:
     bool m_can_use_fast_matches { false };
     bool m_can_use_ancestor_filter { false };
     bool m_contains_the_nesting_selector { false };
+    mutable bool m_did_try_to_compile { false };
+    mutable OwnPtr<CompiledSelector> m_compiled_selector;
 
     PseudoClassBitmap m_contained_pseudo_classes;
 
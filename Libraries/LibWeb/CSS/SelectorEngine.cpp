@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/CSS/CompiledSelector.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/Keyword.h>
 #include <LibWeb/CSS/Parser/Parser.h>
@@ -377,6 +378,24 @@ static bool matches_single_attribute(CSS::Selector::SimpleSelector::Attribute co
     return false;
 }
 
+// https://html.spec.whatwg.org/multipage/semantics-other.html#case-sensitivity-of-selectors
+bool is_attribute_with_case_insensitive_value_in_html(FlyString const& attribute_name)
+{
+    return attribute_name.is_one_of(
+        HTML::AttributeNames::accept, HTML::AttributeNames::accept_charset, HTML::AttributeNames::align,
+        HTML::AttributeNames::alink, HTML::AttributeNames::axis, HTML::AttributeNames::bgcolor, HTML::AttributeNames::charset,
+        HTML::AttributeNames::checked, HTML::AttributeNames::clear, HTML::AttributeNames::codetype, HTML::AttributeNames::color,
+        HTML::AttributeNames::compact, HTML::AttributeNames::declare, HTML::AttributeNames::defer, HTML::AttributeNames::dir,
+        HTML::AttributeNames::direction, HTML::AttributeNames::disabled, HTML::AttributeNames::enctype, HTML::AttributeNames::face,
+        HTML::AttributeNames::frame, HTML::AttributeNames::hreflang, HTML::AttributeNames::http_equiv, HTML::AttributeNames::lang,
+        HTML::AttributeNames::language, HTML::AttributeNames::link, HTML::AttributeNames::media, HTML::AttributeNames::method,
+        HTML::AttributeNames::multiple, HTML::AttributeNames::nohref, HTML::AttributeNames::noresize, HTML::AttributeNames::noshade,
+        HTML::AttributeNames::nowrap, HTML::AttributeNames::readonly, HTML::AttributeNames::rel, HTML::AttributeNames::rev,
+        HTML::AttributeNames::rules, HTML::AttributeNames::scope, HTML::AttributeNames::scrolling, HTML::AttributeNames::selected,
+        HTML::AttributeNames::shape, HTML::AttributeNames::target, HTML::AttributeNames::text, HTML::AttributeNames::type,
+        HTML::AttributeNames::valign, HTML::AttributeNames::valuetype, HTML::AttributeNames::vlink);
+}
+
 static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute const& attribute, [[maybe_unused]] GC::Ptr<CSS::CSSStyleSheet const> style_sheet_for_rule, DOM::Element const& element)
 {
     auto const& attribute_name = attribute.qualified_name.name.name;
@@ -392,19 +411,7 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
             if (element.document().is_html_document()
                 && element.namespace_uri() == Namespace::HTML
                 && attribute.qualified_name.namespace_type == CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Default
-                && attribute_name.is_one_of(
-                    HTML::AttributeNames::accept, HTML::AttributeNames::accept_charset, HTML::AttributeNames::align,
-                    HTML::AttributeNames::alink, HTML::AttributeNames::axis, HTML::AttributeNames::bgcolor, HTML::AttributeNames::charset,
-                    HTML::AttributeNames::checked, HTML::AttributeNames::clear, HTML::AttributeNames::codetype, HTML::AttributeNames::color,
-                    HTML::AttributeNames::compact, HTML::AttributeNames::declare, HTML::AttributeNames::defer, HTML::AttributeNames::dir,
-                    HTML::AttributeNames::direction, HTML::AttributeNames::disabled, HTML::AttributeNames::enctype, HTML::AttributeNames::face,
-                    HTML::AttributeNames::frame, HTML::AttributeNames::hreflang, HTML::AttributeNames::http_equiv, HTML::AttributeNames::lang,
-                    HTML::AttributeNames::language, HTML::AttributeNames::link, HTML::AttributeNames::media, HTML::AttributeNames::method,
-                    HTML::AttributeNames::multiple, HTML::AttributeNames::nohref, HTML::AttributeNames::noresize, HTML::AttributeNames::noshade,
-                    HTML::AttributeNames::nowrap, HTML::AttributeNames::readonly, HTML::AttributeNames::rel, HTML::AttributeNames::rev,
-                    HTML::AttributeNames::rules, HTML::AttributeNames::scope, HTML::AttributeNames::scrolling, HTML::AttributeNames::selected,
-                    HTML::AttributeNames::shape, HTML::AttributeNames::target, HTML::AttributeNames::text, HTML::AttributeNames::type,
-                    HTML::AttributeNames::valign, HTML::AttributeNames::valuetype, HTML::AttributeNames::vlink)) {
+                && is_attribute_with_case_insensitive_value_in_html(attribute_name)) {
                 return CaseSensitivity::CaseInsensitive;
             }
 
@@ -1253,8 +1260,11 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
 
 bool matches(CSS::Selector const& selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context, Optional<CSS::PseudoElement> pseudo_element, GC::Ptr<DOM::ParentNode const> scope, SelectorKind selector_kind, GC::Ptr<DOM::Element const> anchor)
 {
-    if (selector_kind == SelectorKind::Normal && selector.can_use_fast_matches()) {
-        return fast_matches(selector, element, shadow_host, context);
+    if (selector_kind == SelectorKind::Normal) {
+        if (auto const* compiled_selector = selector.compiled_selector())
+            return compiled_selector->matches(element, shadow_host, context.style_sheet_for_rule);
+        if (selector.can_use_fast_matches())
+            return fast_matches(selector, element, shadow_host, context);
     }
     VERIFY(!selector.compound_selectors().is_empty());
     // FIXME: Selectors can have multiple pseudo-elements, and we need to check them one by one, not just do a simple match.
@@ -1268,8 +1278,20 @@ bool matches(CSS::Selector const& selector, DOM::Element const& element, GC::Ptr
     return matches(selector, selector.compound_selectors().size() - 1, element, shadow_host, context, scope, selector_kind, anchor);
 }
 
-static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
+// NOTE: All elements that a selector is matched against are in the same document, so what depends on the document is
+//       looked up once per match, rather than once for every simple selector.
+struct FastMatchState {
+    GC::Ptr<DOM::Element const> shadow_host;
+    MatchContext& context;
+    bool is_html_document { false };
+    CaseSensitivity class_case_sensitivity { CaseSensitivity::CaseSensitive };
+};
+
+static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, DOM::Element const& element, FastMatchState const& state)
 {
+    auto shadow_host = state.shadow_host;
+    auto& context = state.context;
+
     if (should_block_shadow_host_matching(simple_selector, shadow_host, element))
         return false;
 
@@ -1281,7 +1303,7 @@ static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& si
         // When comparing a CSS element type selector to the names of HTML elements in HTML documents, the CSS element type selector must first be converted to ASCII lowercase. The
         // same selector when compared to other elements must be compared according to its original case. In both cases, to match the values must be identical to each other (and therefore
         // the comparison is case sensitive).
-        if (element.namespace_uri() == Namespace::HTML && element.document().document_type() == DOM::Document::Type::HTML) {
+        if (state.is_html_document && element.namespace_uri() == Namespace::HTML) {
             if (simple_selector.qualified_name().name.lowercase_name != element.local_name())
                 return false;
         } else if (simple_selector.qualified_name().name.name != element.local_name()) {
@@ -1292,8 +1314,7 @@ static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& si
     case CSS::Selector::SimpleSelector::Type::Class: {
         // Class selectors are matched case insensitively in quirks mode.
         // See: https://drafts.csswg.org/selectors-4/#class-html
-        auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
-        return element.has_class(simple_selector.name(), case_sensitivity);
+        return element.has_class(simple_selector.name(), state.class_case_sensitivity);
     }
     case CSS::Selector::SimpleSelector::Type::Id:
         return simple_selector.name() == element.id();
@@ -1306,10 +1327,10 @@ static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& si
     }
 }
 
-static bool fast_matches_compound_selector(CSS::Selector::CompoundSelector const& compound_selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
+static bool fast_matches_compound_selector(CSS::Selector::CompoundSelector const& compound_selector, DOM::Element const& element, FastMatchState const& state)
 {
     for (auto const& simple_selector : compound_selector.simple_selectors) {
-        if (!fast_matches_simple_selector(simple_selector, element, shadow_host, context))
+        if (!fast_matches_simple_selector(simple_selector, element, state))
             return false;
     }
     return true;
@@ -1319,9 +1340,17 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
 {
     DOM::Element const* current = &element_to_match;
 
+    auto const& document = element_to_match.document();
+    FastMatchState state {
+        .shadow_host = shadow_host,
+        .context = context,
+        .is_html_document = document.document_type() == DOM::Document::Type::HTML,
+        .class_case_sensitivity = document.in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive,
+    };
+
     ssize_t compound_selector_index = selector.compound_selectors().size() - 1;
 
-    if (!fast_matches_compound_selector(selector.compound_selectors().last(), *current, shadow_host, context))
+    if (!fast_matches_compound_selector(selector.compound_selectors().last(), *current, state))
         return false;
 
     // NOTE: If we fail after following a child combinator, we may need to backtrack
@@ -1344,7 +1373,7 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
             backtrack_state = { current->parent_element(), compound_selector_index };
             compound_selector = &selector.compound_selectors()[--compound_selector_index];
             for (current = current->parent_element(); current; current = current->parent_element()) {
-                if (fast_matches_compound_selector(*compound_selector, *current, shadow_host, context))
+                if (fast_matches_compound_selector(*compound_selector, *current, state))
                     break;
             }
             if (!current)
@@ -1355,7 +1384,7 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
             current = current->parent_element();
             if (!current)
                 return false;
-            if (!fast_matches_compound_selector(*compound_selector, *current, shadow_host, context)) {
+            if (!fast_matches_compound_selector(*compound_selector, *current, state)) {
                 if (backtrack_state.element) {
                     current = backtrack_state.element;
                     compound_selector_index = backtrack_state.compound_selector_index;
@@ -1370,4 +1399,11 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
     }
 }
 
+bool matches_pseudo_class_without_arguments(CSS::PseudoClass pseudo_class, DOM::Element const& element)
+{
+    CSS::Selector::SimpleSelector::PseudoClassSelector pseudo_class_selector { .type = pseudo_class };
+    MatchContext context;
+    return matches_pseudo_class(pseudo_class_selector, element, nullptr, context, nullptr, SelectorKind::Normal);
+}
+
 }
@@ -55,4 +55,10 @@ struct MatchContext {
 
 bool matches(CSS::Selector const&, DOM::Element const&, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context, Optional<CSS::PseudoElement> = {}, GC::Ptr<DOM::ParentNode const> scope = {}, SelectorKind selector_kind = SelectorKind::Normal, GC::Ptr<DOM::Element const> anchor = nullptr);
 
+// Whether the value of an attribute with this name is matched case-insensitively on HTML elements in HTML documents.
+bool is_attribute_with_case_insensitive_value_in_html(FlyString const& attribute_name);
+
+// Matches the identifier form of a pseudo-class (e.g. :hover or :checked) against the element on its own.
+bool matches_pseudo_class_without_arguments(CSS::PseudoClass, DOM::Element const&);
+
 }
@@ -75,6 +75,7 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
@@ -135,6 +136,8 @@ void StyleComputer::visit_edges(Visitor& visitor)
     visitor.visit(m_document);
     if (m_has_result_cache)
         visitor.visit(*m_has_result_cache);
+    for (auto const& candidate : m_style_sharing_candidates)
+        visitor.visit(candidate.element);
 }
 
 Optional<String> StyleComputer::user_agent_style_sheet_source(StringView name)
@@ -157,6 +160,10 @@ Optional<String> StyleComputer::user_agent_style_sheet_source(StringView name)
 
 RuleCache const* StyleComputer::rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, Optional<FlyString const> qualified_layer_name, GC::Ptr<DOM::ShadowRoot const> shadow_root) const
 {
+    // NOTE: Every style scope shares the same user agent rule cache, so it's enough to look at it through the document's.
+    if (cascade_origin == CascadeOrigin::UserAgent && shadow_root)
+        return nullptr;
+
     auto& style_scope = shadow_root ? shadow_root->style_scope() : document().style_scope();
     style_scope.build_rule_cache_if_needed();
 
@@ -1843,6 +1850,12 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractEleme
 
     ScopeGuard guard { [&abstract_element]() { abstract_element.element().set_needs_style_update(false); } };
 
+    bool is_style_sharing_candidate = m_style_sharing_enabled && mode == ComputeStyleMode::Normal && !abstract_element.pseudo_element().has_value();
+    if (is_style_sharing_candidate) {
+        if (auto computed_properties = compute_style_from_sharing_candidate(abstract_element.element(), did_change_custom_properties))
+            return computed_properties;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
@@ -1899,9 +1912,176 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractEleme
         *did_change_custom_properties = true;
     }
 
+    if (is_style_sharing_candidate)
+        add_style_sharing_candidate(abstract_element.element(), attempted_pseudo_class_matches);
+
     return computed_properties;
 }
 
+static bool element_can_share_style(DOM::Element const& element)
+{
+    // Rules from a shadow root apply to its host, and ::slotted() rules to elements assigned to a slot, which siblings
+    // don't necessarily have in common.
+    if (!element.parent_element() || element.is_shadow_host() || element.assigned_slot_internal())
+        return false;
+
+    // Inline style is specific to each element.
+    if (element.inline_style())
+        return false;
+
+    return true;
+}
+
+static bool style_can_be_shared(DOM::Element const& element, PseudoClassBitmap const& attempted_pseudo_class_matches)
+{
+    if (!element_can_share_style(element))
+        return false;
+
+    // Selectors that depend on an element's siblings, or on its descendants via :has(), can't tell apart elements that
+    // look the same, but they still match those elements differently.
+    if (element.style_affected_by_structural_changes()
+        || element.affected_by_has_pseudo_class_in_subject_position()
+        || element.affected_by_has_pseudo_class_in_non_subject_position()
+        || element.affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator()
+        || element.style_uses_tree_counting_function())
+        return false;
+
+    for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+        auto pseudo_class = static_cast<PseudoClass>(i);
+        if (!attempted_pseudo_class_matches.get(pseudo_class))
+            continue;
+        switch (pseudo_class_metadata(pseudo_class).parameter_type) {
+        case PseudoClassMetadata::ParameterType::ANPlusB:
+        case PseudoClassMetadata::ParameterType::ANPlusBOf:
+        case PseudoClassMetadata::ParameterType::ForgivingRelativeSelectorList:
+        case PseudoClassMetadata::ParameterType::Ident:
+        case PseudoClassMetadata::ParameterType::RelativeSelectorList:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+static bool has_same_attributes(DOM::Element const& element, DOM::Element const& other)
+{
+    auto attribute_count = element.attribute_list_size();
+    if (attribute_count != other.attribute_list_size())
+        return false;
+    if (attribute_count == 0)
+        return true;
+
+    auto const& attributes = *element.attributes();
+    auto const& other_attributes = *other.attributes();
+    for (u32 i = 0; i < attribute_count; ++i) {
+        auto const& attribute = *attributes.item(i);
+        auto const& other_attribute = *other_attributes.item(i);
+        if (attribute.namespace_uri() != other_attribute.namespace_uri()
+            || attribute.local_name() != other_attribute.local_name()
+            || attribute.value() != other_attribute.value())
+            return false;
+    }
+    return true;
+}
+
+static bool matches_same_pseudo_classes(DOM::Element const& element, DOM::Element const& other, PseudoClassBitmap const& attempted_pseudo_class_matches)
+{
+    for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+        auto pseudo_class = static_cast<PseudoClass>(i);
+        if (!attempted_pseudo_class_matches.get(pseudo_class))
+            continue;
+        // NOTE: The pseudo-classes inside the arguments of functional ones like :is() were attempted as well, so we
+        //       only have to compare the ones that can be matched on their own.
+        if (!pseudo_class_metadata(pseudo_class).is_valid_as_identifier)
+            continue;
+        if (SelectorEngine::matches_pseudo_class_without_arguments(pseudo_class, element) != SelectorEngine::matches_pseudo_class_without_arguments(pseudo_class, other))
+            return false;
+    }
+    return true;
+}
+
+GC::Ptr<ComputedProperties> StyleComputer::compute_style_from_sharing_candidate(DOM::Element& element, Optional<bool&> did_change_custom_properties) const
+{
+    if (!element_can_share_style(element))
+        return {};
+
+    // An element can share the style of a candidate that no selector can tell apart from it: they have the same parent,
+    // name and attributes (which includes id and class), and agree on every pseudo-class that was tried on the candidate.
+    Optional<StyleSharingCandidate const&> candidate;
+    for (auto const& it : m_style_sharing_candidates.in_reverse()) {
+        auto const& candidate_element = *it.element;
+        if (candidate_element.parent() != element.parent()
+            || candidate_element.local_name() != element.local_name()
+            || candidate_element.namespace_uri() != element.namespace_uri()
+            || !has_same_attributes(candidate_element, element)
+            || !matches_same_pseudo_classes(candidate_element, element, it.attempted_pseudo_class_matches))
+            continue;
+        candidate = it;
+        break;
+    }
+
+    if (!candidate.has_value()) {
+        ++m_style_sharing_statistics.unshared_styles;
+        return {};
+    }
+    ++m_style_sharing_statistics.shared_styles;
+
+    // The cascaded values are never modified once the cascade is done, so the element can simply point at the
+    // candidate's. Computed values still have to be computed for each element, as they include its animations.
+    auto const& candidate_element = *candidate->element;
+    DOM::AbstractElement abstract_element { element };
+
+    auto old_custom_properties = abstract_element.custom_properties();
+    auto custom_properties = candidate_element.custom_properties({});
+    abstract_element.set_custom_properties(move(custom_properties));
+
+    auto cascaded_properties = candidate_element.cascaded_properties({});
+    VERIFY(cascaded_properties);
+    abstract_element.set_cascaded_properties(cascaded_properties);
+
+    if (candidate_element.style_uses_attr_css_function())
+        element.set_style_uses_attr_css_function();
+    if (candidate_element.style_uses_var_css_function())
+        element.set_style_uses_var_css_function();
+
+    auto computed_properties = compute_properties(abstract_element, *cascaded_properties);
+    computed_properties->set_attempted_pseudo_class_matches(candidate->attempted_pseudo_class_matches);
+
+    if (did_change_custom_properties.has_value() && abstract_element.custom_properties() != old_custom_properties)
+        *did_change_custom_properties = true;
+
+    return computed_properties;
+}
+
+void StyleComputer::add_style_sharing_candidate(DOM::Element const& element, PseudoClassBitmap const& attempted_pseudo_class_matches) const
+{
+    if (!style_can_be_shared(element, attempted_pseudo_class_matches))
+        return;
+
+    if (m_style_sharing_candidates.size() == max_style_sharing_candidates)
+        m_style_sharing_candidates.remove(0);
+    m_style_sharing_candidates.append({ element, attempted_pseudo_class_matches });
+}
+
+void StyleComputer::start_style_sharing()
+{
+    m_style_sharing_enabled = true;
+    m_style_sharing_candidates.clear();
+    m_style_sharing_statistics = {};
+}
+
+void StyleComputer::stop_style_sharing()
+{
+    m_style_sharing_enabled = false;
+    m_style_sharing_candidates.clear();
+
+    m_total_style_sharing_statistics.shared_styles += m_style_sharing_statistics.shared_styles;
+    m_total_style_sharing_statistics.unshared_styles += m_style_sharing_statistics.unshared_styles;
+
+    dbgln_if(STYLE_SHARING_DEBUG, "Style sharing: {} shared, {} unshared", m_style_sharing_statistics.shared_styles, m_style_sharing_statistics.unshared_styles);
+}
+
 static bool is_monospace(StyleValue const& value)
 {
     if (!value.is_value_list())
@@ -2088,6 +2268,16 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::AbstractEleme
         start_needed_transitions(*previous_style, computed_style, abstract_element);
     }
 
+    // 9. Share the property values with the parent's or the previous sibling's style where they are the same.
+    if (auto parent = abstract_element.element_to_inherit_style_from(); parent.has_value()) {
+        if (auto parent_style = parent->computed_properties())
+            computed_style->share_property_values_with(*parent_style);
+    }
+    if (!abstract_element.pseudo_element().has_value()) {
+        if (auto const* previous_sibling = abstract_element.element().previous_element_sibling(); previous_sibling && previous_sibling->computed_properties())
+            computed_style->share_property_values_with(*previous_sibling->computed_properties());
+    }
+
     return computed_style;
 }
 
@@ -100,6 +100,19 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // Style sharing lets an element reuse the matched rules and cascaded values of a recently styled sibling that no
+    // selector can tell apart from it. It's only enabled for the duration of a style update, since that's the only
+    // time the DOM is guaranteed not to change between computing the styles of two siblings.
+    struct StyleSharingStatistics {
+        size_t shared_styles { 0 };
+        size_t unshared_styles { 0 };
+    };
+    void start_style_sharing();
+    void stop_style_sharing();
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+    // The sum of the statistics of every style update so far, for tests to observe.
+    StyleSharingStatistics const& total_style_sharing_statistics() const { return m_total_style_sharing_statistics; }
+
     [[nodiscard]] GC::Ref<ComputedProperties> create_document_style() const;
 
     [[nodiscard]] GC::Ref<ComputedProperties> compute_style(DOM::AbstractElement, Optional<bool&> did_change_custom_properties = {}) const;
@@ -166,6 +179,8 @@ private:
 
     LogicalAliasMappingContext compute_logical_alias_mapping_context(DOM::AbstractElement, ComputeStyleMode, MatchingRuleSet const&) const;
     [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_impl(DOM::AbstractElement, ComputeStyleMode, Optional<bool&> did_change_custom_properties, StyleScope const&) const;
+    [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_from_sharing_candidate(DOM::Element&, Optional<bool&> did_change_custom_properties) const;
+    void add_style_sharing_candidate(DOM::Element const&, PseudoClassBitmap const& attempted_pseudo_class_matches) const;
     [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::AbstractElement, bool did_match_any_pseudo_element_rules, ComputeStyleMode, MatchingRuleSet const&, Optional<LogicalAliasMappingContext>, ReadonlySpan<PropertyID> properties_to_cascade) const;
     void compute_custom_properties(ComputedProperties&, DOM::AbstractElement) const;
     void start_needed_transitions(ComputedProperties const& old_style, ComputedProperties& new_style, DOM::AbstractElement) const;
@@ -197,6 +212,16 @@ private:
 
     OwnPtr<CountingBloomFilter<u8, 14>> m_ancestor_filter;
     OwnPtr<SelectorEngine::HasResultCache> m_has_result_cache;
+
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element const> element;
+        PseudoClassBitmap attempted_pseudo_class_matches;
+    };
+    static constexpr size_t max_style_sharing_candidates = 8;
+    bool m_style_sharing_enabled { false };
+    mutable Vector<StyleSharingCandidate, max_style_sharing_candidates> m_style_sharing_candidates;
+    mutable StyleSharingStatistics m_style_sharing_statistics;
+    StyleSharingStatistics m_total_style_sharing_statistics;
 };
 
 inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
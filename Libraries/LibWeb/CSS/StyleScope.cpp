@@ -42,8 +42,6 @@ void StyleScope::visit_edges(GC::Cell::Visitor& visitor)
         m_author_rule_cache->visit_edges(visitor);
     if (m_user_rule_cache)
         m_user_rule_cache->visit_edges(visitor);
-    if (m_user_agent_rule_cache)
-        m_user_agent_rule_cache->visit_edges(visitor);
 }
 
 void MatchingRule::visit_edges(GC::Cell::Visitor& visitor)
@@ -84,56 +82,170 @@ StyleScope::StyleScope(GC::Ref<DOM::Node> node)
     m_qualified_layer_names_in_order.append({});
 }
 
-void StyleScope::build_rule_cache()
+static void create_pseudo_class_rule_caches(PseudoClassRuleCaches& pseudo_class_rule_caches)
 {
-    m_author_rule_cache = make<RuleCaches>();
-    m_user_rule_cache = make<RuleCaches>();
-    m_user_agent_rule_cache = make<RuleCaches>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::Hover)] = make<RuleCache>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::Active)] = make<RuleCache>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::Focus)] = make<RuleCache>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::FocusWithin)] = make<RuleCache>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::FocusVisible)] = make<RuleCache>();
+    pseudo_class_rule_caches[to_underlying(PseudoClass::Target)] = make<RuleCache>();
+}
+
+static void add_rules_from_rule_cache(RuleCache& rule_cache, RuleCache const& other)
+{
+    auto add_rules_from_map = [](auto& map, auto const& other_map) {
+        for (auto const& [key, rules] : other_map)
+            map.ensure(key).extend(rules);
+    };
 
-    m_selector_insights = make<SelectorInsights>();
-    m_style_invalidation_data = make<StyleInvalidationData>();
+    add_rules_from_map(rule_cache.rules_by_id, other.rules_by_id);
+    add_rules_from_map(rule_cache.rules_by_class, other.rules_by_class);
+    add_rules_from_map(rule_cache.rules_by_tag_name, other.rules_by_tag_name);
+    add_rules_from_map(rule_cache.rules_by_attribute_name, other.rules_by_attribute_name);
+    for (size_t i = 0; i < rule_cache.rules_by_pseudo_element.size(); ++i)
+        rule_cache.rules_by_pseudo_element[i].extend(other.rules_by_pseudo_element[i]);
+    rule_cache.root_rules.extend(other.root_rules);
+    rule_cache.slotted_rules.extend(other.slotted_rules);
+    rule_cache.part_rules.extend(other.part_rules);
+    rule_cache.other_rules.extend(other.other_rules);
+}
 
-    if (auto user_style_source = document().page().user_style(); user_style_source.has_value()) {
-        m_user_style_sheet = GC::make_root(parse_css_stylesheet(CSS::Parser::ParsingParams(document()), user_style_source.value()));
+// Everything the rules of one cascade origin's style sheets get added to while building rule caches.
+struct RuleCacheTargets {
+    GC::Ptr<DOM::ShadowRoot const> scope_shadow_root;
+    CascadeOrigin cascade_origin;
+    RuleCaches& rule_caches;
+    PseudoClassRuleCaches& pseudo_class_rule_caches;
+    StyleInvalidationData& style_invalidation_data;
+    SelectorInsights& insights;
+};
+
+static void add_style_producing_rule_to_rule_cache_targets(CSSRule const& rule, CSSStyleSheet const& sheet, size_t style_sheet_index, size_t rule_index, RuleCacheTargets const& targets)
+{
+    SelectorList const& absolutized_selectors = [&]() {
+        if (rule.type() == CSSRule::Type::Style)
+            return static_cast<CSSStyleRule const&>(rule).absolutized_selectors();
+        if (rule.type() == CSSRule::Type::NestedDeclarations)
+            return static_cast<CSSNestedDeclarations const&>(rule).parent_style_rule().absolutized_selectors();
+        VERIFY_NOT_REACHED();
+    }();
+
+    for (auto const& selector : absolutized_selectors) {
+        targets.style_invalidation_data.build_invalidation_sets_for_selector(selector);
     }
 
-    build_qualified_layer_names_cache();
+    for (CSS::Selector const& selector : absolutized_selectors) {
+        selector.compile_if_possible();
+
+        MatchingRule matching_rule {
+            targets.scope_shadow_root,
+            &rule,
+            sheet,
+            sheet.default_namespace(),
+            selector,
+            style_sheet_index,
+            rule_index,
+            selector.specificity(),
+            targets.cascade_origin,
+            false,
+        };
+
+        auto const& qualified_layer_name = matching_rule.qualified_layer_name();
+        auto& rule_cache = qualified_layer_name.is_empty() ? targets.rule_caches.main : *targets.rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
+
+        bool contains_root_pseudo_class = false;
+        Optional<CSS::PseudoElement> pseudo_element;
+
+        StyleScope::collect_selector_insights(selector, targets.insights);
+
+        for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+            if (!matching_rule.contains_pseudo_element) {
+                if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
+                    matching_rule.contains_pseudo_element = true;
+                    // FIXME: This wrongly assumes there is only one pseudo-element per selector.
+                    pseudo_element = simple_selector.pseudo_element().type();
+                    matching_rule.slotted = pseudo_element == PseudoElement::Slotted;
+                    matching_rule.contains_part_pseudo_element = pseudo_element == PseudoElement::Part;
+                }
+            }
+            if (!contains_root_pseudo_class) {
+                if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
+                    && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
+                    contains_root_pseudo_class = true;
+                }
+            }
+        }
 
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Hover)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Active)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Focus)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusWithin)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusVisible)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Target)] = make<RuleCache>();
+        for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+            auto pseudo_class = static_cast<PseudoClass>(i);
+            // If we're not building a rule cache for this pseudo class, just ignore it.
+            if (!targets.pseudo_class_rule_caches[i])
+                continue;
+            if (selector.contains_pseudo_class(pseudo_class)) {
+                // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
+                targets.pseudo_class_rule_caches[i]->add_rule(matching_rule, {}, contains_root_pseudo_class);
+            }
+        }
 
-    make_rule_cache_for_cascade_origin(CascadeOrigin::Author, *m_selector_insights);
-    make_rule_cache_for_cascade_origin(CascadeOrigin::User, *m_selector_insights);
-    make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent, *m_selector_insights);
+        rule_cache.add_rule(matching_rule, pseudo_element, contains_root_pseudo_class);
+    }
 }
 
-void StyleScope::invalidate_rule_cache()
+static void add_style_sheet_to_rule_cache_targets(CSSStyleSheet const& sheet, size_t style_sheet_index, RuleCacheTargets const& targets)
 {
-    m_author_rule_cache = nullptr;
+    size_t rule_index = 0;
+    sheet.for_each_effective_style_producing_rule([&](auto const& rule) {
+        add_style_producing_rule_to_rule_cache_targets(rule, sheet, style_sheet_index, rule_index, targets);
+        ++rule_index;
+    });
 
-    // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
-    //       Currently we are re-parsing the user style sheet every time we build the caches,
-    //       as it may have changed.
-    m_user_rule_cache = nullptr;
-    m_user_style_sheet = nullptr;
+    // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
+    sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
+        auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
+        HashTable<PropertyID> animated_properties;
+
+        // Forwards pass, resolve all the user-specified keyframe properties.
+        for (auto const& keyframe_rule : *rule.css_rules()) {
+            auto const& keyframe = as<CSSKeyframeRule>(*keyframe_rule);
+            Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
+
+            auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
+            auto const& keyframe_style = *keyframe.style();
+            for (auto const& it : keyframe_style.properties()) {
+                if (it.property_id == PropertyID::AnimationComposition) {
+                    auto composition_str = it.value->to_string(SerializationMode::Normal);
+                    AnimationComposition composition = AnimationComposition::Replace;
+                    if (composition_str == "add"sv)
+                        composition = AnimationComposition::Add;
+                    else if (composition_str == "accumulate"sv)
+                        composition = AnimationComposition::Accumulate;
+                    resolved_keyframe.composite = Animations::css_animation_composition_to_bindings_composite_operation_or_auto(composition);
+                    continue;
+                }
+                if (!is_animatable_property(it.property_id))
+                    continue;
+
+                // Unresolved properties will be resolved in collect_animation_into()
+                StyleComputer::for_each_property_expanding_shorthands(it.property_id, it.value, [&](PropertyID shorthand_id, StyleValue const& shorthand_value) {
+                    animated_properties.set(shorthand_id);
+                    resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<StyleValue const> { shorthand_value });
+                });
+            }
 
-    // NOTE: It might not be necessary to throw away the UA rule cache.
-    //       If we are sure that it's safe, we could keep it as an optimization.
-    m_user_agent_rule_cache = nullptr;
+            keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
+        }
 
-    m_pseudo_class_rule_cache = {};
-    m_style_invalidation_data = nullptr;
-}
+        Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
 
-void StyleScope::build_rule_cache_if_needed() const
-{
-    if (has_valid_rule_cache())
-        return;
-    const_cast<StyleScope&>(*this).build_rule_cache();
+        if constexpr (LIBWEB_CSS_DEBUG) {
+            dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
+            for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
+                dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
+        }
+
+        targets.rule_caches.main.rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
+    });
 }
 
 static CSSStyleSheet& default_stylesheet()
@@ -176,15 +288,115 @@ static CSSStyleSheet& svg_stylesheet()
     return *sheet;
 }
 
+template<typename Callback>
+static void for_each_user_agent_stylesheet(bool in_quirks_mode, Callback callback)
+{
+    callback(default_stylesheet());
+    if (in_quirks_mode)
+        callback(quirks_mode_stylesheet());
+    callback(mathml_stylesheet());
+    callback(svg_stylesheet());
+}
+
+// The rule caches built from the user agent style sheets, which every style scope in the process shares.
+struct SharedUserAgentRuleCaches {
+    RuleCaches rule_caches;
+    PseudoClassRuleCaches pseudo_class_rule_caches;
+    StyleInvalidationData style_invalidation_data;
+    SelectorInsights insights;
+};
+
+// NOTE: The user agent style sheets are parsed once per process, and their @media rules are never evaluated against a
+//       particular document, so the only thing their rule caches depend on is whether the document is in quirks mode.
+//       Building them once instead of for every document and shadow root saves both time and memory.
+//       The caches don't have to be visited, as the style sheets and rules they point to are kept alive by the roots above.
+static SharedUserAgentRuleCaches const& shared_user_agent_rule_caches(bool in_quirks_mode)
+{
+    static OwnPtr<SharedUserAgentRuleCaches> no_quirks_rule_caches;
+    static OwnPtr<SharedUserAgentRuleCaches> quirks_rule_caches;
+
+    auto& shared_rule_caches = in_quirks_mode ? quirks_rule_caches : no_quirks_rule_caches;
+    if (shared_rule_caches)
+        return *shared_rule_caches;
+
+    shared_rule_caches = make<SharedUserAgentRuleCaches>();
+    create_pseudo_class_rule_caches(shared_rule_caches->pseudo_class_rule_caches);
+
+    RuleCacheTargets targets {
+        .scope_shadow_root = nullptr,
+        .cascade_origin = CascadeOrigin::UserAgent,
+        .rule_caches = shared_rule_caches->rule_caches,
+        .pseudo_class_rule_caches = shared_rule_caches->pseudo_class_rule_caches,
+        .style_invalidation_data = shared_rule_caches->style_invalidation_data,
+        .insights = shared_rule_caches->insights,
+    };
+    size_t style_sheet_index = 0;
+    for_each_user_agent_stylesheet(in_quirks_mode, [&](CSSStyleSheet const& sheet) {
+        add_style_sheet_to_rule_cache_targets(sheet, style_sheet_index++, targets);
+    });
+    return *shared_rule_caches;
+}
+
+void StyleScope::build_rule_cache()
+{
+    auto const& user_agent_rule_caches = shared_user_agent_rule_caches(document().in_quirks_mode());
+
+    m_author_rule_cache = make<RuleCaches>();
+    m_user_rule_cache = make<RuleCaches>();
+    m_user_agent_rule_cache = &user_agent_rule_caches.rule_caches;
+
+    // Start out with what the user agent rules contribute, so only the author and user rules have to be looked at.
+    m_selector_insights = make<SelectorInsights>(user_agent_rule_caches.insights);
+    m_style_invalidation_data = make<StyleInvalidationData>(user_agent_rule_caches.style_invalidation_data);
+
+    if (auto user_style_source = document().page().user_style(); user_style_source.has_value()) {
+        m_user_style_sheet = GC::make_root(parse_css_stylesheet(CSS::Parser::ParsingParams(document()), user_style_source.value()));
+    }
+
+    build_qualified_layer_names_cache();
+
+    create_pseudo_class_rule_caches(m_pseudo_class_rule_cache);
+    for (size_t i = 0; i < m_pseudo_class_rule_cache.size(); ++i) {
+        if (m_pseudo_class_rule_cache[i])
+            add_rules_from_rule_cache(*m_pseudo_class_rule_cache[i], *user_agent_rule_caches.pseudo_class_rule_caches[i]);
+    }
+
+    make_rule_cache_for_cascade_origin(CascadeOrigin::Author, *m_selector_insights);
+    make_rule_cache_for_cascade_origin(CascadeOrigin::User, *m_selector_insights);
+}
+
+void StyleScope::invalidate_rule_cache()
+{
+    m_author_rule_cache = nullptr;
+
+    // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
+    //       Currently we are re-parsing the user style sheet every time we build the caches,
+    //       as it may have changed.
+    m_user_rule_cache = nullptr;
+    m_user_style_sheet = nullptr;
+
+    // NOTE: The user agent rule cache is shared, so this only forgets about it until the next build.
+    m_user_agent_rule_cache = nullptr;
+
+    m_pseudo_class_rule_cache = {};
+    m_style_invalidation_data = nullptr;
+
+    // The style sheets may now contain media queries that were never evaluated.
+    document().set_needs_media_rule_evaluation();
+}
+
+void StyleScope::build_rule_cache_if_needed() const
+{
+    if (has_valid_rule_cache())
+        return;
+    const_cast<StyleScope&>(*this).build_rule_cache();
+}
+
 template<typename Callback>
 void StyleScope::for_each_stylesheet(CascadeOrigin cascade_origin, Callback callback) const
 {
     if (cascade_origin == CascadeOrigin::UserAgent) {
-        callback(default_stylesheet());
-        if (document().in_quirks_mode())
-            callback(quirks_mode_stylesheet());
-        callback(mathml_stylesheet());
-        callback(svg_stylesheet());
+        for_each_user_agent_stylesheet(document().in_quirks_mode(), callback);
     }
     if (cascade_origin == CascadeOrigin::User) {
         if (m_user_style_sheet)
@@ -195,146 +407,152 @@ void StyleScope::for_each_stylesheet(CascadeOrigin cascade_origin, Callback call
     }
 }
 
-void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, SelectorInsights& insights)
+static RuleCacheTargets rule_cache_targets_for_style_scope(StyleScope& style_scope, CascadeOrigin cascade_origin, RuleCaches& rule_caches, SelectorInsights& insights)
 {
     GC::Ptr<DOM::ShadowRoot const> scope_shadow_root;
-    if (m_node->is_shadow_root())
-        scope_shadow_root = as<DOM::ShadowRoot>(*m_node);
+    if (style_scope.node().is_shadow_root())
+        scope_shadow_root = as<DOM::ShadowRoot>(style_scope.node());
+
+    return {
+        .scope_shadow_root = scope_shadow_root,
+        .cascade_origin = cascade_origin,
+        .rule_caches = rule_caches,
+        .pseudo_class_rule_caches = style_scope.m_pseudo_class_rule_cache,
+        .style_invalidation_data = *style_scope.m_style_invalidation_data,
+        .insights = insights,
+    };
+}
+
+void StyleScope::add_style_producing_rule_to_rule_caches(CSSRule const& rule, CSSStyleSheet const& sheet, size_t style_sheet_index, size_t rule_index, CascadeOrigin cascade_origin, RuleCaches& rule_caches, SelectorInsights& insights)
+{
+    add_style_producing_rule_to_rule_cache_targets(rule, sheet, style_sheet_index, rule_index, rule_cache_targets_for_style_scope(*this, cascade_origin, rule_caches, insights));
+}
+
+void StyleScope::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, SelectorInsights& insights)
+{
+    // NOTE: The user agent rule cache is shared between all style scopes, see shared_user_agent_rule_caches().
+    VERIFY(cascade_origin != CascadeOrigin::UserAgent);
+    auto& rule_caches = cascade_origin == CascadeOrigin::Author ? *m_author_rule_cache : *m_user_rule_cache;
+    auto targets = rule_cache_targets_for_style_scope(*this, cascade_origin, rule_caches, insights);
 
-    Vector<MatchingRule> matching_rules;
     size_t style_sheet_index = 0;
     for_each_stylesheet(cascade_origin, [&](auto& sheet) {
-        auto& rule_caches = [&] -> RuleCaches& {
-            switch (cascade_origin) {
-            case CascadeOrigin::Author:
-                return *m_author_rule_cache;
-            case CascadeOrigin::User:
-                return *m_user_rule_cache;
-            case CascadeOrigin::UserAgent:
-                return *m_user_agent_rule_cache;
-            default:
-                VERIFY_NOT_REACHED();
-            }
-        }();
-
-        size_t rule_index = 0;
-        sheet.for_each_effective_style_producing_rule([&](auto const& rule) {
-            SelectorList const& absolutized_selectors = [&]() {
-                if (rule.type() == CSSRule::Type::Style)
-                    return static_cast<CSSStyleRule const&>(rule).absolutized_selectors();
-                if (rule.type() == CSSRule::Type::NestedDeclarations)
-                    return static_cast<CSSNestedDeclarations const&>(rule).parent_style_rule().absolutized_selectors();
-                VERIFY_NOT_REACHED();
-            }();
-
-            for (auto const& selector : absolutized_selectors) {
-                m_style_invalidation_data->build_invalidation_sets_for_selector(selector);
-            }
+        add_style_sheet_to_rule_cache_targets(sheet, style_sheet_index, targets);
+        ++style_sheet_index;
+    });
+}
 
-            for (CSS::Selector const& selector : absolutized_selectors) {
-                MatchingRule matching_rule {
-                    scope_shadow_root,
-                    &rule,
-                    sheet,
-                    sheet.default_namespace(),
-                    selector,
-                    style_sheet_index,
-                    rule_index,
-                    selector.specificity(),
-                    cascade_origin,
-                    false,
-                };
-
-                auto const& qualified_layer_name = matching_rule.qualified_layer_name();
-                auto& rule_cache = qualified_layer_name.is_empty() ? rule_caches.main : *rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
-
-                bool contains_root_pseudo_class = false;
-                Optional<CSS::PseudoElement> pseudo_element;
-
-                collect_selector_insights(selector, insights);
-
-                for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
-                    if (!matching_rule.contains_pseudo_element) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
-                            matching_rule.contains_pseudo_element = true;
-                            // FIXME: This wrongly assumes there is only one pseudo-element per selector.
-                            pseudo_element = simple_selector.pseudo_element().type();
-                            matching_rule.slotted = pseudo_element == PseudoElement::Slotted;
-                            matching_rule.contains_part_pseudo_element = pseudo_element == PseudoElement::Part;
-                        }
-                    }
-                    if (!contains_root_pseudo_class) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
-                            && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
-                            contains_root_pseudo_class = true;
-                        }
-                    }
-                }
+template<typename Callback>
+static void for_each_rule_list(RuleCache& rule_cache, Callback callback)
+{
+    auto for_each_in_map = [&](auto& map) {
+        for (auto& [_, rules] : map)
+            callback(rules);
+    };
 
-                for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
-                    auto pseudo_class = static_cast<PseudoClass>(i);
-                    // If we're not building a rule cache for this pseudo class, just ignore it.
-                    if (!m_pseudo_class_rule_cache[i])
-                        continue;
-                    if (selector.contains_pseudo_class(pseudo_class)) {
-                        // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
-                        m_pseudo_class_rule_cache[i]->add_rule(matching_rule, {}, contains_root_pseudo_class);
-                    }
-                }
+    for_each_in_map(rule_cache.rules_by_id);
+    for_each_in_map(rule_cache.rules_by_class);
+    for_each_in_map(rule_cache.rules_by_tag_name);
+    for_each_in_map(rule_cache.rules_by_attribute_name);
+    for (auto& rules : rule_cache.rules_by_pseudo_element)
+        callback(rules);
+    callback(rule_cache.root_rules);
+    callback(rule_cache.slotted_rules);
+    callback(rule_cache.part_rules);
+    callback(rule_cache.other_rules);
+}
 
-                rule_cache.add_rule(matching_rule, pseudo_element, contains_root_pseudo_class);
-            }
-            ++rule_index;
-        });
+template<typename Callback>
+void StyleScope::for_each_author_rule_list(Callback callback)
+{
+    for_each_rule_list(m_author_rule_cache->main, callback);
+    for (auto& [_, rule_cache] : m_author_rule_cache->by_layer)
+        for_each_rule_list(*rule_cache, callback);
+    for (auto& rule_cache : m_pseudo_class_rule_cache) {
+        if (rule_cache)
+            for_each_rule_list(*rule_cache, callback);
+    }
+}
 
-        // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
-        sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
-            auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
-            HashTable<PropertyID> animated_properties;
-
-            // Forwards pass, resolve all the user-specified keyframe properties.
-            for (auto const& keyframe_rule : *rule.css_rules()) {
-                auto const& keyframe = as<CSSKeyframeRule>(*keyframe_rule);
-                Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
-
-                auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
-                auto const& keyframe_style = *keyframe.style();
-                for (auto const& it : keyframe_style.properties()) {
-                    if (it.property_id == PropertyID::AnimationComposition) {
-                        auto composition_str = it.value->to_string(SerializationMode::Normal);
-                        AnimationComposition composition = AnimationComposition::Replace;
-                        if (composition_str == "add"sv)
-                            composition = AnimationComposition::Add;
-                        else if (composition_str == "accumulate"sv)
-                            composition = AnimationComposition::Accumulate;
-                        resolved_keyframe.composite = Animations::css_animation_composition_to_bindings_composite_operation_or_auto(composition);
-                        continue;
-                    }
-                    if (!is_animatable_property(it.property_id))
-                        continue;
-
-                    // Unresolved properties will be resolved in collect_animation_into()
-                    StyleComputer::for_each_property_expanding_shorthands(it.property_id, it.value, [&](PropertyID shorthand_id, StyleValue const& shorthand_value) {
-                        animated_properties.set(shorthand_id);
-                        resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<StyleValue const> { shorthand_value });
-                    });
-                }
+bool StyleScope::add_style_rule_to_rule_cache(CSSStyleSheet const& sheet, CSSStyleRule const& rule)
+{
+    if (!has_valid_rule_cache())
+        return true;
 
-                keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
-            }
+    // Nested rules each have their own position in the sheet, so just rebuild the cache for those.
+    if (rule.css_rules().length() != 0)
+        return false;
+
+    // The rule cache only knows about the rules of style sheets in this scope, not those of style sheets they import.
+    Optional<size_t> style_sheet_index;
+    size_t active_style_sheet_count = 0;
+    bool sheet_is_active_more_than_once = false;
+    for_each_active_css_style_sheet([&](CSSStyleSheet& active_sheet) {
+        if (&active_sheet == &sheet) {
+            sheet_is_active_more_than_once = style_sheet_index.has_value();
+            style_sheet_index = active_style_sheet_count;
+        }
+        ++active_style_sheet_count;
+    });
+    if (!style_sheet_index.has_value() || sheet_is_active_more_than_once)
+        return false;
+
+    Optional<size_t> rule_index;
+    size_t effective_rule_count = 0;
+    sheet.for_each_effective_style_producing_rule([&](CSSRule const& effective_rule) {
+        if (&effective_rule == &rule)
+            rule_index = effective_rule_count;
+        ++effective_rule_count;
+    });
 
-            Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
+    // If the rule isn't effective (because the sheet's media doesn't match), it doesn't belong in the cache.
+    if (!rule_index.has_value())
+        return true;
 
-            if constexpr (LIBWEB_CSS_DEBUG) {
-                dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
-                for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
-                    dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
-            }
+    // Make room for the new rule in the cascade order of its sheet.
+    for_each_author_rule_list([&](Vector<MatchingRule>& rules) {
+        for (auto& matching_rule : rules) {
+            if (matching_rule.sheet == &sheet && matching_rule.rule_index >= *rule_index)
+                ++matching_rule.rule_index;
+        }
+    });
 
-            rule_caches.main.rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
+    add_style_producing_rule_to_rule_caches(rule, sheet, *style_sheet_index, *rule_index, CascadeOrigin::Author, *m_author_rule_cache, *m_selector_insights);
+    return true;
+}
+
+bool StyleScope::remove_style_rule_from_rule_cache(CSSStyleRule const& rule)
+{
+    if (!has_valid_rule_cache())
+        return true;
+
+    if (rule.css_rules().length() != 0)
+        return false;
+
+    // NOTE: The invalidation sets and selector insights built for the rule are left in place. They only ever cause
+    //       more invalidation than necessary, until the next time the rule cache is rebuilt.
+    GC::Ptr<CSSStyleSheet const> sheet;
+    Optional<size_t> rule_index;
+    for_each_author_rule_list([&](Vector<MatchingRule>& rules) {
+        rules.remove_all_matching([&](MatchingRule const& matching_rule) {
+            if (matching_rule.rule != &rule)
+                return false;
+            sheet = matching_rule.sheet;
+            rule_index = matching_rule.rule_index;
+            return true;
         });
-        ++style_sheet_index;
     });
+
+    if (!rule_index.has_value())
+        return true;
+
+    for_each_author_rule_list([&](Vector<MatchingRule>& rules) {
+        for (auto& matching_rule : rules) {
+            if (matching_rule.sheet == sheet && matching_rule.rule_index > *rule_index)
+                --matching_rule.rule_index;
+        }
+    });
+    return true;
 }
 
 void StyleScope::collect_selector_insights(Selector const& selector, SelectorInsights& insights)
@@ -68,6 +68,8 @@ struct RuleCaches {
     void visit_edges(GC::Cell::Visitor&);
 };
 
+using PseudoClassRuleCaches = Array<OwnPtr<RuleCache>, to_underlying(PseudoClass::__Count)>;
+
 struct SelectorInsights {
     bool has_has_selectors { false };
 };
@@ -92,6 +94,13 @@ public:
     void for_each_stylesheet(CascadeOrigin, Callback) const;
 
     void make_rule_cache_for_cascade_origin(CascadeOrigin, SelectorInsights&);
+    void add_style_producing_rule_to_rule_caches(CSSRule const&, CSSStyleSheet const&, size_t style_sheet_index, size_t rule_index, CascadeOrigin, RuleCaches&, SelectorInsights&);
+
+    // Keep a built rule cache up to date when a single style rule is inserted into or removed from one of this scope's
+    // style sheets. These return false if that can't be done incrementally, in which case the rule cache has to be
+    // invalidated instead.
+    bool add_style_rule_to_rule_cache(CSSStyleSheet const&, CSSStyleRule const&);
+    bool remove_style_rule_from_rule_cache(CSSStyleRule const&);
 
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
@@ -111,13 +120,17 @@ public:
 
     void visit_edges(GC::Cell::Visitor&);
 
+    template<typename Callback>
+    void for_each_author_rule_list(Callback);
+
     Vector<FlyString> m_qualified_layer_names_in_order;
     OwnPtr<SelectorInsights> m_selector_insights;
-    Array<OwnPtr<RuleCache>, to_underlying(PseudoClass::__Count)> m_pseudo_class_rule_cache;
+    PseudoClassRuleCaches m_pseudo_class_rule_cache;
     OwnPtr<StyleInvalidationData> m_style_invalidation_data;
     OwnPtr<RuleCaches> m_author_rule_cache;
     OwnPtr<RuleCaches> m_user_rule_cache;
-    OwnPtr<RuleCaches> m_user_agent_rule_cache;
+    // Shared by all style scopes in the process, see build_rule_cache().
+    RuleCaches const* m_user_agent_rule_cache { nullptr };
 
     GC::Ptr<CSSStyleSheet> m_user_style_sheet;
 
@@ -8,6 +8,7 @@
  */
 
 #include "CalculatedStyleValue.h"
+#include <AK/AllOf.h>
 #include <AK/QuickSort.h>
 #include <AK/TypeCasts.h>
 #include <LibJS/Runtime/Realm.h>
@@ -2883,21 +2884,226 @@ bool CalculatedStyleValue::equals(StyleValue const& other) const
     return m_calculation->equals(*other.as_calculated().m_calculation);
 }
 
+namespace {
+
+struct FlatteningTerm {
+    double constant { 0 };
+    Optional<double> percentage {};
+    Vector<Length, 2> relative_lengths {};
+    bool is_number { true };
+
+    void add(FlatteningTerm const& other)
+    {
+        constant += other.constant;
+        if (other.percentage.has_value())
+            percentage = percentage.value_or(0) + *other.percentage;
+        for (auto const& length : other.relative_lengths)
+            add_relative_length(length);
+    }
+
+    void add_relative_length(Length const& length)
+    {
+        for (auto& existing_length : relative_lengths) {
+            if (existing_length.unit() == length.unit()) {
+                existing_length = Length { existing_length.raw_value() + length.raw_value(), length.unit() };
+                return;
+            }
+        }
+        relative_lengths.append(length);
+    }
+
+    void scale_by(double factor)
+    {
+        constant *= factor;
+        if (percentage.has_value())
+            *percentage *= factor;
+        for (auto& length : relative_lengths)
+            length = Length { length.raw_value() * factor, length.unit() };
+    }
+
+    bool is_finite() const
+    {
+        if (!isfinite(constant) || (percentage.has_value() && !isfinite(*percentage)))
+            return false;
+        return all_of(relative_lengths, [](auto const& length) { return isfinite(length.raw_value()); });
+    }
+};
+
+}
+
+// Flattens a calculation into a single term, if it only consists of sums, negations and products with numbers of
+// values that resolve to the given base type (or to numbers, if there is none).
+static Optional<FlatteningTerm> flatten_calculation_node(CalculationNode const& node, Optional<NumericType::BaseType> result_base_type, CalculationContext const& context)
+{
+    auto dimension_term = [&](NumericType::BaseType base_type, double value_in_canonical_unit) -> Optional<FlatteningTerm> {
+        if (result_base_type != base_type)
+            return {};
+        return FlatteningTerm { .constant = value_in_canonical_unit, .is_number = false };
+    };
+
+    switch (node.type()) {
+    case CalculationNode::Type::Numeric:
+        return as<NumericCalculationNode>(node).value().visit(
+            [](Number const& number) -> Optional<FlatteningTerm> {
+                return FlatteningTerm { .constant = number.value() };
+            },
+            [&](Percentage const& percentage) -> Optional<FlatteningTerm> {
+                if (!result_base_type.has_value() || !context.percentages_resolve_as.has_value()
+                    || NumericType::base_type_from_value_type(*context.percentages_resolve_as) != result_base_type)
+                    return {};
+                return FlatteningTerm { .percentage = percentage.value(), .is_number = false };
+            },
+            [&](Length const& length) -> Optional<FlatteningTerm> {
+                if (length.is_absolute())
+                    return dimension_term(NumericType::BaseType::Length, length.absolute_length_to_px_without_rounding());
+                if (result_base_type != NumericType::BaseType::Length)
+                    return {};
+                return FlatteningTerm { .relative_lengths = { length }, .is_number = false };
+            },
+            [&](Angle const& angle) { return dimension_term(NumericType::BaseType::Angle, angle.to_degrees()); },
+            [&](Flex const& flex) { return dimension_term(NumericType::BaseType::Flex, flex.to_fr()); },
+            [&](Frequency const& frequency) { return dimension_term(NumericType::BaseType::Frequency, frequency.to_hertz()); },
+            [&](Resolution const& resolution) { return dimension_term(NumericType::BaseType::Resolution, resolution.to_dots_per_pixel()); },
+            [&](Time const& time) { return dimension_term(NumericType::BaseType::Time, time.to_seconds()); });
+
+    case CalculationNode::Type::Sum: {
+        Optional<FlatteningTerm> result;
+        for (auto const& child : as<SumCalculationNode>(node).children()) {
+            auto term = flatten_calculation_node(child, result_base_type, context);
+            if (!term.has_value())
+                return {};
+            if (!result.has_value()) {
+                result = term.release_value();
+                continue;
+            }
+            if (result->is_number != term->is_number)
+                return {};
+            result->add(*term);
+        }
+        return result;
+    }
+
+    case CalculationNode::Type::Product: {
+        FlatteningTerm result { .constant = 1 };
+        for (auto const& child : as<ProductCalculationNode>(node).children()) {
+            auto term = flatten_calculation_node(child, result_base_type, context);
+            if (!term.has_value())
+                return {};
+            if (term->is_number) {
+                result.scale_by(term->constant);
+                continue;
+            }
+            // A product of two dimensions doesn't resolve to the same type as its factors.
+            if (!result.is_number)
+                return {};
+            term->scale_by(result.constant);
+            result = term.release_value();
+        }
+        return result;
+    }
+
+    case CalculationNode::Type::Negate: {
+        auto term = flatten_calculation_node(as<NegateCalculationNode>(node).child(), result_base_type, context);
+        if (term.has_value())
+            term->scale_by(-1);
+        return term;
+    }
+
+    case CalculationNode::Type::Invert: {
+        auto term = flatten_calculation_node(as<InvertCalculationNode>(node).child(), result_base_type, context);
+        if (!term.has_value() || !term->is_number)
+            return {};
+        term->constant = 1.0 / term->constant;
+        return term;
+    }
+
+    default:
+        return {};
+    }
+}
+
+Optional<CalculatedStyleValue::ResolvedValue> CalculatedStyleValue::resolve_flattened_value(FlattenedCalculation const& calculation, CalculationResolutionContext const& resolution_context) const
+{
+    auto value = calculation.constant;
+
+    if (calculation.percentage.has_value()) {
+        // NOTE: This has to resolve percentages the same way simplify_a_calculation_tree() does.
+        auto basis = resolution_context.percentage_basis.visit(
+            [](Empty const&) -> Optional<double> { return {}; },
+            [](Angle const& angle) -> Optional<double> { return angle.to_degrees(); },
+            [](Frequency const& frequency) -> Optional<double> { return frequency.to_hertz(); },
+            [&](Length const& length) -> Optional<double> {
+                if (length.unit() == LengthUnit::Px)
+                    return length.raw_value();
+                if (length.is_absolute())
+                    return length.absolute_length_to_px().to_double();
+                if (resolution_context.length_resolution_context.has_value())
+                    return length.to_px_without_rounding(resolution_context.length_resolution_context.value());
+                return {};
+            },
+            [](Time const& time) -> Optional<double> { return time.to_seconds(); });
+        if (!basis.has_value())
+            return {};
+        value += *basis * Percentage { *calculation.percentage }.as_fraction();
+    }
+
+    if (!calculation.relative_lengths.is_empty()) {
+        if (!resolution_context.length_resolution_context.has_value())
+            return {};
+        for (auto const& length : calculation.relative_lengths)
+            value += length.to_px_without_rounding(resolution_context.length_resolution_context.value());
+    }
+
+    return ResolvedValue { value, calculation.type };
+}
+
 // https://drafts.csswg.org/css-values-4/#calc-computed-value
 Optional<CalculatedStyleValue::ResolvedValue> CalculatedStyleValue::resolve_value(CalculationResolutionContext const& resolution_context) const
 {
-    // The calculation tree is again simplified at used value time; with used value time information.
-    // NOTE: Any nodes which rely on dynamic state should have been simplified away in absolutized so we can pass a nullptr here
-    auto simplified_tree = simplify_a_calculation_tree(m_calculation, m_context, resolution_context);
+    // OPTIMIZATION: Try to flatten the calculation once, so that we don't have to simplify the calculation tree on
+    //               every call. The result has to be the same as what simplifying the tree would produce.
+    if (!m_did_try_to_flatten_calculation) {
+        m_did_try_to_flatten_calculation = true;
 
-    if (!is<NumericCalculationNode>(*simplified_tree))
-        return {};
+        Optional<NumericType::BaseType> result_base_type;
+        bool can_flatten = true;
+        if (!m_resolved_type.matches_number(m_context.percentages_resolve_as)) {
+            result_base_type = m_resolved_type.entry_with_value_1_while_all_others_are_0();
+            can_flatten = result_base_type.has_value() && result_base_type != NumericType::BaseType::Percent;
+        }
 
-    auto value = try_get_value_with_canonical_unit(simplified_tree, m_context, resolution_context);
+        if (can_flatten) {
+            if (auto term = flatten_calculation_node(m_calculation, result_base_type, m_context); term.has_value() && term->is_finite()) {
+                m_flattened_calculation = FlattenedCalculation {
+                    .type = result_base_type.has_value() ? NumericType { *result_base_type, 1 } : NumericType {},
+                    .constant = term->constant,
+                    .percentage = term->percentage,
+                    .relative_lengths = move(term->relative_lengths),
+                };
+            }
+        }
+    }
+
+    Optional<ResolvedValue> value;
+    if (m_flattened_calculation.has_value())
+        value = resolve_flattened_value(*m_flattened_calculation, resolution_context);
+
+    if (!value.has_value()) {
+        // The calculation tree is again simplified at used value time; with used value time information.
+        // NOTE: Any nodes which rely on dynamic state should have been simplified away in absolutized so we can pass a nullptr here
+        auto simplified_tree = simplify_a_calculation_tree(m_calculation, m_context, resolution_context);
+
+        if (!is<NumericCalculationNode>(*simplified_tree))
+            return {};
+
+        auto result = try_get_value_with_canonical_unit(simplified_tree, m_context, resolution_context);
 
-    VERIFY(value.has_value());
+        VERIFY(result.has_value());
+
+        value = ResolvedValue { result->value(), result->type() };
+    }
 
-    auto raw_value = value->value();
+    auto raw_value = value->value;
 
     // https://drafts.csswg.org/css-values/#calc-ieee
     // NaN does not escape a top-level calculation; it’s censored into a zero value.
@@ -2910,32 +3116,32 @@ Optional<CalculatedStyleValue::ResolvedValue> CalculatedStyleValue::resolve_valu
     // unable to sufficiently simplify the expression to allow range-checking.
     Optional<AcceptedTypeRange> accepted_range;
 
-    if (value->type()->matches_number(m_context.percentages_resolve_as))
+    if (value->type->matches_number(m_context.percentages_resolve_as))
         accepted_range = m_context.resolve_numbers_as_integers ? m_context.accepted_type_ranges.get(ValueType::Integer) : m_context.accepted_type_ranges.get(ValueType::Number);
-    else if (value->type()->matches_angle(m_context.percentages_resolve_as))
+    else if (value->type->matches_angle(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Angle);
-    else if (value->type()->matches_flex(m_context.percentages_resolve_as))
+    else if (value->type->matches_flex(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Flex);
-    else if (value->type()->matches_frequency(m_context.percentages_resolve_as))
+    else if (value->type->matches_frequency(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Frequency);
-    else if (value->type()->matches_length(m_context.percentages_resolve_as))
+    else if (value->type->matches_length(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Length);
-    else if (value->type()->matches_percentage())
+    else if (value->type->matches_percentage())
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Percentage);
-    else if (value->type()->matches_resolution(m_context.percentages_resolve_as))
+    else if (value->type->matches_resolution(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Resolution);
-    else if (value->type()->matches_time(m_context.percentages_resolve_as))
+    else if (value->type->matches_time(m_context.percentages_resolve_as))
         accepted_range = m_context.accepted_type_ranges.get(ValueType::Time);
 
     if (!accepted_range.has_value()) {
-        dbgln_if(LIBWEB_CSS_DEBUG, "FIXME: Calculation context missing accepted type range {}", value->type());
+        dbgln_if(LIBWEB_CSS_DEBUG, "FIXME: Calculation context missing accepted type range {}", value->type);
         // FIXME: Infinity for integers should be i32 max rather than float max
         accepted_range = { AK::NumericLimits<float>::lowest(), AK::NumericLimits<float>::max() };
     }
 
     raw_value = clamp(raw_value, accepted_range->min, accepted_range->max);
 
-    return ResolvedValue { raw_value, value->type() };
+    return ResolvedValue { raw_value, value->type };
 }
 
 Optional<Angle> CalculatedStyleValue::resolve_angle(CalculationResolutionContext const& context) const
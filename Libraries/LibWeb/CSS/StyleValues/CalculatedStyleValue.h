@@ -133,11 +133,26 @@ private:
     //        StyleValue classes which lack their own absolutized method) which will need to be fixed beforehand.
     Optional<ResolvedValue> resolve_value(CalculationResolutionContext const&) const;
 
+    // A calculation that only adds and scales its values, flattened into `constant + percentage% + relative_lengths`
+    // with everything else converted to its canonical unit. This lets layout resolve common calculations like
+    // `calc(50% - 2em + 10px)` repeatedly without simplifying the whole calculation tree every time.
+    // FIXME: Also flatten min(), max() and clamp() of such terms.
+    struct FlattenedCalculation {
+        NumericType type;
+        double constant { 0 };
+        Optional<double> percentage;
+        Vector<Length, 2> relative_lengths;
+    };
+    Optional<ResolvedValue> resolve_flattened_value(FlattenedCalculation const&, CalculationResolutionContext const&) const;
+
     Optional<ValueType> percentage_resolved_type() const;
 
     NumericType m_resolved_type;
     NonnullRefPtr<CalculationNode const> m_calculation;
     CalculationContext m_context;
+
+    mutable bool m_did_try_to_flatten_calculation { false };
+    mutable Optional<FlattenedCalculation> m_flattened_calculation;
 };
 
 #define ENUMERATE_CALCULATION_NODE_TYPES(X) \
@@ -73,12 +73,14 @@
 #include <LibWeb/DOM/EditingHostManager.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/InputEventsTarget.h>
 #include <LibWeb/DOM/LiveNodeList.h>
 #include <LibWeb/DOM/NodeIterator.h>
+#include <LibWeb/DOM/ParsedSelectorCache.h>
 #include <LibWeb/DOM/Position.h>
 #include <LibWeb/DOM/ProcessingInstruction.h>
 #include <LibWeb/DOM/Range.h>
@@ -92,6 +94,8 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/AutocompleteElement.h>
+#include <LibWeb/HTML/BackForwardCache.h>
 #include <LibWeb/HTML/BeforeUnloadEvent.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
@@ -555,6 +559,8 @@ void Document::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     m_style_scope.visit_edges(visitor);
+    if (m_element_index)
+        m_element_index->visit_edges(visitor);
     visitor.visit(m_pending_css_import_rules);
     visitor.visit(m_page);
     visitor.visit(m_window);
@@ -609,6 +615,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
 
     visitor.visit(m_associated_animation_timelines);
     visitor.visit(m_list_of_available_images);
+    visitor.visit(m_map_of_preloaded_resources);
 
     for (auto* form_associated_element : m_form_associated_elements_with_form_attribute)
         visitor.visit(form_associated_element->form_associated_element_to_html_element());
@@ -1615,7 +1622,9 @@ void Document::update_style()
 
     build_registered_properties_cache();
 
+    style_computer().start_style_sharing();
     auto invalidation = update_style_recursively(*this, style_computer(), false, false);
+    style_computer().stop_style_sharing();
     if (!invalidation.is_none())
         invalidate_display_list();
 
@@ -1982,8 +1991,10 @@ GC::Ref<NodeList> Document::get_elements_by_name(FlyString const& name)
 // https://html.spec.whatwg.org/multipage/obsolete.html#dom-document-applets
 GC::Ref<HTMLCollection> Document::applets()
 {
-    if (!m_applets)
+    if (!m_applets) {
         m_applets = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](auto&) { return false; });
+        m_applets->set_dependencies(LiveCollectionDependencies::Structure);
+    }
     return *m_applets;
 }
 
@@ -2005,6 +2016,7 @@ GC::Ref<HTMLCollection> Document::images()
         m_images = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLImageElement>(element);
         });
+        m_images->set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_images;
 }
@@ -2016,6 +2028,7 @@ GC::Ref<HTMLCollection> Document::embeds()
         m_embeds = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLEmbedElement>(element);
         });
+        m_embeds->set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_embeds;
 }
@@ -2044,6 +2057,7 @@ GC::Ref<HTMLCollection> Document::forms()
         m_forms = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLFormElement>(element);
         });
+        m_forms->set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_forms;
 }
@@ -2055,6 +2069,7 @@ GC::Ref<HTMLCollection> Document::scripts()
         m_scripts = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLScriptElement>(element);
         });
+        m_scripts->set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_scripts;
 }
@@ -3360,6 +3375,17 @@ StringView Document::visibility_state() const
     VERIFY_NOT_REACHED();
 }
 
+void Document::update_hidden_since()
+{
+    if (hidden() == m_hidden_since.has_value())
+        return;
+    m_hidden_since = hidden() ? MonotonicTime::now() : Optional<MonotonicTime> {};
+
+    // Timers in hidden documents are throttled, so the ones that are waiting have to work out when to fire again.
+    if (m_window)
+        m_window->reschedule_timers();
+}
+
 // https://html.spec.whatwg.org/multipage/interaction.html#update-the-visibility-state
 void Document::update_the_visibility_state(HTML::VisibilityState visibility_state)
 {
@@ -3369,6 +3395,7 @@ void Document::update_the_visibility_state(HTML::VisibilityState visibility_stat
 
     // 2. Set document's visibility state to visibilityState.
     m_visibility_state = visibility_state;
+    update_hidden_since();
 
     // FIXME: 3. Queue a new VisibilityStateEntry whose visibility state is visibilityState and whose timestamp is the current
     //    high resolution time given document's relevant global object.
@@ -3450,6 +3477,12 @@ void Document::run_the_scroll_steps()
     m_pending_scroll_events.clear();
 }
 
+void Document::set_needs_media_query_evaluation(CSS::MediaFeatureDependencies changed_features)
+{
+    m_needs_media_query_evaluation = true;
+    m_changed_media_features |= changed_features;
+}
+
 void Document::add_media_query_list(GC::Ref<CSS::MediaQueryList> media_query_list)
 {
     m_needs_media_query_evaluation = true;
@@ -3501,25 +3534,42 @@ void Document::evaluate_media_queries_and_report_changes()
 
 void Document::evaluate_media_rules()
 {
+    // OPTIMIZATION: Only evaluate the media queries that can be affected by the media features that changed since the
+    //               last time, and don't even look at the style sheets if none of their media queries can be.
+    auto changed_features = exchange(m_changed_media_features, CSS::MediaFeatureDependencies::None);
+    if (m_needs_media_rule_evaluation) {
+        // NOTE: Style sheets (or their rules) may have been added, or the media queries of inactive ones may be out of
+        //       date, so evaluate everything.
+        m_needs_media_rule_evaluation = false;
+        changed_features = CSS::MediaFeatureDependencies::All;
+    } else if (!has_any_flag(m_media_rule_dependencies, changed_features)) {
+        return;
+    }
+
     bool any_media_queries_changed_match_state = false;
+    auto dependencies = CSS::MediaFeatureDependencies::None;
     style_scope().for_each_active_css_style_sheet([&](CSS::CSSStyleSheet& style_sheet) {
-        if (style_sheet.evaluate_media_queries(*this))
+        if (style_sheet.evaluate_media_queries(*this, changed_features, dependencies))
             any_media_queries_changed_match_state = true;
     });
 
     for_each_shadow_root([&](auto& shadow_root) {
         shadow_root.style_scope().for_each_active_css_style_sheet([&](CSS::CSSStyleSheet& style_sheet) {
-            if (style_sheet.evaluate_media_queries(*this))
+            if (style_sheet.evaluate_media_queries(*this, changed_features, dependencies))
                 any_media_queries_changed_match_state = true;
         });
     });
 
+    m_media_rule_dependencies = dependencies;
+
     if (any_media_queries_changed_match_state) {
         // FIXME: Make this more efficient
         style_scope().invalidate_rule_cache();
         for_each_shadow_root([&](auto& shadow_root) {
             shadow_root.style_scope().invalidate_rule_cache();
         });
+        // NOTE: All media queries were just evaluated, so invalidating the rule caches doesn't make them out of date.
+        m_needs_media_rule_evaluation = false;
 
         invalidate_style(StyleInvalidationReason::MediaQueryChangedMatchState);
     }
@@ -4178,10 +4228,12 @@ void Document::destroy()
 }
 
 // https://html.spec.whatwg.org/multipage/browsing-the-web.html#make-document-unsalvageable
-void Document::make_unsalvageable([[maybe_unused]] String reason)
+void Document::make_unsalvageable(String reason)
 {
-    // FIXME: 1. Let details be a new not restored reason details whose reason is reason.
-    // FIXME: 2. Append details to document's bfcache blocking details.
+    // 1. Let details be a new not restored reason details whose reason is reason.
+    // 2. Append details to document's bfcache blocking details.
+    if (!m_bfcache_blocking_details.contains_slow(reason))
+        m_bfcache_blocking_details.append(move(reason));
 
     // 3. Set document's salvageable state to false.
     set_salvageable(false);
@@ -4366,7 +4418,7 @@ void Document::set_browsing_context(GC::Ptr<HTML::BrowsingContext> browsing_cont
 }
 
 // https://html.spec.whatwg.org/multipage/document-lifecycle.html#unload-a-document
-void Document::unload(GC::Ptr<Document>)
+void Document::unload(GC::Ptr<Document>, KeepInBackForwardCache keep_in_back_forward_cache)
 {
     // FIXME: 1. Assert: this is running as part of a task queued on oldDocument's event loop.
 
@@ -4378,7 +4430,7 @@ void Document::unload(GC::Ptr<Document>)
     //           set unloadTimingInfo to null.
 
     // 5. Let intendToStoreInBfcache be true if the user agent intends to keep oldDocument alive in a session history entry, such that it can later be used for history traversal.
-    auto intend_to_store_in_bfcache = false;
+    auto intend_to_store_in_bfcache = keep_in_back_forward_cache == KeepInBackForwardCache::Yes;
 
     // 6. Let eventLoop be oldDocument's relevant agent's event loop.
     auto& event_loop = *HTML::relevant_agent(*this).event_loop;
@@ -4424,9 +4476,15 @@ void Document::unload(GC::Ptr<Document>)
     // 14. Decrease eventLoop's termination nesting level by 1.
     event_loop.decrement_termination_nesting_level();
 
-    // FIXME: 15. Set oldDocument's suspension time to the current high resolution time given document's relevant global object.
+    // 15. Set oldDocument's suspension time to the current high resolution time given document's relevant global object.
+    m_suspension_time = MonotonicTime::now();
 
-    // FIXME: 16. Set oldDocument's suspended timer handles to the result of getting the keys for the map of active timers.
+    // 16. Set oldDocument's suspended timer handles to the result of getting the keys for the map of active timers.
+    // NOTE: This also keeps the timers from firing until the document is reactivated.
+    m_suspended_timer_handles = as<HTML::Window>(relevant_global_object(*this)).suspend_timers();
+
+    if (auto navigable = this->navigable())
+        m_viewport_size_when_unloaded = navigable->viewport_size();
 
     // FIXME: 17. Set oldDocument's has been scrolled by the user to false.
 
@@ -4447,7 +4505,7 @@ void Document::unload(GC::Ptr<Document>)
 }
 
 // https://html.spec.whatwg.org/multipage/document-lifecycle.html#unload-a-document-and-its-descendants
-void Document::unload_a_document_and_its_descendants(GC::Ptr<Document> new_document, GC::Ptr<GC::Function<void()>> after_all_unloads)
+void Document::unload_a_document_and_its_descendants(GC::Ptr<Document> new_document, GC::Ptr<GC::Function<void()>> after_all_unloads, KeepInBackForwardCache keep_in_back_forward_cache)
 {
     // Specification defines this algorithm in the following steps:
     // 1. Recursively unload (and destroy) documents in descendant navigables
@@ -4470,11 +4528,23 @@ void Document::unload_a_document_and_its_descendants(GC::Ptr<Document> new_docum
     //
     // This way we maintain the invariant that all navigable containers present in the DOM tree
     // have an active document while the document is being unloaded.
+    //
+    // If the document is going to be kept in the back/forward cache, neither it nor its descendants are destroyed.
 
     IGNORE_USE_IN_ESCAPING_LAMBDA size_t number_unloaded = 0;
 
     auto navigable = this->navigable();
 
+    // NOTE: Only documents in top-level traversables are kept in the back/forward cache, along with all of their
+    //       descendants, so the decision is made once for the whole tree before anything is unloaded.
+    GC::Ptr<HTML::BackForwardCache> back_forward_cache;
+    if (keep_in_back_forward_cache == KeepInBackForwardCache::Yes && navigable->is_top_level_traversable()) {
+        auto& traversable = as<HTML::TraversableNavigable>(*navigable);
+        if (traversable.back_forward_cache().should_store(*this))
+            back_forward_cache = traversable.back_forward_cache();
+    }
+    keep_in_back_forward_cache = back_forward_cache ? KeepInBackForwardCache::Yes : KeepInBackForwardCache::No;
+
     Vector<GC::Root<HTML::Navigable>> descendant_navigables;
     for (auto& other_navigable : HTML::all_navigables()) {
         if (navigable->is_ancestor_of(*other_navigable))
@@ -4483,14 +4553,14 @@ void Document::unload_a_document_and_its_descendants(GC::Ptr<Document> new_docum
 
     IGNORE_USE_IN_ESCAPING_LAMBDA auto unloaded_documents_count = descendant_navigables.size() + 1;
 
-    HTML::queue_global_task(HTML::Task::Source::NavigationAndTraversal, HTML::relevant_global_object(*this), GC::create_function(heap(), [&number_unloaded, this, new_document] {
-        unload(new_document);
+    HTML::queue_global_task(HTML::Task::Source::NavigationAndTraversal, HTML::relevant_global_object(*this), GC::create_function(heap(), [&number_unloaded, this, new_document, keep_in_back_forward_cache] {
+        unload(new_document, keep_in_back_forward_cache);
         ++number_unloaded;
     }));
 
     for (auto& descendant_navigable : descendant_navigables) {
-        HTML::queue_global_task(HTML::Task::Source::NavigationAndTraversal, *descendant_navigable->active_window(), GC::create_function(heap(), [&number_unloaded, descendant_navigable = descendant_navigable.ptr()] {
-            descendant_navigable->active_document()->unload();
+        HTML::queue_global_task(HTML::Task::Source::NavigationAndTraversal, *descendant_navigable->active_window(), GC::create_function(heap(), [&number_unloaded, descendant_navigable = descendant_navigable.ptr(), keep_in_back_forward_cache] {
+            descendant_navigable->active_document()->unload({}, keep_in_back_forward_cache);
             ++number_unloaded;
         }));
     }
@@ -4499,6 +4569,23 @@ void Document::unload_a_document_and_its_descendants(GC::Ptr<Document> new_docum
         return number_unloaded == unloaded_documents_count;
     }));
 
+    // NOTE: A pagehide event handler may still have done something that makes one of the documents unsalvageable.
+    if (back_forward_cache && HTML::BackForwardCache::blocking_reasons(*this).is_empty()) {
+        back_forward_cache->store(*this);
+        if (after_all_unloads)
+            HTML::queue_global_task(HTML::Task::Source::NavigationAndTraversal, HTML::relevant_global_object(*this), *after_all_unloads);
+        return;
+    }
+
+    // NOTE: The documents were unloaded as if they were going to be kept, so make sure they aren't treated as such.
+    if (back_forward_cache) {
+        set_salvageable(false);
+        for (auto& descendant_navigable : descendant_navigables) {
+            if (auto document = descendant_navigable->active_document())
+                document->set_salvageable(false);
+        }
+    }
+
     destroy_a_document_and_its_descendants(move(after_all_unloads));
 }
 
@@ -4539,7 +4626,9 @@ bool Document::is_allowed_to_use_feature(PolicyControlledFeature feature) const
 
 void Document::did_stop_being_active_document_in_navigable()
 {
-    tear_down_layout_tree();
+    // NOTE: A document that is kept in the back/forward cache keeps its layout tree, so it can be shown again right away.
+    if (!m_salvageable)
+        tear_down_layout_tree();
 
     notify_each_document_observer([&](auto const& document_observer) {
         return document_observer.document_became_inactive();
@@ -4647,6 +4736,7 @@ void Document::make_active()
     // 3. Set document's visibility state to document's node navigable's traversable navigable's system visibility state.
     if (navigable()) {
         m_visibility_state = navigable()->traversable_navigable()->system_visibility_state();
+        update_hidden_since();
     }
 
     // TODO: 4. Queue a new VisibilityStateEntry whose visibility state is document's visibility state and whose timestamp is zero.
@@ -5319,9 +5409,101 @@ void Document::update_for_history_step_application(GC::Ref<HTML::SessionHistoryE
     // 9. Otherwise, if documentsEntryChanged is false and doNotReactivate is false, then:
     // NOTE: This is for bfcache restoration
     if (!documents_entry_changed && !do_not_reactivate) {
-        // FIXME: 1. Assert: entriesForNavigationAPI is given.
-        // FIXME: 2. Reactivate document given entry and entriesForNavigationAPI.
+        // 1. Assert: entriesForNavigationAPI is given.
+        VERIFY(entries_for_navigation_api.has_value());
+
+        // 2. Reactivate document given entry and entriesForNavigationAPI.
+        reactivate(entry, *entries_for_navigation_api);
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/browsing-the-web.html#reactivate-a-document
+void Document::reactivate(GC::Ref<HTML::SessionHistoryEntry> reactivated_entry, Vector<GC::Ref<HTML::SessionHistoryEntry>> const& entries_for_navigation_api)
+{
+    // 1. For each formControl of form controls in document with an autofill field name of "off", invoke the reset algorithm for formControl.
+    for_each_in_subtree_of_type<Element>([&](auto& element) {
+        if (auto* autocomplete_element = as_if<HTML::AutocompleteElement>(element); autocomplete_element && autocomplete_element->parse_autocomplete_attribute().field_name == "off"sv)
+            as<HTML::FormAssociatedElement>(element).reset_algorithm();
+        return TraversalDecision::Continue;
+    });
+
+    auto& window = as<HTML::Window>(HTML::relevant_global_object(*this));
+
+    auto resume_suspended_timers = [](Document& document) {
+        // 2. If document's suspended timer handles is not empty:
+        if (document.m_suspended_timer_handles.is_empty())
+            return;
+
+        // 1. Assert: document's suspension time is not zero.
+        VERIFY(document.m_suspension_time.has_value());
+
+        // 2. Let suspendDuration be the current high resolution time minus document's suspension time.
+        auto suspend_duration = MonotonicTime::now() - *document.m_suspension_time;
+
+        // 3. Let activeTimers be document's relevant global object's map of active timers.
+        // 4. For each handle in document's suspended timer handles, if activeTimers[handle] exists, then increase
+        //    activeTimers[handle] by suspendDuration.
+        as<HTML::Window>(HTML::relevant_global_object(document)).resume_timers(document.m_suspended_timer_handles, suspend_duration);
+
+        document.m_suspended_timer_handles.clear();
+        document.m_suspension_time = {};
+    };
+    resume_suspended_timers(*this);
+
+    // 3. Update the navigation API entries for reactivation given document's relevant global object's navigation API,
+    //    navigationAPIEntries, and reactivatedEntry.
+    window.navigation()->update_the_navigation_api_entries_for_reactivation(entries_for_navigation_api, reactivated_entry);
+
+    auto show_page = [](Document& document) {
+        // 4. If document's current document readiness is "complete", and document's page showing is false:
+        if (document.readiness() != HTML::DocumentReadyState::Complete || document.page_showing())
+            return;
+
+        // 1. Set document's page showing to true.
+        document.set_page_showing(true);
+
+        // FIXME: 2. Set document's has been revealed to false.
+
+        // 3. Update the visibility state of document to "visible".
+        // AD-HOC: Use the traversable's visibility state instead, so documents restored in a hidden tab stay hidden.
+        auto visibility_state = HTML::VisibilityState::Visible;
+        if (auto navigable = document.navigable())
+            visibility_state = navigable->traversable_navigable()->system_visibility_state();
+        document.update_the_visibility_state(visibility_state);
+
+        // 4. Fire a page transition event named pageshow at document's relevant global object with true.
+        as<HTML::Window>(HTML::relevant_global_object(document)).fire_a_page_transition_event(HTML::EventNames::pageshow, true);
+    };
+    show_page(*this);
+
+    // NOTE: Changes to the preferences, the device pixel ratio and so on only reach the active documents, so anything
+    //       could have changed while this document was in the back/forward cache. Evaluate all of its media rules and
+    //       queries again; the style is only invalidated if one of them now evaluates differently.
+    auto reevaluate_media = [](Document& document) {
+        document.set_needs_media_rule_evaluation();
+        document.set_needs_media_query_evaluation(CSS::MediaFeatureDependencies::All);
+    };
+    reevaluate_media(*this);
+
+    // AD-HOC: The documents in our child navigables were unloaded along with us, but nothing reactivates them, as their
+    //         session history entries don't change. Resume their timers and show them again as well.
+    for (auto& navigable : descendant_navigables()) {
+        if (auto document = navigable->active_document()) {
+            resume_suspended_timers(*document);
+            show_page(*document);
+            reevaluate_media(*document);
+        }
     }
+
+    // NOTE: The layout tree is kept while the document is in the back/forward cache, so it only needs to be updated if
+    //       the viewport was resized in the meantime.
+    if (auto navigable = this->navigable(); navigable && m_viewport_size_when_unloaded != navigable->viewport_size()) {
+        invalidate_style(StyleInvalidationReason::DocumentReactivated);
+        if (auto layout_node = this->layout_node())
+            layout_node->set_needs_layout_update(SetNeedsLayoutReason::DocumentReactivated);
+    }
+    m_viewport_size_when_unloaded = {};
+    set_needs_display();
 }
 
 HashMap<URL::URL, GC::Ptr<HTML::SharedResourceRequest>>& Document::shared_resource_requests()
@@ -6855,6 +7037,20 @@ ElementByIdMap& Document::element_by_id() const
     return *m_element_by_id;
 }
 
+ElementIndex& Document::element_index() const
+{
+    if (!m_element_index)
+        m_element_index = make<ElementIndex>(const_cast<Document&>(*this));
+    return *m_element_index;
+}
+
+ParsedSelectorCache& Document::parsed_selector_cache() const
+{
+    if (!m_parsed_selector_cache)
+        m_parsed_selector_cache = make<ParsedSelectorCache>();
+    return *m_parsed_selector_cache;
+}
+
 String Document::dump_display_list()
 {
     update_layout(UpdateLayoutReason::DumpDisplayList);
@@ -14,6 +14,7 @@
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
@@ -40,6 +41,7 @@
 #include <LibWeb/HTML/History.h>
 #include <LibWeb/HTML/NavigationType.h>
 #include <LibWeb/HTML/PaintConfig.h>
+#include <LibWeb/HTML/Preload.h>
 #include <LibWeb/HTML/SandboxingFlagSet.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/VisibilityState.h>
@@ -563,6 +565,9 @@ public:
     StringView visibility_state() const;
     HTML::VisibilityState visibility_state_value() const { return m_visibility_state; }
 
+    // When the document's visibility state last changed to "hidden", if it is hidden.
+    Optional<MonotonicTime> hidden_since() const { return m_hidden_since; }
+
     // https://html.spec.whatwg.org/multipage/interaction.html#update-the-visibility-state
     void update_the_visibility_state(HTML::VisibilityState);
 
@@ -570,7 +575,10 @@ public:
     void run_the_scroll_steps();
 
     void evaluate_media_queries_and_report_changes();
-    void set_needs_media_query_evaluation() { m_needs_media_query_evaluation = true; }
+    // Called whenever a media feature changes, with the ones that changed.
+    void set_needs_media_query_evaluation(CSS::MediaFeatureDependencies changed_features);
+    // Called whenever style sheets change, as they may contain media queries that weren't evaluated yet.
+    void set_needs_media_rule_evaluation() { m_needs_media_rule_evaluation = true; }
     void add_media_query_list(GC::Ref<CSS::MediaQueryList>);
 
     GC::Ref<CSS::VisualViewport> visual_viewport();
@@ -684,10 +692,19 @@ public:
     // https://html.spec.whatwg.org/multipage/document-lifecycle.html#abort-a-document-and-its-descendants
     void abort_a_document_and_its_descendants();
 
+    // Whether the document may be kept alive in its session history entry, i.e. in the back/forward cache, once unloaded.
+    enum class KeepInBackForwardCache : bool {
+        No,
+        Yes,
+    };
+
     // https://html.spec.whatwg.org/multipage/document-lifecycle.html#unload-a-document
-    void unload(GC::Ptr<Document> new_document = nullptr);
+    void unload(GC::Ptr<Document> new_document = nullptr, KeepInBackForwardCache = KeepInBackForwardCache::No);
     // https://html.spec.whatwg.org/multipage/document-lifecycle.html#unload-a-document-and-its-descendants
-    void unload_a_document_and_its_descendants(GC::Ptr<Document> new_document, GC::Ptr<GC::Function<void()>> after_all_unloads = {});
+    void unload_a_document_and_its_descendants(GC::Ptr<Document> new_document, GC::Ptr<GC::Function<void()>> after_all_unloads = {}, KeepInBackForwardCache = KeepInBackForwardCache::No);
+
+    // https://html.spec.whatwg.org/multipage/browsing-the-web.html#reactivate-a-document
+    void reactivate(GC::Ref<HTML::SessionHistoryEntry> reactivated_entry, Vector<GC::Ref<HTML::SessionHistoryEntry>> const& entries_for_navigation_api);
 
     // https://html.spec.whatwg.org/multipage/dom.html#active-parser
     GC::Ptr<HTML::HTMLParser> active_parser();
@@ -726,13 +743,19 @@ public:
 
     void make_active();
 
+    bool is_salvageable() const { return m_salvageable; }
     void set_salvageable(bool value) { m_salvageable = value; }
 
     void make_unsalvageable(String reason);
 
+    // https://html.spec.whatwg.org/multipage/browsing-the-web.html#bfcache-blocking-details
+    Vector<String> const& bfcache_blocking_details() const { return m_bfcache_blocking_details; }
+
     HTML::ListOfAvailableImages& list_of_available_images();
     HTML::ListOfAvailableImages const& list_of_available_images() const;
 
+    HashMap<HTML::PreloadKey, GC::Ref<HTML::PreloadEntry>>& map_of_preloaded_resources() { return m_map_of_preloaded_resources; }
+
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
 
@@ -957,6 +980,15 @@ public:
 
     ElementByIdMap& element_by_id() const;
 
+    ElementIndex& element_index() const;
+    ElementIndex* element_index_if_built() const { return m_element_index.ptr(); }
+
+    // Whether an ElementIndex has been built for this document or for any shadow root in it.
+    bool has_element_index() const { return m_has_element_index; }
+    void did_build_element_index(Badge<ElementIndex>) { m_has_element_index = true; }
+
+    ParsedSelectorCache& parsed_selector_cache() const;
+
     auto& script_blocking_style_sheet_set() { return m_script_blocking_style_sheet_set; }
     auto const& script_blocking_style_sheet_set() const { return m_script_blocking_style_sheet_set; }
 
@@ -993,6 +1025,8 @@ private:
 
     void invalidate_style_of_elements_affected_by_has();
 
+    void update_hidden_since();
+
     void tear_down_layout_tree();
 
     void update_active_element();
@@ -1042,6 +1076,9 @@ private:
     GC::Ptr<HTML::BrowsingContext> m_browsing_context;
     URL::URL m_url;
     mutable OwnPtr<ElementByIdMap> m_element_by_id;
+    mutable OwnPtr<ElementIndex> m_element_index;
+    bool m_has_element_index { false };
+    mutable OwnPtr<ParsedSelectorCache> m_parsed_selector_cache;
 
     GC::Ptr<HTML::Window> m_window;
 
@@ -1137,9 +1174,23 @@ private:
     // https://html.spec.whatwg.org/multipage/browsing-the-web.html#concept-document-salvageable
     bool m_salvageable { true };
 
+    // https://html.spec.whatwg.org/multipage/browsing-the-web.html#bfcache-blocking-details
+    // NOTE: We only keep the reasons, which is all the not restored reason details have for now.
+    Vector<String> m_bfcache_blocking_details;
+
     // https://html.spec.whatwg.org/multipage/document-lifecycle.html#page-showing
     bool m_page_showing { false };
 
+    // https://html.spec.whatwg.org/multipage/document-lifecycle.html#suspension-time
+    Optional<MonotonicTime> m_suspension_time;
+
+    // https://html.spec.whatwg.org/multipage/document-lifecycle.html#suspended-timer-handles
+    Vector<i32> m_suspended_timer_handles;
+
+    // The size of the viewport when the document was unloaded, so we know whether the layout tree it kept while in the
+    // back/forward cache is still good when it is reactivated.
+    Optional<CSSPixelSize> m_viewport_size_when_unloaded;
+
     // Used by run_the_resize_steps().
     Optional<Gfx::IntSize> m_last_viewport_size;
     struct VisualViewportState {
@@ -1160,6 +1211,13 @@ private:
     bool m_needs_media_query_evaluation { false };
     Vector<GC::Weak<CSS::MediaQueryList>> m_media_query_lists;
 
+    // Used by evaluate_media_rules().
+    bool m_needs_media_rule_evaluation { true };
+    // The media features that changed since media rules were last evaluated.
+    CSS::MediaFeatureDependencies m_changed_media_features {};
+    // The media features that any of the media rules depended on when they were last evaluated.
+    CSS::MediaFeatureDependencies m_media_rule_dependencies {};
+
     bool m_needs_full_style_update { false };
     bool m_needs_full_layout_tree_update { false };
 
@@ -1213,6 +1271,7 @@ private:
 
     // https://html.spec.whatwg.org/multipage/interaction.html#visibility-state
     HTML::VisibilityState m_visibility_state { HTML::VisibilityState::Hidden };
+    Optional<MonotonicTime> m_hidden_since { MonotonicTime::now_coarse() };
 
     // https://html.spec.whatwg.org/multipage/dom.html#load-timing-info
     DocumentLoadTimingInfo m_load_timing_info;
@@ -1230,6 +1289,9 @@ private:
     // https://html.spec.whatwg.org/multipage/images.html#list-of-available-images
     GC::Ptr<HTML::ListOfAvailableImages> m_list_of_available_images;
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    HashMap<HTML::PreloadKey, GC::Ref<HTML::PreloadEntry>> m_map_of_preloaded_resources;
+
     GC::Ptr<CSS::VisualViewport> m_visual_viewport;
 
     // NOTE: Not in the spec per se, but Document must be able to access all IntersectionObservers whose root is in the document.
@@ -40,8 +40,10 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ElementFactory.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
+#include <LibWeb/DOM/ParsedSelectorCache.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/DOM/Text.h>
 #include <LibWeb/Geometry/DOMRect.h>
@@ -131,6 +133,7 @@ void Element::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_class_list);
     visitor.visit(m_shadow_root);
     visitor.visit(m_part_list);
+    visitor.visit(m_element_index_scope);
     visitor.visit(m_custom_element_definition);
     visitor.visit(m_custom_state_set);
     visitor.visit(m_cascaded_properties);
@@ -816,6 +819,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     if (old_value != value) {
         invalidate_style_after_attribute_change(local_name, old_value, value);
+        did_change_subtree(local_name == HTML::AttributeNames::class_ ? SubtreeChange::ClassNames : SubtreeChange::Attributes);
         document().bump_dom_tree_version();
     }
 }
@@ -1147,15 +1151,17 @@ GC::Ptr<ShadowRoot> Element::shadow_root_for_bindings() const
 WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams(document()), selectors);
+    auto parsed_selector = document().parsed_selector_cache().get_or_parse(document(), selectors);
+    auto const& maybe_selectors = parsed_selector->selectors();
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(realm(), "Failed to parse selector"_utf16);
 
     // 3. If the result of match a selector against an element, using s, this, and scoping root this, returns success, then return true; otherwise, return false.
-    auto sel = maybe_selectors.value();
-    for (auto& s : sel) {
+    if (parsed_selector->shape() != ParsedSelector::Shape::Other)
+        return parsed_selector->matches_simple_selector(*this);
+    for (auto& s : maybe_selectors.value()) {
         SelectorEngine::MatchContext context;
         if (SelectorEngine::matches(s, *this, nullptr, context, {}, static_cast<ParentNode const*>(this)))
             return true;
@@ -1167,14 +1173,17 @@ WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 WebIDL::ExceptionOr<DOM::Element const*> Element::closest(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams(document()), selectors);
+    auto parsed_selector = document().parsed_selector_cache().get_or_parse(document(), selectors);
+    auto const& maybe_selectors = parsed_selector->selectors();
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(realm(), "Failed to parse selector"_utf16);
 
-    auto matches_selectors = [this](CSS::SelectorList const& selector_list, Element const* element) {
+    auto matches_selectors = [this, &parsed_selector](CSS::SelectorList const& selector_list, Element const* element) {
         // 4. For each element in elements, if match a selector against an element, using s, element, and scoping root this, returns success, return element.
+        if (parsed_selector->shape() != ParsedSelector::Shape::Other)
+            return parsed_selector->matches_simple_selector(*element);
         for (auto const& selector : selector_list) {
             SelectorEngine::MatchContext context;
             if (SelectorEngine::matches(selector, *element, nullptr, context, {}, this))
@@ -1183,7 +1192,7 @@ WebIDL::ExceptionOr<DOM::Element const*> Element::closest(StringView selectors)
         return false;
     };
 
-    auto const selector_list = maybe_selectors.release_value();
+    auto const& selector_list = maybe_selectors.value();
 
     // 3. Let elements be this’s inclusive ancestors that are elements, in reverse tree order.
     for (auto* element = this; element; element = element->parent_element()) {
@@ -1540,6 +1549,8 @@ void Element::inserted()
             document().element_with_name_was_added({}, *this);
     }
 
+    ElementIndex::element_inserted(*this);
+
     play_or_cancel_animations_after_display_property_change();
 }
 
@@ -1554,12 +1565,16 @@ void Element::removed_from(Node* old_parent, Node& old_root)
             document().element_with_name_was_removed({}, *this);
     }
 
+    ElementIndex::element_removed(*this);
+
     play_or_cancel_animations_after_display_property_change();
 }
 
 void Element::moved_from(GC::Ptr<Node> old_parent)
 {
     Base::moved_from(old_parent);
+
+    ElementIndex::element_moved(*this);
 }
 
 void Element::children_changed(ChildrenChangedMetadata const* metadata)
@@ -4045,16 +4060,15 @@ void Element::attribute_changed(FlyString const& local_name, Optional<String> co
         if (is_connected())
             document().element_name_changed({}, *this);
     } else if (local_name == HTML::AttributeNames::class_) {
-        if (value_or_empty.is_empty()) {
-            m_classes.clear();
-        } else {
+        auto old_classes = move(m_classes);
+        if (!value_or_empty.is_empty()) {
             auto new_classes = value_or_empty.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
-            m_classes.clear();
             m_classes.ensure_capacity(new_classes.size());
             for (auto& new_class : new_classes) {
                 m_classes.unchecked_append(FlyString::from_utf8(new_class).release_value_but_fixme_should_propagate_errors());
             }
         }
+        ElementIndex::element_class_names_changed(*this, old_classes);
         if (m_class_list)
             m_class_list->associated_attribute_changed(value_or_empty);
     } else if (local_name == HTML::AttributeNames::style) {
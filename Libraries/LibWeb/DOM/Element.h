@@ -437,6 +437,10 @@ public:
     Optional<FlyString> const& id() const { return m_id; }
     Optional<FlyString> const& name() const { return m_name; }
 
+    // The document or shadow root whose ElementIndex this element is in, if any.
+    GC::Ptr<ParentNode> element_index_scope() const { return m_element_index_scope; }
+    void set_element_index_scope(Badge<ElementIndex>, GC::Ptr<ParentNode> scope) { m_element_index_scope = scope; }
+
     virtual GC::Ptr<GC::Function<void()>> take_lazy_load_resumption_steps(Badge<DOM::Document>)
     {
         return nullptr;
@@ -617,6 +621,8 @@ private:
     Optional<FlyString> m_id;
     Optional<FlyString> m_name;
 
+    GC::Ptr<ParentNode> m_element_index_scope;
+
     // https://html.spec.whatwg.org/multipage/custom-elements.html#custom-element-reaction-queue
     // All elements have an associated custom element reaction queue, initially empty. Each item in the custom element reaction queue is of one of two types:
     // NOTE: See the structs at the top of this header.
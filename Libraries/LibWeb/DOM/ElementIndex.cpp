@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
+#include <LibWeb/DOM/ShadowRoot.h>
+
+namespace Web::DOM {
+
+ElementIndex* ElementIndex::for_tree_scope_of(ParentNode& node)
+{
+    if (!node.is_connected())
+        return nullptr;
+    auto& root = node.root();
+    if (root.is_document())
+        return &static_cast<Document&>(root).element_index();
+    if (root.is_shadow_root())
+        return &static_cast<ShadowRoot&>(root).element_index();
+    return nullptr;
+}
+
+ElementIndex* ElementIndex::index_of_scope(ParentNode& scope)
+{
+    if (scope.is_document())
+        return static_cast<Document&>(scope).element_index_if_built();
+    if (scope.is_shadow_root())
+        return static_cast<ShadowRoot&>(scope).element_index_if_built();
+    return nullptr;
+}
+
+ElementIndex::ElementIndex(ParentNode& scope)
+    : m_scope(scope)
+{
+    scope.document().did_build_element_index({});
+    scope.for_each_in_subtree_of_type<Element>([&](Element& element) {
+        add(element);
+        return TraversalDecision::Continue;
+    });
+}
+
+ReadonlySpan<GC::Ref<Element>> ElementIndex::elements(Key key, FlyString const& name)
+{
+    auto bucket = buckets(key).find(name);
+    if (bucket == buckets(key).end())
+        return {};
+    return bucket->value.elements_in_tree_order();
+}
+
+void ElementIndex::element_inserted(Element& element)
+{
+    if (!element.document().has_element_index())
+        return;
+    auto& root = element.root();
+    if (!root.is_document() && !root.is_shadow_root())
+        return;
+    auto& scope = static_cast<ParentNode&>(root);
+    if (element.element_index_scope() == &scope)
+        return;
+    if (auto* index = index_of_scope(scope)) {
+        element_removed(element);
+        index->add(element);
+    }
+}
+
+void ElementIndex::element_removed(Element& element)
+{
+    auto scope = element.element_index_scope();
+    if (!scope)
+        return;
+    // NOTE: Elements in shadow trees stay in their shadow root's index when the host is removed.
+    if (&element.root() == scope.ptr())
+        return;
+    if (auto* index = index_of_scope(*scope))
+        index->remove(element);
+    element.set_element_index_scope({}, nullptr);
+}
+
+void ElementIndex::element_moved(Element& element)
+{
+    // The element may now be in another tree scope, and its place in tree order changed either way, so take it out of
+    // the index it was in and add it again.
+    if (auto scope = element.element_index_scope()) {
+        if (auto* index = index_of_scope(*scope))
+            index->remove(element);
+        element.set_element_index_scope({}, nullptr);
+    }
+    element_inserted(element);
+}
+
+void ElementIndex::element_class_names_changed(Element& element, ReadonlySpan<FlyString> old_class_names)
+{
+    auto scope = element.element_index_scope();
+    if (!scope)
+        return;
+    auto* index = index_of_scope(*scope);
+    if (!index)
+        return;
+    for (auto const& class_name : old_class_names) {
+        if (!element.class_names().contains_slow(class_name))
+            index->remove_from_bucket(Key::ClassName, class_name, element);
+    }
+    for (auto const& class_name : element.class_names()) {
+        if (!old_class_names.contains_slow(class_name))
+            index->add_to_bucket(Key::ClassName, class_name, element);
+    }
+}
+
+void ElementIndex::did_change_document(Badge<ShadowRoot>)
+{
+    m_scope->document().did_build_element_index({});
+}
+
+void ElementIndex::add(Element& element)
+{
+    for (auto const& class_name : element.class_names())
+        add_to_bucket(Key::ClassName, class_name, element);
+    add_to_bucket(Key::LocalName, element.local_name(), element);
+    element.set_element_index_scope({}, m_scope);
+}
+
+void ElementIndex::remove(Element& element)
+{
+    for (auto const& class_name : element.class_names())
+        remove_from_bucket(Key::ClassName, class_name, element);
+    remove_from_bucket(Key::LocalName, element.local_name(), element);
+}
+
+void ElementIndex::add_to_bucket(Key key, FlyString const& name, Element& element)
+{
+    buckets(key).ensure(name).add(element);
+}
+
+void ElementIndex::remove_from_bucket(Key key, FlyString const& name, Element& element)
+{
+    auto& buckets = this->buckets(key);
+    auto it = buckets.find(name);
+    if (it == buckets.end())
+        return;
+    it->value.remove(element);
+    if (it->value.elements.is_empty())
+        buckets.remove(it);
+}
+
+// NOTE: This mirrors the layout of a HashTable bucket: its state and stored hash, followed by the value.
+template<typename T>
+struct HashTableBucketLayout {
+    u8 state;
+    u32 hash;
+    alignas(T) u8 storage[sizeof(T)];
+};
+
+size_t ElementIndex::memory_usage_in_bytes() const
+{
+    size_t bytes = 0;
+    auto add_buckets = [&](HashMap<FlyString, Bucket> const& buckets) {
+        // NOTE: The name and the bucket are stored next to each other, both aligned like a pointer.
+        bytes += buckets.capacity() * (sizeof(HashTableBucketLayout<FlyString>) + sizeof(Bucket));
+        for (auto const& it : buckets) {
+            bytes += it.value.elements.capacity() * sizeof(HashTableBucketLayout<GC::Ref<Element>>);
+            bytes += it.value.elements_in_tree_order_cache.capacity() * sizeof(GC::Ref<Element>);
+        }
+    };
+    add_buckets(m_elements_by_class_name);
+    add_buckets(m_elements_by_local_name);
+    return bytes;
+}
+
+void ElementIndex::visit_edges(GC::Cell::Visitor& visitor)
+{
+    visitor.visit(m_scope);
+    auto visit_buckets = [&](HashMap<FlyString, Bucket> const& buckets) {
+        for (auto const& it : buckets) {
+            for (auto const& element : it.value.elements)
+                visitor.visit(element);
+        }
+    };
+    visit_buckets(m_elements_by_class_name);
+    visit_buckets(m_elements_by_local_name);
+}
+
+void ElementIndex::Bucket::add(Element& element)
+{
+    if (elements.set(element) != HashSetResult::InsertedNewEntry)
+        return;
+
+    // OPTIMIZATION: Elements are mostly added in tree order, e.g. by the HTML parser, so they can usually just be appended.
+    if (state == State::UpToDate && (elements_in_tree_order_cache.is_empty() || elements_in_tree_order_cache.last()->is_before(element)))
+        elements_in_tree_order_cache.append(element);
+    else
+        state = State::NeedsSorting;
+}
+
+void ElementIndex::Bucket::remove(Element& element)
+{
+    if (!elements.remove(element))
+        return;
+
+    if (state == State::UpToDate && elements_in_tree_order_cache.last().ptr() == &element)
+        elements_in_tree_order_cache.take_last();
+    else if (state == State::UpToDate)
+        state = State::HasRemovedElements;
+}
+
+ReadonlySpan<GC::Ref<Element>> ElementIndex::Bucket::elements_in_tree_order()
+{
+    switch (state) {
+    case State::UpToDate:
+        break;
+    case State::HasRemovedElements:
+        elements_in_tree_order_cache.remove_all_matching([&](auto& element) {
+            return !elements.contains(element);
+        });
+        break;
+    case State::NeedsSorting:
+        elements_in_tree_order_cache.clear_with_capacity();
+        elements_in_tree_order_cache.ensure_capacity(elements.size());
+        for (auto& element : elements)
+            elements_in_tree_order_cache.unchecked_append(element);
+        quick_sort(elements_in_tree_order_cache, [](auto& a, auto& b) {
+            return a->is_before(*b);
+        });
+        break;
+    }
+    state = State::UpToDate;
+    return elements_in_tree_order_cache;
+}
+
+}
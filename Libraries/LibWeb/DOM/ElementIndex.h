@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Vector.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Maps class names and local names to the elements of a tree scope (a document or a shadow root) that have them, in
+// tree order. Elements in shadow trees inside the scope belong to the shadow root's index instead.
+//
+// An index is only built the first time something looks elements up in it, by walking the scope once. After that it is
+// kept up to date as elements are inserted, removed, moved and change their class attribute.
+class ElementIndex {
+public:
+    enum class Key : u8 {
+        ClassName,
+        LocalName,
+    };
+
+    // Returns the index of the tree scope that the given node is in, building it if needed. Returns null for nodes that
+    // are not in a connected document or shadow root, for which there is no index.
+    static ElementIndex* for_tree_scope_of(ParentNode&);
+
+    explicit ElementIndex(ParentNode& scope);
+
+    // The elements with the given class name (matched case-sensitively) or local name, in tree order.
+    ReadonlySpan<GC::Ref<Element>> elements(Key, FlyString const& name);
+
+    // Keep the indexes in the element's document up to date. These are no-ops until an index has been built.
+    static void element_inserted(Element&);
+    static void element_removed(Element&);
+    static void element_moved(Element&);
+    static void element_class_names_changed(Element&, ReadonlySpan<FlyString> old_class_names);
+
+    // The number of bytes allocated for the index, from the capacities of its hash tables and vectors. This does not
+    // include the scope pointer that every element carries whether or not an index is built.
+    size_t memory_usage_in_bytes() const;
+
+    // Called when the shadow root that owns this index is adopted into another document.
+    void did_change_document(Badge<ShadowRoot>);
+
+    void visit_edges(GC::Cell::Visitor&);
+
+private:
+    struct Bucket {
+        enum class State : u8 {
+            UpToDate,
+            HasRemovedElements,
+            NeedsSorting,
+        };
+
+        void add(Element&);
+        void remove(Element&);
+        ReadonlySpan<GC::Ref<Element>> elements_in_tree_order();
+
+        HashTable<GC::Ref<Element>> elements;
+        Vector<GC::Ref<Element>> elements_in_tree_order_cache;
+        State state { State::UpToDate };
+    };
+
+    static ElementIndex* index_of_scope(ParentNode&);
+
+    void add(Element&);
+    void remove(Element&);
+    void add_to_bucket(Key, FlyString const& name, Element&);
+    void remove_from_bucket(Key, FlyString const& name, Element&);
+
+    HashMap<FlyString, Bucket>& buckets(Key key) { return key == Key::ClassName ? m_elements_by_class_name : m_elements_by_local_name; }
+
+    GC::Ref<ParentNode> m_scope;
+    HashMap<FlyString, Bucket> m_elements_by_class_name;
+    HashMap<FlyString, Bucket> m_elements_by_local_name;
+};
+
+}
@@ -49,14 +49,19 @@ void HTMLCollection::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_root);
+    visitor.visit(m_cursor_element);
 }
 
 void HTMLCollection::update_name_to_element_mappings_if_needed() const
 {
     update_cache_if_needed();
-    if (m_cached_name_to_element_mappings)
+    // NOTE: The names come from the id and name attributes, so they have to be looked at again when any attribute
+    //       changes, even if the filter doesn't care about that.
+    auto subtree_version = m_root->subtree_version(LiveCollectionDependencies::StructureAndAttributes);
+    if (m_cached_name_to_element_mappings && m_cached_name_to_element_mappings_subtree_version == subtree_version)
         return;
     m_cached_name_to_element_mappings = make<OrderedHashMap<FlyString, GC::Weak<Element>>>();
+    m_cached_name_to_element_mappings_subtree_version = subtree_version;
     for (auto const& element : m_cached_elements) {
         // 1. If element has an ID which is not in result, append element’s ID to result.
         if (auto const& id = element->id(); id.has_value()) {
@@ -73,15 +78,31 @@ void HTMLCollection::update_name_to_element_mappings_if_needed() const
     }
 }
 
+bool HTMLCollection::is_cache_up_to_date() const
+{
+    return m_cached_subtree_version == m_root->subtree_version(m_dependencies);
+}
+
 void HTMLCollection::update_cache_if_needed() const
 {
-    // Nothing to do, the DOM hasn't updated since we last built the cache.
-    if (m_cached_dom_tree_version == root()->document().dom_tree_version())
+    // Nothing to do, nothing that our filter cares about has changed in our subtree since we last built the cache.
+    if (is_cache_up_to_date())
         return;
 
     m_cached_elements.clear();
     m_cached_name_to_element_mappings = nullptr;
-    if (m_scope == Scope::Descendants) {
+    auto* element_index = m_scope == Scope::Descendants && m_element_index_key.has_value()
+        ? ElementIndex::for_tree_scope_of(*m_root)
+        : nullptr;
+    if (element_index) {
+        // OPTIMIZATION: Only the elements with the right class name or local name can match, so there's no need to walk
+        //               the whole subtree to find them.
+        bool root_is_tree_scope = &m_root->root() == m_root.ptr();
+        for (auto element : element_index->elements(*m_element_index_key, m_element_index_name)) {
+            if ((root_is_tree_scope || m_root->is_ancestor_of(*element)) && m_filter(*element))
+                m_cached_elements.append(element);
+        }
+    } else if (m_scope == Scope::Descendants) {
         m_root->for_each_in_subtree_of_type<Element>([&](auto& element) {
             if (m_filter(element))
                 m_cached_elements.append(element);
@@ -101,7 +122,52 @@ void HTMLCollection::update_cache_if_needed() const
         });
     }
 
-    m_cached_dom_tree_version = root()->document().dom_tree_version();
+    m_cached_subtree_version = m_root->subtree_version(m_dependencies);
+}
+
+Element* HTMLCollection::next_matching_element(Element* element) const
+{
+    if (m_scope == Scope::Descendants) {
+        for (auto* node = element ? element->next_in_pre_order(m_root.ptr()) : m_root->first_child(); node; node = node->next_in_pre_order(m_root.ptr())) {
+            if (auto* candidate = as_if<Element>(*node); candidate && m_filter(*candidate))
+                return candidate;
+        }
+        return nullptr;
+    }
+
+    for (auto* candidate = element ? element->next_element_sibling() : m_root->first_child_of_type<Element>(); candidate; candidate = candidate->next_element_sibling()) {
+        if (m_filter(*candidate))
+            return candidate;
+    }
+    return nullptr;
+}
+
+// OPTIMIZATION: When the cache is out of date, scripts that look at the elements one after the other (or only at the
+//               first few) would build it again for every change they make. Instead, continue from the element they
+//               looked at last.
+Element* HTMLCollection::item_using_cursor(size_t index) const
+{
+    auto subtree_version = m_root->subtree_version(m_dependencies);
+    if (m_cursor_subtree_version != subtree_version || !m_cursor_element || index < m_cursor_index) {
+        m_cursor_element = next_matching_element(nullptr);
+        m_cursor_index = 0;
+        m_cursor_subtree_version = subtree_version;
+    }
+
+    while (m_cursor_element && m_cursor_index < index) {
+        auto* next_element = next_matching_element(m_cursor_element);
+        if (!next_element)
+            return nullptr;
+        m_cursor_element = next_element;
+        ++m_cursor_index;
+    }
+    return m_cursor_element;
+}
+
+void HTMLCollection::set_element_index_key(ElementIndex::Key key, FlyString name)
+{
+    m_element_index_key = key;
+    m_element_index_name = move(name);
 }
 
 GC::RootVector<GC::Ref<Element>> HTMLCollection::collect_matching_elements() const
@@ -125,6 +191,9 @@ size_t HTMLCollection::length() const
 Element* HTMLCollection::item(size_t index) const
 {
     // The item(index) method steps are to return the indexth element in the collection. If there is no indexth element in the collection, then the method must return null.
+    if (!is_cache_up_to_date() && !m_sort && !m_element_index_key.has_value())
+        return item_using_cursor(index);
+
     update_cache_if_needed();
     if (index >= m_cached_elements.size())
         return nullptr;
@@ -10,6 +10,8 @@
 #include <AK/Function.h>
 #include <LibGC/Ptr.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/DOM/ElementIndex.h>
+#include <LibWeb/DOM/Node.h>
 #include <LibWeb/Forward.h>
 
 namespace Web::DOM {
@@ -40,6 +42,13 @@ public:
 
     GC::RootVector<GC::Ref<Element>> collect_matching_elements() const;
 
+    // Tells the collection that every element its filter matches has the given class name (matched case-sensitively)
+    // or local name. The collection then only looks at those elements, using the tree scope's ElementIndex.
+    void set_element_index_key(ElementIndex::Key, FlyString name);
+
+    // Tells the collection which changes in its subtree its filter cares about. By default that is any change.
+    void set_dependencies(LiveCollectionDependencies dependencies) { m_dependencies = dependencies; }
+
     virtual Optional<JS::Value> item_value(size_t index) const override;
     virtual JS::Value named_item_value(FlyString const& name) const override;
     virtual Vector<FlyString> supported_property_names() const override;
@@ -56,18 +65,33 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
+    bool is_cache_up_to_date() const;
     void update_cache_if_needed() const;
     void update_name_to_element_mappings_if_needed() const;
 
-    mutable u64 m_cached_dom_tree_version { 0 };
+    Element* next_matching_element(Element* element) const;
+    Element* item_using_cursor(size_t index) const;
+
+    mutable Optional<u64> m_cached_subtree_version;
     mutable Vector<GC::Weak<Element>> m_cached_elements;
+    mutable Optional<u64> m_cached_name_to_element_mappings_subtree_version;
     mutable OwnPtr<OrderedHashMap<FlyString, GC::Weak<Element>>> m_cached_name_to_element_mappings;
 
+    // The last element that item() returned without building the cache, so that looking at the elements one after the
+    // other doesn't have to start from the beginning every time.
+    mutable GC::Ptr<Element> m_cursor_element;
+    mutable size_t m_cursor_index { 0 };
+    mutable Optional<u64> m_cursor_subtree_version;
+
     GC::Ref<ParentNode> m_root;
     Function<bool(Element const&)> m_filter;
     Function<bool(Element const&, Element const&)> m_sort;
 
+    Optional<ElementIndex::Key> m_element_index_key;
+    FlyString m_element_index_name;
+
     Scope m_scope { Scope::Descendants };
+    LiveCollectionDependencies m_dependencies { LiveCollectionDependencies::StructureAndAttributes };
 };
 
 }
@@ -33,25 +33,70 @@ void LiveNodeList::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_root);
+    visitor.visit(m_cursor_node);
 }
 
-GC::RootVector<Node*> LiveNodeList::collection() const
+void LiveNodeList::update_cache_if_needed() const
 {
-    GC::RootVector<Node*> nodes(heap());
+    // Nothing to do, nothing that our filter cares about has changed in our subtree since we last built the cache.
+    auto subtree_version = m_root->subtree_version(m_dependencies);
+    if (m_cached_subtree_version == subtree_version)
+        return;
+
+    m_cached_nodes.clear();
     if (m_scope == Scope::Descendants) {
         m_root->for_each_in_subtree([&](auto& node) {
             if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
+                m_cached_nodes.append(node);
             return TraversalDecision::Continue;
         });
     } else {
         m_root->for_each_child([&](auto& node) {
             if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
+                m_cached_nodes.append(node);
             return IterationDecision::Continue;
         });
     }
-    return nodes;
+    m_cached_subtree_version = subtree_version;
+}
+
+Node* LiveNodeList::next_matching_node(Node* node) const
+{
+    auto& root = const_cast<Node&>(*m_root);
+    if (m_scope == Scope::Descendants) {
+        for (auto* candidate = node ? node->next_in_pre_order(&root) : root.first_child(); candidate; candidate = candidate->next_in_pre_order(&root)) {
+            if (m_filter(*candidate))
+                return candidate;
+        }
+        return nullptr;
+    }
+
+    for (auto* candidate = node ? node->next_sibling() : root.first_child(); candidate; candidate = candidate->next_sibling()) {
+        if (m_filter(*candidate))
+            return candidate;
+    }
+    return nullptr;
+}
+
+// OPTIMIZATION: Like HTMLCollection::item_using_cursor(), this lets scripts walk the list while changing the subtree
+//               without building the cache again for every change they make.
+Node* LiveNodeList::item_using_cursor(size_t index) const
+{
+    auto subtree_version = m_root->subtree_version(m_dependencies);
+    if (m_cursor_subtree_version != subtree_version || !m_cursor_node || index < m_cursor_index) {
+        m_cursor_node = next_matching_node(nullptr);
+        m_cursor_index = 0;
+        m_cursor_subtree_version = subtree_version;
+    }
+
+    while (m_cursor_node && m_cursor_index < index) {
+        auto* next_node = next_matching_node(m_cursor_node);
+        if (!next_node)
+            return nullptr;
+        m_cursor_node = next_node;
+        ++m_cursor_index;
+    }
+    return m_cursor_node;
 }
 
 Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) const
@@ -80,17 +125,20 @@ Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) co
 // https://dom.spec.whatwg.org/#dom-nodelist-length
 u32 LiveNodeList::length() const
 {
-    return collection().size();
+    update_cache_if_needed();
+    return m_cached_nodes.size();
 }
 
 // https://dom.spec.whatwg.org/#dom-nodelist-item
 Node const* LiveNodeList::item(u32 index) const
 {
     // The item(index) method must return the indexth node in the collection. If there is no indexth node in the collection, then the method must return null.
-    auto nodes = collection();
-    if (index >= nodes.size())
+    if (m_cached_subtree_version != m_root->subtree_version(m_dependencies))
+        return item_using_cursor(index);
+
+    if (index >= m_cached_nodes.size())
         return nullptr;
-    return nodes[index];
+    return m_cached_nodes[index].ptr();
 }
 
 }
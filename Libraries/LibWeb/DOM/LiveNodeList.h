@@ -8,12 +8,11 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <LibWeb/DOM/Node.h>
 #include <LibWeb/DOM/NodeList.h>
 
 namespace Web::DOM {
 
-// FIXME: Just like HTMLCollection, LiveNodeList currently does no caching.
-
 class LiveNodeList : public NodeList {
     WEB_PLATFORM_OBJECT(LiveNodeList, NodeList);
     GC_DECLARE_ALLOCATOR(LiveNodeList);
@@ -27,6 +26,9 @@ public:
     [[nodiscard]] static GC::Ref<NodeList> create(JS::Realm&, Node const& root, Scope, ESCAPING Function<bool(Node const&)> filter);
     virtual ~LiveNodeList() override;
 
+    // Tells the list which changes in its subtree its filter cares about. By default that is any change.
+    void set_dependencies(LiveCollectionDependencies dependencies) { m_dependencies = dependencies; }
+
     virtual u32 length() const override;
     virtual Node const* item(u32 index) const override;
 
@@ -38,11 +40,24 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
-    GC::RootVector<Node*> collection() const;
+    void update_cache_if_needed() const;
+
+    Node* next_matching_node(Node* node) const;
+    Node* item_using_cursor(size_t index) const;
+
+    mutable Optional<u64> m_cached_subtree_version;
+    mutable Vector<GC::Weak<Node>> m_cached_nodes;
+
+    // The last node that item() returned without building the cache, so that looking at the nodes one after the other
+    // doesn't have to start from the beginning every time.
+    mutable GC::Ptr<Node> m_cursor_node;
+    mutable size_t m_cursor_index { 0 };
+    mutable Optional<u64> m_cursor_subtree_version;
 
     GC::Ref<Node const> m_root;
     Function<bool(Node const&)> m_filter;
     Scope m_scope { Scope::Descendants };
+    LiveCollectionDependencies m_dependencies { LiveCollectionDependencies::StructureAndAttributes };
 };
 
 }
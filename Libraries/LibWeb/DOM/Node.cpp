@@ -608,6 +608,42 @@ bool Node::is_connected() const
     return shadow_including_root().is_document();
 }
 
+static u64 s_next_subtree_version = 1;
+
+u64 Node::subtree_version(LiveCollectionDependencies dependencies) const
+{
+    // NOTE: Every change gets a version that is larger than all the ones before it, so the largest of the versions we
+    //       depend on changes whenever any of them does.
+    switch (dependencies) {
+    case LiveCollectionDependencies::Structure:
+        return m_subtree_structure_version;
+    case LiveCollectionDependencies::StructureAndClassNames:
+        return max(m_subtree_structure_version, m_subtree_class_names_version);
+    case LiveCollectionDependencies::StructureAndAttributes:
+        return max(m_subtree_structure_version, m_subtree_attributes_version);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Node::did_change_subtree(SubtreeChange change)
+{
+    auto version = s_next_subtree_version++;
+    for (auto* node = this; node; node = node->parent()) {
+        switch (change) {
+        case SubtreeChange::Structure:
+            node->m_subtree_structure_version = version;
+            break;
+        case SubtreeChange::ClassNames:
+            node->m_subtree_class_names_version = version;
+            node->m_subtree_attributes_version = version;
+            break;
+        case SubtreeChange::Attributes:
+            node->m_subtree_attributes_version = version;
+            break;
+        }
+    }
+}
+
 // https://html.spec.whatwg.org/multipage/infrastructure.html#browsing-context-connected
 bool Node::is_browsing_context_connected() const
 {
@@ -829,6 +865,7 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
     //       an ordinal value (default from constructor).
     // FIXME: This will not work if the child or the parent is not an element. Is insert_before even possible in this situation?
 
+    did_change_subtree(SubtreeChange::Structure);
     document().bump_dom_tree_version();
 }
 
@@ -1049,6 +1086,7 @@ void Node::remove(bool suppress_observers)
     // 17. Run the children changed steps for parent.
     parent->children_changed(nullptr);
 
+    parent->did_change_subtree(SubtreeChange::Structure);
     document().bump_dom_tree_version();
 }
 
@@ -1382,6 +1420,8 @@ WebIDL::ExceptionOr<void> Node::move_node(Node& new_parent, Node* child)
     // 26. Queue a tree mutation record for newParent with « node », « », newPreviousSibling, and child.
     new_parent.queue_tree_mutation_record({ *this }, {}, new_previous_sibling, child);
 
+    old_parent->did_change_subtree(SubtreeChange::Structure);
+    new_parent.did_change_subtree(SubtreeChange::Structure);
     document().bump_dom_tree_version();
 
     return {};
@@ -1797,6 +1837,7 @@ GC::Ref<NodeList> Node::child_nodes()
         m_child_nodes = LiveNodeList::create(realm(), *this, LiveNodeList::Scope::Children, [](auto&) {
             return true;
         });
+        static_cast<LiveNodeList&>(*m_child_nodes).set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_child_nodes;
 }
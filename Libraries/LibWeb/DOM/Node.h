@@ -61,6 +61,7 @@ enum class ShouldComputeRole {
     X(CustomElementStateChange)                     \
     X(CustomStateSetChange)                         \
     X(DidLoseFocus)                                 \
+    X(DocumentReactivated)                          \
     X(DidReceiveFocus)                              \
     X(EditingInsertion)                             \
     X(EditingDeletion)                              \
@@ -98,6 +99,7 @@ enum class StyleInvalidationReason {
 
 #define ENUMERATE_SET_NEEDS_LAYOUT_REASONS(X)         \
     X(CharacterDataReplaceData)                       \
+    X(DocumentReactivated)                            \
     X(FinalizeACrossDocumentNavigation)               \
     X(GeneratedContentImageFinishedLoading)           \
     X(HTMLCanvasElementWidthOrHeightChange)           \
@@ -143,6 +145,22 @@ enum class SetNeedsLayoutTreeUpdateReason {
 
 [[nodiscard]] StringView to_string(SetNeedsLayoutTreeUpdateReason);
 
+// Which changes in its subtree make a live collection (like HTMLCollection or LiveNodeList) look at the subtree again.
+enum class LiveCollectionDependencies : u8 {
+    Structure,
+    StructureAndClassNames,
+    StructureAndAttributes,
+};
+
+enum class SubtreeChange : u8 {
+    // Nodes were inserted, removed or moved.
+    Structure,
+    // An element's class attribute changed.
+    ClassNames,
+    // Any other attribute, or state that live collections can filter on, changed.
+    Attributes,
+};
+
 class WEB_API Node : public EventTarget
     , public TreeNode<Node> {
     WEB_PLATFORM_OBJECT(Node, EventTarget);
@@ -345,6 +363,11 @@ public:
     virtual void children_changed(ChildrenChangedMetadata const*) { }
 
     virtual void adopted_from(Document&) { }
+
+    // AD-HOC: Like Document::dom_tree_version(), but this only changes when something in this node's subtree (not
+    //         including shadow trees) changes in a way that a live collection with the given dependencies cares about.
+    u64 subtree_version(LiveCollectionDependencies) const;
+    void did_change_subtree(SubtreeChange);
     virtual WebIDL::ExceptionOr<void> cloned(Node&, bool) const { return {}; }
 
     Layout::Node const* layout_node() const { return m_layout_node; }
@@ -519,6 +542,10 @@ protected:
 
     UniqueNodeID m_unique_id;
 
+    u64 m_subtree_structure_version { 0 };
+    u64 m_subtree_class_names_version { 0 };
+    u64 m_subtree_attributes_version { 0 };
+
     // https://dom.spec.whatwg.org/#registered-observer-list
     // "Nodes have a strong reference to registered observers in their registered observer list." https://dom.spec.whatwg.org/#garbage-collection
     OwnPtr<Vector<GC::Ref<RegisteredObserver>>> m_registered_observer_list;
@@ -9,9 +9,12 @@
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NodeOperations.h>
 #include <LibWeb/DOM/ParentNode.h>
+#include <LibWeb/DOM/ParsedSelectorCache.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/DOM/StaticNodeList.h>
 #include <LibWeb/Dump.h>
@@ -47,18 +50,55 @@ enum class ReturnMatches {
     First,
     All,
 };
+// OPTIMIZATION: For a connected node, the elements with a given ID can be looked up in its tree scope's ElementByIdMap
+//               instead of walking the whole subtree. That map is kept in tree order, so this still gives the results in
+//               the order the spec wants them.
+static ElementByIdMap* element_by_id_map_for_scope_matching(ParentNode& node)
+{
+    if (!node.is_connected())
+        return nullptr;
+    auto& root = node.root();
+    if (root.is_document())
+        return &static_cast<Document&>(root).element_by_id();
+    if (root.is_shadow_root())
+        return &static_cast<ShadowRoot&>(root).element_by_id();
+    return nullptr;
+}
+
+// OPTIMIZATION: The elements that a `.class` or `tag` selector can match all have that class name or local name, so they
+//               can be looked up in the tree scope's ElementIndex instead.
+static Optional<ElementIndex::Key> element_index_key_for_scope_matching(ParsedSelector const& parsed_selector, Document const& document)
+{
+    switch (parsed_selector.shape()) {
+    case ParsedSelector::Shape::Class:
+        // NOTE: The index matches class names case-sensitively, but quirks mode wants them matched case-insensitively.
+        if (document.in_quirks_mode())
+            return {};
+        return ElementIndex::Key::ClassName;
+    case ParsedSelector::Shape::TagName:
+        // NOTE: In HTML documents, HTML elements are matched against the selector in ASCII lowercase and other elements
+        //       against the selector as written. Those are two different local names, unless they are the same.
+        if (document.document_type() == Document::Type::HTML && parsed_selector.name() != parsed_selector.name().to_ascii_lowercase())
+            return {};
+        return ElementIndex::Key::LocalName;
+    default:
+        return {};
+    }
+}
+
 // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
 static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_match_a_selectors_string(ParentNode& node, StringView selector_text, ReturnMatches return_matches)
 {
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams { node.document() }, selector_text);
+    auto parsed_selector = node.document().parsed_selector_cache().get_or_parse(node.document(), selector_text);
+    auto const& maybe_selectors = parsed_selector->selectors();
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_utf16);
 
-    auto selectors = maybe_selectors.value();
+    auto const& selectors = maybe_selectors.value();
 
     // "Note: Support for namespaces within selectors is not planned and will not be added."
     if (contains_named_namespace(selectors))
@@ -67,18 +107,62 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     GC::Ptr<Element> single_result;
     Vector<GC::Root<Node>> results;
+
+    if (parsed_selector->shape() == ParsedSelector::Shape::Id) {
+        if (auto* element_by_id = element_by_id_map_for_scope_matching(node)) {
+            element_by_id->for_each_element_with_id(parsed_selector->name(), [&](GC::Ref<Element> element) {
+                if (single_result || !node.is_ancestor_of(*element))
+                    return;
+                if (return_matches == ReturnMatches::First)
+                    single_result = element;
+                else
+                    results.append(element);
+            });
+
+            if (return_matches == ReturnMatches::First)
+                return { single_result };
+            return { StaticNodeList::create(node.realm(), move(results)) };
+        }
+    }
+
+    if (auto element_index_key = element_index_key_for_scope_matching(*parsed_selector, node.document()); element_index_key.has_value()) {
+        if (auto* element_index = ElementIndex::for_tree_scope_of(node)) {
+            bool node_is_tree_scope = &node.root() == &node;
+            for (auto element : element_index->elements(*element_index_key, parsed_selector->name())) {
+                if (!node_is_tree_scope && !node.is_ancestor_of(*element))
+                    continue;
+                if (!parsed_selector->matches_simple_selector(*element))
+                    continue;
+                if (return_matches == ReturnMatches::First)
+                    return { GC::Ptr<Element> { element } };
+                results.append(element);
+            }
+
+            if (return_matches == ReturnMatches::First)
+                return { single_result };
+            return { StaticNodeList::create(node.realm(), move(results)) };
+        }
+    }
+
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     node.for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto& selector : selectors) {
-            SelectorEngine::MatchContext context;
-            if (SelectorEngine::matches(selector, element, nullptr, context, {}, node)) {
-                if (return_matches == ReturnMatches::First) {
-                    single_result = &element;
-                    return TraversalDecision::Break;
-                }
-                results.append(element);
-                break;
+        auto element_matches = [&] {
+            // OPTIMIZATION: `#id`, `.class` and `tag` are matched directly, without setting up the SelectorEngine.
+            if (parsed_selector->shape() != ParsedSelector::Shape::Other)
+                return parsed_selector->matches_simple_selector(element);
+            for (auto& selector : selectors) {
+                SelectorEngine::MatchContext context;
+                if (SelectorEngine::matches(selector, element, nullptr, context, {}, node))
+                    return true;
+            }
+            return false;
+        };
+        if (element_matches()) {
+            if (return_matches == ReturnMatches::First) {
+                single_result = &element;
+                return TraversalDecision::Break;
             }
+            results.append(element);
         }
         return TraversalDecision::Continue;
     });
@@ -139,6 +223,7 @@ GC::Ref<HTMLCollection> ParentNode::children()
         m_children = HTMLCollection::create(*this, HTMLCollection::Scope::Children, [](Element const&) {
             return true;
         });
+        m_children->set_dependencies(LiveCollectionDependencies::Structure);
     }
     return *m_children;
 }
@@ -147,30 +232,45 @@ GC::Ref<HTMLCollection> ParentNode::children()
 // NOTE: This method is only exposed on Document and Element, but is in ParentNode to prevent code duplication.
 GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name(FlyString const& qualified_name)
 {
-    // 1. If qualifiedName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches only descendant elements.
-    if (qualified_name == "*") {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
-            return true;
-        });
-    }
+    auto collection = [&] {
+        // 1. If qualifiedName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches only descendant elements.
+        if (qualified_name == "*") {
+            return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
+                return true;
+            });
+        }
 
-    // 2. Otherwise, if root’s node document is an HTML document, return a HTMLCollection rooted at root, whose filter matches the following descendant elements:
-    if (root().document().document_type() == Document::Type::HTML) {
-        FlyString qualified_name_in_ascii_lowercase = qualified_name.to_ascii_lowercase();
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name, qualified_name_in_ascii_lowercase](Element const& element) {
-            // - Whose namespace is the HTML namespace and whose qualified name is qualifiedName, in ASCII lowercase.
-            if (element.namespace_uri() == Namespace::HTML)
-                return element.qualified_name() == qualified_name_in_ascii_lowercase;
+        // 2. Otherwise, if root’s node document is an HTML document, return a HTMLCollection rooted at root, whose filter matches the following descendant elements:
+        if (root().document().document_type() == Document::Type::HTML) {
+            FlyString qualified_name_in_ascii_lowercase = qualified_name.to_ascii_lowercase();
+            bool qualified_name_is_in_ascii_lowercase = qualified_name == qualified_name_in_ascii_lowercase;
+            auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name, qualified_name_in_ascii_lowercase](Element const& element) {
+                // - Whose namespace is the HTML namespace and whose qualified name is qualifiedName, in ASCII lowercase.
+                if (element.namespace_uri() == Namespace::HTML)
+                    return element.qualified_name() == qualified_name_in_ascii_lowercase;
+
+                // - Whose namespace is not the HTML namespace and whose qualified name is qualifiedName.
+                return element.qualified_name() == qualified_name;
+            });
+            // NOTE: Without a prefix, the qualified name is the local name. If qualifiedName isn't in ASCII lowercase, HTML
+            //       and other elements match different local names, which a single index lookup can't give us.
+            if (qualified_name_is_in_ascii_lowercase && !qualified_name.bytes_as_string_view().contains(':'))
+                collection->set_element_index_key(ElementIndex::Key::LocalName, qualified_name);
+            return collection;
+        }
 
-            // - Whose namespace is not the HTML namespace and whose qualified name is qualifiedName.
+        // 3. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose qualified name is qualifiedName.
+        auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name](Element const& element) {
             return element.qualified_name() == qualified_name;
         });
-    }
-
-    // 3. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose qualified name is qualifiedName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name](Element const& element) {
-        return element.qualified_name() == qualified_name;
-    });
+        if (!qualified_name.bytes_as_string_view().contains(':'))
+            collection->set_element_index_key(ElementIndex::Key::LocalName, qualified_name);
+        return collection;
+    }();
+
+    // NOTE: Elements can't change their name, so only insertions and removals matter.
+    collection->set_dependencies(LiveCollectionDependencies::Structure);
+    return collection;
 }
 
 // https://dom.spec.whatwg.org/#concept-getelementsbytagnamens
@@ -181,31 +281,41 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name_ns(Optional<FlyStri
     if (namespace_ == FlyString {})
         namespace_ = OptionalNone {};
 
-    // 2. If both namespace and localName are "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements.
-    if (namespace_ == "*" && local_name == "*") {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
-            return true;
-        });
-    }
+    auto collection = [&] {
+        // 2. If both namespace and localName are "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements.
+        if (namespace_ == "*" && local_name == "*") {
+            return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
+                return true;
+            });
+        }
 
-    // 3. Otherwise, if namespace is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose local name is localName.
-    if (namespace_ == "*") {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [local_name](Element const& element) {
-            return element.local_name() == local_name;
-        });
-    }
+        // 3. Otherwise, if namespace is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose local name is localName.
+        if (namespace_ == "*") {
+            auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [local_name](Element const& element) {
+                return element.local_name() == local_name;
+            });
+            collection->set_element_index_key(ElementIndex::Key::LocalName, local_name);
+            return collection;
+        }
 
-    // 4. Otherwise, if localName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace.
-    if (local_name == "*") {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_](Element const& element) {
-            return element.namespace_uri() == namespace_;
+        // 4. Otherwise, if localName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace.
+        if (local_name == "*") {
+            return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_](Element const& element) {
+                return element.namespace_uri() == namespace_;
+            });
+        }
+
+        // 5. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace and local name is localName.
+        auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_, local_name](Element const& element) {
+            return element.namespace_uri() == namespace_ && element.local_name() == local_name;
         });
-    }
+        collection->set_element_index_key(ElementIndex::Key::LocalName, local_name);
+        return collection;
+    }();
 
-    // 5. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace and local name is localName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_, local_name](Element const& element) {
-        return element.namespace_uri() == namespace_ && element.local_name() == local_name;
-    });
+    // NOTE: Elements can't change their namespace or local name, so only insertions and removals matter.
+    collection->set_dependencies(LiveCollectionDependencies::Structure);
+    return collection;
 }
 
 // https://dom.spec.whatwg.org/#dom-parentnode-prepend
@@ -267,13 +377,21 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_class_name(StringView class_
     for (auto& name : class_names.split_view_if(Infra::is_ascii_whitespace)) {
         list_of_class_names.append(FlyString::from_utf8(name).release_value_but_fixme_should_propagate_errors());
     }
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    // NOTE: Class names are matched case-insensitively in quirks mode, which the index doesn't support.
+    Optional<FlyString> element_index_class_name;
+    if (!list_of_class_names.is_empty() && !document().in_quirks_mode())
+        element_index_class_name = list_of_class_names.first();
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
         for (auto& name : list_of_class_names) {
             if (!element.has_class(name, quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
                 return false;
         }
         return !list_of_class_names.is_empty();
     });
+    if (element_index_class_name.has_value())
+        collection->set_element_index_key(ElementIndex::Key::ClassName, element_index_class_name.release_value());
+    collection->set_dependencies(LiveCollectionDependencies::StructureAndClassNames);
+    return collection;
 }
 
 GC::Ptr<Element> ParentNode::get_element_by_id(FlyString const& id) const
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ParsedSelectorCache.h>
+#include <LibWeb/Namespace.h>
+
+namespace Web::DOM {
+
+NonnullRefPtr<ParsedSelector> ParsedSelector::create(Optional<CSS::SelectorList> selectors)
+{
+    return adopt_ref(*new ParsedSelector(move(selectors)));
+}
+
+ParsedSelector::ParsedSelector(Optional<CSS::SelectorList> selectors)
+    : m_selectors(move(selectors))
+{
+    if (!m_selectors.has_value() || m_selectors->size() != 1)
+        return;
+
+    auto const& selector = *m_selectors->first();
+    if (selector.pseudo_element().has_value() || selector.compound_selectors().size() != 1)
+        return;
+
+    auto const& compound_selector = selector.compound_selectors().first();
+    if (compound_selector.combinator != CSS::Selector::Combinator::None || compound_selector.simple_selectors.size() != 1)
+        return;
+
+    auto const& simple_selector = compound_selector.simple_selectors.first();
+    switch (simple_selector.type) {
+    case CSS::Selector::SimpleSelector::Type::Id:
+        m_shape = Shape::Id;
+        m_name = simple_selector.name();
+        break;
+    case CSS::Selector::SimpleSelector::Type::Class:
+        m_shape = Shape::Class;
+        m_name = simple_selector.name();
+        break;
+    case CSS::Selector::SimpleSelector::Type::TagName: {
+        // NOTE: Without a style sheet to declare a default namespace, `E` matches elements in any namespace, like `*|E`.
+        auto const& qualified_name = simple_selector.qualified_name();
+        if (!first_is_one_of(qualified_name.namespace_type, CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Default, CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Any))
+            return;
+        m_shape = Shape::TagName;
+        m_name = qualified_name.name.name;
+        m_lowercase_name = qualified_name.name.lowercase_name;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// NOTE: This has to agree with what SelectorEngine::matches() does for the same selector.
+bool ParsedSelector::matches_simple_selector(Element const& element) const
+{
+    switch (m_shape) {
+    case Shape::Id:
+        return m_name == element.id();
+    case Shape::Class: {
+        // Class selectors are matched case insensitively in quirks mode.
+        // See: https://drafts.csswg.org/selectors-4/#class-html
+        auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
+        return element.has_class(m_name, case_sensitivity);
+    }
+    case Shape::TagName:
+        // https://html.spec.whatwg.org/multipage/semantics-other.html#case-sensitivity-of-selectors
+        if (element.namespace_uri() == Namespace::HTML && element.document().document_type() == Document::Type::HTML)
+            return m_lowercase_name == element.local_name();
+        return m_name == element.local_name();
+    case Shape::Other:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+NonnullRefPtr<ParsedSelector> ParsedSelectorCache::get_or_parse(Document const& document, StringView selector_text)
+{
+    if (auto it = m_entries.find(selector_text); it != m_entries.end()) {
+        auto key = it->key;
+        auto parsed_selector = it->value;
+        // Move the entry to the back, as the most recently used one.
+        m_entries.remove(it);
+        m_entries.set(move(key), parsed_selector);
+        return parsed_selector;
+    }
+
+    // NOTE: Parse failures are cached as well, since pages that probe for selector support tend to do so repeatedly.
+    auto parsed_selector = ParsedSelector::create(parse_selector(CSS::Parser::ParsingParams { document }, selector_text));
+
+    if (m_entries.size() >= capacity)
+        (void)m_entries.take_first();
+    m_entries.set(MUST(String::from_utf8(selector_text)), parsed_selector);
+    return parsed_selector;
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// The result of parsing a selectors string passed to querySelector(), matches() or closest().
+class ParsedSelector : public RefCounted<ParsedSelector> {
+public:
+    // Selector lists that consist of a single `#id`, `.class` or `tag` selector. These can be matched without going
+    // through the SelectorEngine, and the tree scope's ElementByIdMap or ElementIndex gives the elements they can
+    // match directly.
+    enum class Shape : u8 {
+        Other,
+        Id,
+        Class,
+        TagName,
+    };
+
+    static NonnullRefPtr<ParsedSelector> create(Optional<CSS::SelectorList>);
+
+    // Empty if the selectors string failed to parse.
+    Optional<CSS::SelectorList> const& selectors() const { return m_selectors; }
+
+    Shape shape() const { return m_shape; }
+    FlyString const& name() const { return m_name; }
+
+    // Only valid for the Id, Class and TagName shapes.
+    bool matches_simple_selector(Element const&) const;
+
+private:
+    explicit ParsedSelector(Optional<CSS::SelectorList>);
+
+    Optional<CSS::SelectorList> m_selectors;
+    Shape m_shape { Shape::Other };
+    FlyString m_name;
+    FlyString m_lowercase_name;
+};
+
+// A small least-recently-used cache of parsed selectors strings, owned by the document. Pages tend to call
+// querySelector() and friends with the same handful of strings over and over, often in a loop, and parsing the
+// selectors every time is a large part of what those calls cost.
+// NOTE: Selectors are always parsed in the document's own parsing context, so the selectors string alone is the key.
+class ParsedSelectorCache {
+public:
+    NonnullRefPtr<ParsedSelector> get_or_parse(Document const&, StringView selector_text);
+
+private:
+    static constexpr size_t capacity = 64;
+
+    // Kept in the order they were last used in, least recently used first.
+    OrderedHashMap<String, NonnullRefPtr<ParsedSelector>> m_entries;
+};
+
+}
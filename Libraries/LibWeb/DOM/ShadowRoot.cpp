@@ -8,6 +8,7 @@
 #include <LibWeb/DOM/AdoptedStyleSheets.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/DocumentOrShadowRoot.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLTemplateElement.h>
@@ -160,6 +161,8 @@ void ShadowRoot::visit_edges(Visitor& visitor)
     m_style_scope.visit_edges(visitor);
     visitor.visit(m_style_sheets);
     visitor.visit(m_adopted_style_sheets);
+    if (m_element_index)
+        m_element_index->visit_edges(visitor);
     for (auto const& [key, elements] : m_part_element_map) {
         for (auto const& element : elements)
             element.visit(visitor);
@@ -230,6 +233,22 @@ ElementByIdMap& ShadowRoot::element_by_id() const
     return *m_element_by_id;
 }
 
+ElementIndex& ShadowRoot::element_index() const
+{
+    if (!m_element_index)
+        m_element_index = make<ElementIndex>(const_cast<ShadowRoot&>(*this));
+    return *m_element_index;
+}
+
+void ShadowRoot::adopted_from(Document& old_document)
+{
+    Base::adopted_from(old_document);
+
+    // NOTE: Our elements keep using our index in the new document, so it has to know to keep it up to date.
+    if (m_element_index)
+        m_element_index->did_change_document({});
+}
+
 // https://drafts.csswg.org/css-shadow-1/#shadow-root-part-element-map
 ShadowRoot::PartElementMap const& ShadowRoot::part_element_map() const
 {
@@ -72,6 +72,9 @@ public:
 
     ElementByIdMap& element_by_id() const;
 
+    ElementIndex& element_index() const;
+    ElementIndex* element_index_if_built() const { return m_element_index.ptr(); }
+
     CSS::StyleScope const& style_scope() const { return m_style_scope; }
     CSS::StyleScope& style_scope() { return m_style_scope; }
 
@@ -89,6 +92,7 @@ private:
 
     // ^Node
     virtual FlyString node_name() const override { return "#shadow-root"_fly_string; }
+    virtual void adopted_from(Document&) override;
     virtual bool is_shadow_root() const final { return true; }
 
     void calculate_part_element_map();
@@ -109,6 +113,7 @@ private:
     bool m_serializable { false };
 
     mutable OwnPtr<ElementByIdMap> m_element_by_id;
+    mutable OwnPtr<ElementIndex> m_element_index;
 
     GC::Ptr<CSS::StyleSheetList> m_style_sheets;
     mutable GC::Ptr<WebIDL::ObservableArray> m_adopted_style_sheets;
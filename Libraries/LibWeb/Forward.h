@@ -402,6 +402,7 @@ class ViewFunctionStyleValue;
 class VisualViewport;
 
 enum class Keyword : u16;
+enum class MediaFeatureDependencies : u8;
 enum class MediaFeatureID : u8;
 enum class PropertyID : u16;
 enum class PaintOrder : u8;
@@ -470,6 +471,7 @@ class DOMTokenList;
 class EditingHostManager;
 class Element;
 class ElementByIdMap;
+class ElementIndex;
 class Event;
 class EventHandler;
 class EventTarget;
@@ -484,6 +486,8 @@ class NodeFilter;
 class NodeIterator;
 class NodeList;
 class ParentNode;
+class ParsedSelector;
+class ParsedSelectorCache;
 class Position;
 class ProcessingInstruction;
 class PseudoElement;
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/Debug.h>
+#include <LibGfx/ImmutableBitmap.h>
+#include <LibWeb/DOM/CharacterData.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/BackForwardCache.h>
+#include <LibWeb/HTML/DocumentState.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/HTMLImageElement.h>
+#include <LibWeb/HTML/SessionHistoryEntry.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/IDBTransaction.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/Platform/Timer.h>
+
+namespace Web::HTML {
+
+GC_DEFINE_ALLOCATOR(BackForwardCache);
+
+static BackForwardCachePolicy& back_forward_cache_policy()
+{
+    static BackForwardCachePolicy policy;
+    return policy;
+}
+
+BackForwardCachePolicy const& BackForwardCachePolicy::the()
+{
+    return back_forward_cache_policy();
+}
+
+void BackForwardCachePolicy::set_the(BackForwardCachePolicy policy)
+{
+    back_forward_cache_policy() = policy;
+}
+
+size_t BackForwardCachePolicy::number_of_entries_to_evict(ReadonlySpan<Entry> entries, MonotonicTime now) const
+{
+    size_t total_memory_bytes = 0;
+    for (auto const& entry : entries)
+        total_memory_bytes += entry.estimated_memory_bytes;
+
+    size_t count = 0;
+    while (count < entries.size()) {
+        auto const& entry = entries[count];
+        auto remaining_documents = entries.size() - count;
+        if (now - entry.stored_at < time_to_live && remaining_documents <= maximum_documents && total_memory_bytes <= maximum_memory_bytes)
+            break;
+        total_memory_bytes -= entry.estimated_memory_bytes;
+        ++count;
+    }
+    return count;
+}
+
+Optional<AK::Duration> BackForwardCachePolicy::time_until_next_expiry(ReadonlySpan<Entry> entries, MonotonicTime now) const
+{
+    if (entries.is_empty())
+        return {};
+    return max(entries.first().stored_at + time_to_live - now, AK::Duration::zero());
+}
+
+GC::Ref<BackForwardCache> BackForwardCache::create(TraversableNavigable& traversable)
+{
+    return traversable.heap().allocate<BackForwardCache>(traversable);
+}
+
+BackForwardCache::BackForwardCache(TraversableNavigable& traversable)
+    : m_traversable(traversable)
+{
+}
+
+void BackForwardCache::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_traversable);
+    for (auto& entry : m_entries) {
+        visitor.visit(entry.document);
+        visitor.visit(entry.descendant_navigables);
+    }
+    visitor.visit(m_expiry_timer);
+}
+
+static bool has_unfinished_indexed_db_transactions(Window& window)
+{
+    bool result = false;
+    IndexedDB::Database::for_each_database([&](IndexedDB::Database& database) {
+        for (auto& connection : database.associated_connections()->elements()) {
+            if (&relevant_global_object(*connection) != &window)
+                continue;
+            for (auto& transaction : connection->transactions()) {
+                if (!transaction->is_finished())
+                    result = true;
+            }
+        }
+    });
+    return result;
+}
+
+static void append_blocking_reasons(DOM::Document& document, Vector<String>& reasons)
+{
+    auto append = [&](String reason) {
+        if (!reasons.contains_slow(reason))
+            reasons.append(move(reason));
+    };
+
+    for (auto const& reason : document.bfcache_blocking_details())
+        append(reason);
+    if (!document.is_salvageable() && document.bfcache_blocking_details().is_empty())
+        append("masked"_string);
+
+    auto window = document.window();
+    if (!window)
+        return;
+
+    // NOTE: Pages that listen for unload expect it to be fired when they are navigated away from, which doesn't happen
+    //       to documents that are kept in the cache.
+    if (window->has_event_listener(EventNames::unload))
+        append("unload-listener"_string);
+
+    // NOTE: The unloading document cleanup steps would make the document's WebSocket connections disappear, and make
+    //       the document unsalvageable anyway.
+    if (window->has_registered_web_sockets())
+        append("websocket"_string);
+
+    // NOTE: A transaction that is still running when the document is frozen could keep other connections to the same
+    //       database blocked for as long as the document stays in the cache.
+    if (has_unfinished_indexed_db_transactions(*window))
+        append("indexeddb-transaction"_string);
+}
+
+Vector<String> BackForwardCache::blocking_reasons(DOM::Document& document)
+{
+    Vector<String> reasons;
+    append_blocking_reasons(document, reasons);
+    for (auto& navigable : document.descendant_navigables()) {
+        if (auto descendant_document = navigable->active_document())
+            append_blocking_reasons(*descendant_document, reasons);
+    }
+    return reasons;
+}
+
+bool BackForwardCache::should_store(DOM::Document& document)
+{
+    if (!BackForwardCachePolicy::the().enabled)
+        return false;
+    if (document.navigable() != m_traversable.ptr())
+        return false;
+
+    auto reasons = blocking_reasons(document);
+    if (reasons.is_empty())
+        return true;
+
+    ++m_metrics.not_stored_documents;
+    for (auto const& reason : reasons)
+        ++m_metrics.not_stored_reasons.ensure(reason, [] { return 0; });
+    dbgln_if(BACK_FORWARD_CACHE_DEBUG, "BackForwardCache: Not storing {}: {}", document.url(), reasons);
+    return false;
+}
+
+// A rough estimate of how much memory keeping the document alive takes, counting its nodes (along with their style
+// and layout), its text and its decoded images.
+static size_t estimated_memory_bytes_of(DOM::Document& document)
+{
+    static constexpr size_t approximate_bytes_per_node = 512;
+
+    size_t bytes = 0;
+    document.for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+        bytes += approximate_bytes_per_node;
+        if (auto const* character_data = as_if<DOM::CharacterData>(node)) {
+            bytes += character_data->length_in_utf16_code_units() * sizeof(char16_t);
+        } else if (auto const* image = as_if<HTMLImageElement>(node)) {
+            if (auto bitmap = image->immutable_bitmap())
+                bytes += static_cast<size_t>(bitmap->width()) * bitmap->height() * 4;
+        }
+        return TraversalDecision::Continue;
+    });
+    return bytes;
+}
+
+void BackForwardCache::store(DOM::Document& document)
+{
+    VERIFY(!contains(document));
+
+    Entry entry { .document = document, .descendant_navigables = {}, .policy_entry = {} };
+    entry.policy_entry.stored_at = MonotonicTime::now();
+    entry.policy_entry.estimated_memory_bytes = estimated_memory_bytes_of(document);
+
+    for (auto& navigable : document.descendant_navigables()) {
+        if (auto descendant_document = navigable->active_document())
+            entry.policy_entry.estimated_memory_bytes += estimated_memory_bytes_of(*descendant_document);
+        all_navigables().remove(*navigable);
+        entry.descendant_navigables.append(*navigable);
+    }
+
+    dbgln_if(BACK_FORWARD_CACHE_DEBUG, "BackForwardCache: Storing {} (~{} KiB)", document.url(), entry.policy_entry.estimated_memory_bytes / KiB);
+
+    m_entries.append(move(entry));
+    ++m_metrics.stored_documents;
+
+    evict_entries_over_budget();
+}
+
+void BackForwardCache::did_restore(DOM::Document& document)
+{
+    auto index = find_entry(document);
+    if (!index.has_value())
+        return;
+
+    auto entry = m_entries.take(*index);
+    for (auto& navigable : entry.descendant_navigables)
+        all_navigables().set(navigable);
+
+    ++m_metrics.restored_documents;
+    if (document.layout_node())
+        ++m_metrics.restored_documents_with_layout_tree;
+    dbgln_if(BACK_FORWARD_CACHE_DEBUG, "BackForwardCache: Restored {}", document.url());
+
+    schedule_expiry_timer();
+}
+
+bool BackForwardCache::contains(DOM::Document const& document) const
+{
+    return find_entry(document).has_value();
+}
+
+Optional<size_t> BackForwardCache::find_entry(DOM::Document const& document) const
+{
+    return m_entries.find_first_index_if([&](auto const& entry) {
+        return entry.document.ptr() == &document;
+    });
+}
+
+size_t BackForwardCache::estimated_memory_bytes() const
+{
+    size_t bytes = 0;
+    for (auto const& entry : m_entries)
+        bytes += entry.policy_entry.estimated_memory_bytes;
+    return bytes;
+}
+
+void BackForwardCache::evict_entry(size_t index, StringView reason)
+{
+    auto entry = m_entries.take(index);
+    auto document = entry.document;
+
+    dbgln_if(BACK_FORWARD_CACHE_DEBUG, "BackForwardCache: Evicting {}: {}", document->url(), reason);
+    ++m_metrics.evicted_documents;
+
+    // NOTE: The document isn't the active document of any navigable, so destroying it won't clear its session history
+    //       entry's document for us. Traversing to that entry will fetch the page again.
+    if (auto latest_entry = document->latest_entry(); latest_entry && latest_entry->document() == document)
+        latest_entry->document_state()->set_document(nullptr);
+
+    // NOTE: Tasks queued for a document that isn't fully active don't run, so rather than destroying the document and its
+    //       descendants in tasks of their own, destroy them right away.
+    document->destroy();
+    for (auto& navigable : entry.descendant_navigables) {
+        if (auto descendant_document = navigable->active_document())
+            descendant_document->destroy();
+    }
+}
+
+void BackForwardCache::evict_entries_over_budget()
+{
+    Vector<BackForwardCachePolicy::Entry> policy_entries;
+    policy_entries.ensure_capacity(m_entries.size());
+    for (auto const& entry : m_entries)
+        policy_entries.unchecked_append(entry.policy_entry);
+
+    auto count = BackForwardCachePolicy::the().number_of_entries_to_evict(policy_entries, MonotonicTime::now());
+    for (size_t i = 0; i < count; ++i)
+        evict_entry(0, "over budget or expired"sv);
+
+    schedule_expiry_timer();
+}
+
+void BackForwardCache::schedule_expiry_timer()
+{
+    Vector<BackForwardCachePolicy::Entry> policy_entries;
+    policy_entries.ensure_capacity(m_entries.size());
+    for (auto const& entry : m_entries)
+        policy_entries.unchecked_append(entry.policy_entry);
+
+    auto time_until_next_expiry = BackForwardCachePolicy::the().time_until_next_expiry(policy_entries, MonotonicTime::now());
+    if (!time_until_next_expiry.has_value()) {
+        if (m_expiry_timer)
+            m_expiry_timer->stop();
+        return;
+    }
+
+    if (!m_expiry_timer) {
+        m_expiry_timer = Platform::Timer::create_single_shot(heap(), 0, GC::create_function(heap(), [this] {
+            if (m_traversable->has_been_destroyed())
+                return;
+
+            // NOTE: Evicting a document destroys it, so don't do that in the middle of a traversal that may be about to
+            //       restore it; wait for our turn in the session history traversal queue instead.
+            m_traversable->append_session_history_traversal_steps(GC::create_function(heap(), [this] {
+                auto signal_to_continue_session_history_processing = Core::Promise<Empty>::construct();
+                evict_entries_over_budget();
+                signal_to_continue_session_history_processing->resolve({});
+                return signal_to_continue_session_history_processing;
+            }));
+        }));
+    }
+
+    // NOTE: Round up, so the first entry has actually expired once the timer fires.
+    auto milliseconds = (time_until_next_expiry->to_nanoseconds() + 999'999) / 1'000'000;
+    m_expiry_timer->restart(static_cast<int>(min(milliseconds, static_cast<i64>(NumericLimits<int>::max()))));
+}
+
+void BackForwardCache::evict_all(StringView reason)
+{
+    while (!m_entries.is_empty())
+        evict_entry(m_entries.size() - 1, reason);
+    schedule_expiry_timer();
+}
+
+void BackForwardCache::evict_documents_without_session_history_entries()
+{
+    auto const& session_history_entries = m_traversable->session_history_entries();
+    for (size_t i = m_entries.size(); i > 0; --i) {
+        auto const& document = m_entries[i - 1].document;
+        auto has_session_history_entry = any_of(session_history_entries, [&](auto const& entry) {
+            return entry->document() == document;
+        });
+        if (!has_session_history_entry)
+            evict_entry(i - 1, "session history entry removed"sv);
+    }
+    schedule_expiry_timer();
+}
+
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// How many documents the back/forward cache may keep alive, and for how long.
+struct WEB_API BackForwardCachePolicy {
+    static BackForwardCachePolicy const& the();
+    static void set_the(BackForwardCachePolicy);
+
+    struct Entry {
+        size_t estimated_memory_bytes { 0 };
+        MonotonicTime stored_at;
+    };
+
+    // Returns how many of the given entries, least recently stored first, have to be evicted for the rest to fit
+    // within the budget. Entries that have been cached for longer than the time to live are always evicted.
+    size_t number_of_entries_to_evict(ReadonlySpan<Entry>, MonotonicTime now) const;
+
+    // How long until the first of the given entries, least recently stored first, expires. Empty if there are none.
+    Optional<AK::Duration> time_until_next_expiry(ReadonlySpan<Entry>, MonotonicTime now) const;
+
+    bool enabled { true };
+    size_t maximum_documents { 6 };
+    size_t maximum_memory_bytes { 64 * MiB };
+    AK::Duration time_to_live { AK::Duration::from_seconds(10 * 60) };
+};
+
+// Keeps the documents of a top-level traversable's session history entries alive after they have been navigated away
+// from, so that traversing back to them can make them active again right away instead of fetching the page, parsing it
+// and running all of its scripts again. See "intendToStoreInBfcache" in the unload a document steps.
+//
+// A cached document keeps its DOM, its layout tree and its Window. Its timers are suspended, and the tasks queued for it
+// (and for the documents in its child navigables) stay in the event loop's task queue without running, as it is not
+// fully active.
+class BackForwardCache final : public JS::Cell {
+    GC_CELL(BackForwardCache, JS::Cell);
+    GC_DECLARE_ALLOCATOR(BackForwardCache);
+
+public:
+    struct Metrics {
+        u64 stored_documents { 0 };
+        u64 restored_documents { 0 };
+        // Restored documents that still had their layout tree, so they didn't have to be laid out from scratch.
+        u64 restored_documents_with_layout_tree { 0 };
+        u64 evicted_documents { 0 };
+        u64 not_stored_documents { 0 };
+
+        // How often each reason kept a document from being stored, so we can see why pages miss the cache.
+        HashMap<String, u64> not_stored_reasons;
+    };
+
+    static GC::Ref<BackForwardCache> create(TraversableNavigable&);
+
+    // The reasons the document, or any of the documents in its descendant navigables, can't be stored. These are the
+    // documents' bfcache blocking details, plus the ones we find by looking at the documents as they are now.
+    static Vector<String> blocking_reasons(DOM::Document&);
+
+    // Whether the document, which is about to be unloaded, should be kept alive in the cache. Records the reasons if not.
+    bool should_store(DOM::Document&);
+
+    // Keeps the unloaded document alive, and evicts other documents if that takes the cache over its budget.
+    void store(DOM::Document&);
+
+    // Called when a history traversal makes a cached document its navigable's active document again.
+    void did_restore(DOM::Document&);
+
+    bool contains(DOM::Document const&) const;
+
+    // Destroys cached documents whose session history entries are gone, e.g. after the forward history was cleared.
+    void evict_documents_without_session_history_entries();
+
+    // Destroys all cached documents, e.g. when the traversable is destroyed.
+    void evict_all(StringView reason);
+
+    size_t size() const { return m_entries.size(); }
+    size_t estimated_memory_bytes() const;
+
+    Metrics const& metrics() const { return m_metrics; }
+
+private:
+    explicit BackForwardCache(TraversableNavigable&);
+
+    virtual void visit_edges(Visitor&) override;
+
+    struct Entry {
+        GC::Ref<DOM::Document> document;
+
+        // NOTE: The navigables of a cached document's iframes are taken out of the set of all navigables, as their
+        //       parent is still the traversable, but their container is not in its active document anymore.
+        Vector<GC::Ref<Navigable>> descendant_navigables;
+
+        BackForwardCachePolicy::Entry policy_entry;
+    };
+
+    Optional<size_t> find_entry(DOM::Document const&) const;
+    void evict_entry(size_t index, StringView reason);
+    void evict_entries_over_budget();
+    void schedule_expiry_timer();
+
+    GC::Ref<TraversableNavigable> m_traversable;
+
+    // Least recently stored first.
+    Vector<Entry> m_entries;
+
+    Metrics m_metrics;
+
+    // Evicts entries once they have been cached for longer than the time to live, even if nothing else is stored.
+    GC::Ptr<Platform::Timer> m_expiry_timer;
+};
+
+}
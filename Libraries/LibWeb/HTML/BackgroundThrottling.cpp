@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/HTML/BackgroundThrottling.h>
+
+namespace Web::HTML {
+
+static BackgroundThrottlingPolicy& background_throttling_policy()
+{
+    static BackgroundThrottlingPolicy policy;
+    return policy;
+}
+
+BackgroundThrottlingPolicy const& BackgroundThrottlingPolicy::the()
+{
+    return background_throttling_policy();
+}
+
+void BackgroundThrottlingPolicy::set_the(BackgroundThrottlingPolicy policy)
+{
+    background_throttling_policy() = policy;
+}
+
+AK::Duration BackgroundThrottlingPolicy::throttled_timer_delay(MonotonicTime now, AK::Duration delay, Optional<MonotonicTime> hidden_since, u32 nesting_level) const
+{
+    if (!enabled || !hidden_since.has_value())
+        return delay;
+
+    auto alignment = hidden_timer_alignment;
+    if (nesting_level > maximum_unclamped_timer_nesting_level && now - *hidden_since >= intensive_throttling_delay)
+        alignment = intensive_timer_alignment;
+
+    auto alignment_ns = alignment.to_nanoseconds();
+    if (alignment_ns <= 0)
+        return delay;
+
+    // Round the time the timer is due at up to the next multiple of the alignment.
+    auto due_time_ns = (now + delay).nanoseconds();
+    auto aligned_due_time_ns = ((due_time_ns + alignment_ns - 1) / alignment_ns) * alignment_ns;
+    return AK::Duration::from_nanoseconds(aligned_due_time_ns - now.nanoseconds());
+}
+
+TimerWakeUpMetrics& TimerWakeUpMetrics::the()
+{
+    static TimerWakeUpMetrics metrics;
+    return metrics;
+}
+
+void TimerWakeUpMetrics::did_fire_timer(MonotonicTime now, bool was_throttled)
+{
+    if (was_throttled)
+        ++m_throttled_timers;
+
+    // Timers that fire within a millisecond of each other were handled in the same wake-up.
+    if (m_last_wake_up_time.has_value() && now - *m_last_wake_up_time < AK::Duration::from_milliseconds(1))
+        return;
+    m_last_wake_up_time = now;
+    ++m_wake_ups;
+
+    if (!m_current_second_start_time.has_value() || now - *m_current_second_start_time >= AK::Duration::from_seconds(1)) {
+        // If more than a full second passed without any wake-ups, the last second had none.
+        bool last_second_was_previous_one = m_current_second_start_time.has_value() && now - *m_current_second_start_time < AK::Duration::from_seconds(2);
+        m_wake_ups_in_last_second = last_second_was_previous_one ? m_wake_ups_in_current_second : 0;
+        m_current_second_start_time = now;
+        m_wake_ups_in_current_second = 0;
+    }
+    ++m_wake_ups_in_current_second;
+}
+
+}
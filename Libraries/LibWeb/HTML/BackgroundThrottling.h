@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <LibWeb/Export.h>
+
+namespace Web::HTML {
+
+// How much work documents that the user can't see are allowed to do. Timers in hidden documents are only fired on
+// aligned boundaries, so that the process wakes up once for all of them instead of once per timer, and hidden pages
+// don't get rendering opportunities (and thus no animation frame callbacks) at all.
+struct WEB_API BackgroundThrottlingPolicy {
+    // https://html.spec.whatwg.org/multipage/timers-and-user-prompts.html#timer-initialisation-steps
+    // Timers are considered chained once their nesting level is greater than this, which is also when their timeout
+    // gets clamped to at least 4 milliseconds.
+    static constexpr u32 maximum_unclamped_timer_nesting_level = 5;
+    static constexpr i32 minimum_clamped_timer_timeout_ms = 4;
+
+    static BackgroundThrottlingPolicy const& the();
+    static void set_the(BackgroundThrottlingPolicy);
+
+    // Returns how long to wait before firing a timer that is due after the given delay, in a document that has been
+    // hidden since the given time (if at all).
+    AK::Duration throttled_timer_delay(MonotonicTime now, AK::Duration delay, Optional<MonotonicTime> hidden_since, u32 nesting_level) const;
+
+    bool enabled { true };
+
+    // Timers in hidden documents fire on multiples of this.
+    AK::Duration hidden_timer_alignment { AK::Duration::from_seconds(1) };
+
+    // Once a document has been hidden for this long, chained timers in it only get to wake the process up once per
+    // intensive_timer_alignment.
+    AK::Duration intensive_throttling_delay { AK::Duration::from_seconds(5 * 60) };
+    AK::Duration intensive_timer_alignment { AK::Duration::from_seconds(60) };
+};
+
+// Counts how often timers wake the process up. Timers that fire together (which aligning them makes more likely) only
+// count as one wake-up.
+class WEB_API TimerWakeUpMetrics {
+public:
+    static TimerWakeUpMetrics& the();
+
+    void did_fire_timer(MonotonicTime now, bool was_throttled);
+
+    u64 wake_ups() const { return m_wake_ups; }
+    u64 throttled_timers() const { return m_throttled_timers; }
+
+    // The number of wake-ups during the last full second.
+    u64 wake_ups_per_second() const { return m_wake_ups_in_last_second; }
+
+private:
+    u64 m_wake_ups { 0 };
+    u64 m_throttled_timers { 0 };
+
+    Optional<MonotonicTime> m_last_wake_up_time;
+    Optional<MonotonicTime> m_current_second_start_time;
+    u64 m_wake_ups_in_current_second { 0 };
+    u64 m_wake_ups_in_last_second { 0 };
+};
+
+}
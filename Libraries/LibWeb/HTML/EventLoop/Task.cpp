@@ -42,6 +42,20 @@ void Task::visit_edges(Visitor& visitor)
     visitor.visit(m_document);
 }
 
+Task::Priority Task::priority_for_source(Source source)
+{
+    switch (source) {
+    // Input and rendering are what the user is waiting on, so they go ahead of everything else.
+    case Source::UserInteraction:
+    case Source::Rendering:
+        return Priority::UserBlocking;
+    case Source::IdleTask:
+        return Priority::Background;
+    default:
+        return Priority::UserVisible;
+    }
+}
+
 void Task::execute()
 {
     m_steps->function()();
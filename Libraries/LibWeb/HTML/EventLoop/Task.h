@@ -93,12 +93,24 @@ public:
         UniqueTaskSourceStart
     };
 
+    // https://wicg.github.io/scheduling-apis/#sec-task-priorities
+    // AD-HOC: The HTML event loop may pick which task queue to run a task from in an implementation-defined manner.
+    //         We use the priorities of the Prioritized Task Scheduling API to do so, based on the task's source.
+    enum class Priority : u8 {
+        UserBlocking,
+        UserVisible,
+        Background,
+    };
+    static constexpr size_t priority_count = 3;
+    static Priority priority_for_source(Source);
+
     static GC::Ref<Task> create(JS::VM&, Source, GC::Ptr<DOM::Document const>, GC::Ref<GC::Function<void()>> steps);
 
     virtual ~Task() override;
 
     [[nodiscard]] TaskID id() const { return m_id; }
     Source source() const { return m_source; }
+    Priority priority() const { return priority_for_source(m_source); }
     void execute();
 
     DOM::Document const* document() const;
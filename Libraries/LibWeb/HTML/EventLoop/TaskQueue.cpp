@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <LibGC/RootVector.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
@@ -24,7 +26,14 @@ void TaskQueue::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_event_loop);
-    visitor.visit(m_tasks);
+    for (auto const& sub_queues : m_sub_queues) {
+        for (auto const& it : sub_queues) {
+            auto const& sub_queue = *it.value;
+            for (size_t i = sub_queue.first_entry_index; i < sub_queue.entries.size(); ++i)
+                visitor.visit(sub_queue.entries[i].task);
+        }
+    }
+    visitor.visit(m_last_added_task);
 }
 
 void TaskQueue::add(GC::Ref<Task> task)
@@ -38,77 +47,177 @@ void TaskQueue::add(GC::Ref<Task> task)
     if (task->document() && !task->document()->has_been_browsing_context_associated())
         return;
 
-    m_tasks.append(task);
+    auto priority = task->priority();
+    SubQueueKey key { task->document(), task->source() == Task::Source::Rendering };
+    auto& sub_queue = *m_sub_queues[to_underlying(priority)].ensure(key, [&] {
+        auto sub_queue = make<SubQueue>();
+        sub_queue->key = key;
+        return sub_queue;
+    });
+    sub_queue.entries.append({ task, m_next_sequence_number++, MonotonicTime::now() });
+
+    ++m_size;
+    if (key.is_rendering)
+        ++m_rendering_task_count;
+    auto& metrics = m_metrics[to_underlying(priority)];
+    ++metrics.queued_tasks;
+    metrics.peak_queued_tasks = max(metrics.peak_queued_tasks, metrics.queued_tasks);
+
+    m_last_added_task = task;
     m_event_loop->schedule();
 }
 
-GC::Ptr<Task> TaskQueue::take_first_runnable()
+TaskQueue::Entry TaskQueue::SubQueue::take_first()
+{
+    auto entry = entries[first_entry_index++];
+    // OPTIMIZATION: Rather than shifting the remaining entries every time, only drop the ones we've taken once they
+    //               make up half of the vector.
+    if (is_empty()) {
+        entries.clear_with_capacity();
+        first_entry_index = 0;
+    } else if (first_entry_index >= 64 && first_entry_index * 2 >= entries.size()) {
+        entries.remove(0, first_entry_index);
+        first_entry_index = 0;
+    }
+    return entry;
+}
+
+// NOTE: Task::is_runnable() only depends on the task's document, so the first task tells us about all of them.
+bool TaskQueue::SubQueue::is_runnable(EventLoop const& event_loop) const
+{
+    if (key.is_rendering && event_loop.running_rendering_task())
+        return false;
+    return first().task->is_runnable();
+}
+
+TaskQueue::SubQueue* TaskQueue::first_runnable_sub_queue() const
 {
     if (m_event_loop->execution_paused())
         return nullptr;
 
-    for (size_t i = 0; i < m_tasks.size(); ++i) {
-        if (m_event_loop->running_rendering_task() && m_tasks[i]->source() == Task::Source::Rendering)
-            continue;
-        if (m_tasks[i]->is_runnable())
-            return m_tasks.take(i);
+    for (auto const& sub_queues : m_sub_queues) {
+        // Within a priority, the tasks still run in the order they were added in.
+        SubQueue* oldest_sub_queue = nullptr;
+        for (auto const& it : sub_queues) {
+            auto& sub_queue = *it.value;
+            if (oldest_sub_queue && oldest_sub_queue->first().sequence_number < sub_queue.first().sequence_number)
+                continue;
+            if (sub_queue.is_runnable(*m_event_loop))
+                oldest_sub_queue = &sub_queue;
+        }
+        if (oldest_sub_queue)
+            return oldest_sub_queue;
     }
     return nullptr;
 }
 
-bool TaskQueue::has_runnable_tasks() const
+TaskQueue::Entry TaskQueue::take_first_from(SubQueue& sub_queue, Task::Priority priority)
 {
-    if (m_event_loop->execution_paused())
-        return false;
-
-    for (auto& task : m_tasks) {
-        if (m_event_loop->running_rendering_task() && task->source() == Task::Source::Rendering)
-            continue;
-        if (task->is_runnable())
-            return true;
+    auto entry = sub_queue.take_first();
+    if (sub_queue.is_empty()) {
+        auto key = sub_queue.key;
+        m_sub_queues[to_underlying(priority)].remove(key);
     }
-    return false;
+
+    --m_size;
+    if (entry.task->source() == Task::Source::Rendering)
+        --m_rendering_task_count;
+    if (m_last_added_task == entry.task)
+        m_last_added_task = nullptr;
+
+    auto& metrics = m_metrics[to_underlying(priority)];
+    --metrics.queued_tasks;
+    ++metrics.taken_tasks;
+    auto wait_time = MonotonicTime::now() - entry.enqueue_time;
+    metrics.total_wait_time += wait_time;
+    metrics.longest_wait_time = max(metrics.longest_wait_time, wait_time);
+    return entry;
 }
 
-void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
+GC::Ptr<Task> TaskQueue::take_first_runnable()
 {
-    m_tasks.remove_all_matching([&](auto& task) {
-        return filter(*task);
-    });
+    auto* sub_queue = first_runnable_sub_queue();
+    if (!sub_queue)
+        return nullptr;
+    return take_first_from(*sub_queue, sub_queue->first().task->priority()).task;
 }
 
-GC::RootVector<GC::Ref<Task>> TaskQueue::take_tasks_matching(Function<bool(HTML::Task const&)> filter)
+bool TaskQueue::has_runnable_tasks() const
 {
-    GC::RootVector<GC::Ref<Task>> matching_tasks(heap());
-
-    for (size_t i = 0; i < m_tasks.size();) {
-        auto& task = m_tasks.at(i);
+    return first_runnable_sub_queue() != nullptr;
+}
 
-        if (filter(*task)) {
-            matching_tasks.append(task);
-            m_tasks.remove(i);
-        } else {
-            ++i;
+GC::Ptr<Task> TaskQueue::dequeue()
+{
+    // NOTE: This takes the oldest task, whether it is runnable or not.
+    SubQueue* oldest_sub_queue = nullptr;
+    for (auto const& sub_queues : m_sub_queues) {
+        for (auto const& it : sub_queues) {
+            if (!oldest_sub_queue || it.value->first().sequence_number < oldest_sub_queue->first().sequence_number)
+                oldest_sub_queue = it.value.ptr();
         }
     }
-
-    return matching_tasks;
+    if (!oldest_sub_queue)
+        return nullptr;
+    return take_first_from(*oldest_sub_queue, oldest_sub_queue->first().task->priority()).task;
 }
 
-Task const* TaskQueue::last_added_task() const
+void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
-    if (m_tasks.is_empty())
-        return nullptr;
-    return m_tasks.last();
+    (void)take_tasks_matching(move(filter));
 }
 
-bool TaskQueue::has_rendering_tasks() const
+GC::RootVector<GC::Ref<Task>> TaskQueue::take_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
-    for (auto const& task : m_tasks) {
+    // NOTE: The matching tasks stay in their queues (and thus visited) until they are all in the root vector.
+    Vector<Entry> matching_entries;
+    for (auto const& sub_queues : m_sub_queues) {
+        for (auto const& it : sub_queues) {
+            auto const& sub_queue = *it.value;
+            for (size_t i = sub_queue.first_entry_index; i < sub_queue.entries.size(); ++i) {
+                if (filter(*sub_queue.entries[i].task))
+                    matching_entries.append(sub_queue.entries[i]);
+            }
+        }
+    }
+
+    GC::RootVector<GC::Ref<Task>> matching_tasks(heap());
+    if (matching_entries.is_empty())
+        return matching_tasks;
+
+    quick_sort(matching_entries, [](auto const& a, auto const& b) {
+        return a.sequence_number < b.sequence_number;
+    });
+    HashTable<u64> matching_sequence_numbers;
+    for (auto const& entry : matching_entries) {
+        matching_tasks.append(entry.task);
+        matching_sequence_numbers.set(entry.sequence_number);
+    }
+
+    for (size_t priority = 0; priority < Task::priority_count; ++priority) {
+        auto& metrics = m_metrics[priority];
+        m_sub_queues[priority].remove_all_matching([&](auto const&, auto const& sub_queue) {
+            sub_queue->entries.remove(0, sub_queue->first_entry_index);
+            sub_queue->first_entry_index = 0;
+            sub_queue->entries.remove_all_matching([&](auto const& entry) {
+                if (!matching_sequence_numbers.contains(entry.sequence_number))
+                    return false;
+                --metrics.queued_tasks;
+                return true;
+            });
+            return sub_queue->is_empty();
+        });
+    }
+
+    m_size -= matching_tasks.size();
+    for (auto const& task : matching_tasks) {
         if (task->source() == Task::Source::Rendering)
-            return true;
+            --m_rendering_task_count;
+        if (m_last_added_task == task)
+            m_last_added_task = nullptr;
     }
-    return false;
+
+    return matching_tasks;
 }
 
 }
@@ -6,47 +6,100 @@
 
 #pragma once
 
-#include <AK/Queue.h>
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
 
 namespace Web::HTML {
 
+// NOTE: Tasks are kept in one FIFO queue per priority and document (with rendering tasks in queues of their own), since
+//       all the tasks in such a queue are runnable or not at the same time. Finding the next runnable task then only
+//       has to look at the first task in each queue, however many tasks there are.
 class TaskQueue : public JS::Cell {
     GC_CELL(TaskQueue, JS::Cell);
     GC_DECLARE_ALLOCATOR(TaskQueue);
 
 public:
+    struct Metrics {
+        size_t queued_tasks { 0 };
+        size_t peak_queued_tasks { 0 };
+        u64 taken_tasks { 0 };
+        AK::Duration total_wait_time;
+        AK::Duration longest_wait_time;
+    };
+
     explicit TaskQueue(HTML::EventLoop&);
     virtual ~TaskQueue() override;
 
-    bool is_empty() const { return m_tasks.is_empty(); }
+    bool is_empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
 
     bool has_runnable_tasks() const;
-    bool has_rendering_tasks() const;
+    bool has_rendering_tasks() const { return m_rendering_task_count > 0; }
 
     void add(GC::Ref<HTML::Task>);
     GC::Ptr<HTML::Task> take_first_runnable();
 
     void enqueue(GC::Ref<HTML::Task> task) { add(task); }
-    GC::Ptr<HTML::Task> dequeue()
-    {
-        if (m_tasks.is_empty())
-            return {};
-        return m_tasks.take_first();
-    }
+    GC::Ptr<HTML::Task> dequeue();
 
     void remove_tasks_matching(Function<bool(HTML::Task const&)>);
     GC::RootVector<GC::Ref<Task>> take_tasks_matching(Function<bool(HTML::Task const&)>);
 
-    Task const* last_added_task() const;
+    Task const* last_added_task() const { return m_last_added_task; }
+
+    // How many tasks of the given priority are queued, and how long the ones taken so far have waited to run.
+    Metrics const& metrics(Task::Priority priority) const { return m_metrics[to_underlying(priority)]; }
 
 private:
+    struct Entry {
+        GC::Ref<Task> task;
+        u64 sequence_number { 0 };
+        MonotonicTime enqueue_time;
+    };
+
+    struct SubQueueKey {
+        DOM::Document const* document { nullptr };
+        bool is_rendering { false };
+
+        bool operator==(SubQueueKey const&) const = default;
+    };
+
+    struct SubQueueKeyTraits : public DefaultTraits<SubQueueKey> {
+        static unsigned hash(SubQueueKey const& key) { return pair_int_hash(ptr_hash(key.document), key.is_rendering); }
+    };
+
+    struct SubQueue {
+        bool is_empty() const { return first_entry_index == entries.size(); }
+        Entry const& first() const { return entries[first_entry_index]; }
+        Entry take_first();
+        bool is_runnable(EventLoop const&) const;
+
+        SubQueueKey key;
+        Vector<Entry> entries;
+        size_t first_entry_index { 0 };
+    };
+
+    using SubQueues = HashMap<SubQueueKey, NonnullOwnPtr<SubQueue>, SubQueueKeyTraits>;
+
     virtual void visit_edges(Visitor&) override;
 
+    SubQueue* first_runnable_sub_queue() const;
+    Entry take_first_from(SubQueue&, Task::Priority);
+
     GC::Ref<HTML::EventLoop> m_event_loop;
 
-    Vector<GC::Ref<HTML::Task>> m_tasks;
+    Array<SubQueues, Task::priority_count> m_sub_queues;
+    Array<Metrics, Task::priority_count> m_metrics;
+
+    size_t m_size { 0 };
+    size_t m_rendering_task_count { 0 };
+    u64 m_next_sequence_number { 0 };
+    GC::Ptr<Task> m_last_added_task;
 };
 
 }
@@ -74,6 +74,7 @@ GC::Ptr<DOM::HTMLCollection> const& HTMLFieldSetElement::elements()
                 || is<HTMLSelectElement>(element)
                 || is<HTMLTextAreaElement>(element);
         });
+        m_elements->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return m_elements;
 }
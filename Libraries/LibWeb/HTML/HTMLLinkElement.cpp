@@ -737,12 +737,13 @@ void HTMLLinkElement::preload(LinkProcessingOptions& options, GC::Ptr<GC::Functi
     controller_holder->set_controller(*m_fetch_controller);
 
     // 12. Let commit be the following steps given a Document document:
-    auto commit = GC::Function<void(DOM::Document&)>::create(realm.heap(), [entry, report_timing](DOM::Document& document) {
+    auto commit = GC::Function<void(DOM::Document&)>::create(realm.heap(), [entry, key = move(key), report_timing](DOM::Document& document) {
         // 1. If entry's response is not null, then call reportTiming given document.
         if (entry->response)
             report_timing->function()(document);
 
-        // FIXME: 2. Set document's map of preloaded resources[key] to entry.
+        // 2. Set document's map of preloaded resources[key] to entry.
+        document.map_of_preloaded_resources().set(key, entry);
     });
 
     // 13. If options's document is null, then set options's on document ready to commit. Otherwise, call commit with
@@ -1033,27 +1034,6 @@ void HTMLLinkElement::LinkProcessingOptions::visit_edges(Cell::Visitor& visitor)
     visitor.visit(on_document_ready);
 }
 
-// https://html.spec.whatwg.org/multipage/links.html#create-a-preload-key
-HTMLLinkElement::PreloadKey HTMLLinkElement::PreloadKey::create(Fetch::Infrastructure::Request const& request)
-{
-    // To create a preload key for a request request, return a new preload key whose URL is request's URL, destination
-    // is request's destination, mode is request's mode, and credentials mode is request's credentials mode.
-    return PreloadKey {
-        .url = request.url(),
-        .destination = request.destination(),
-        .mode = request.mode(),
-        .credentials_mode = request.credentials_mode(),
-    };
-}
-
-void HTMLLinkElement::PreloadEntry::visit_edges(Cell::Visitor& visitor)
-{
-    Base::visit_edges(visitor);
-    visitor.visit(response);
-    visitor.visit(on_response_available);
-}
-
 GC_DEFINE_ALLOCATOR(HTMLLinkElement::LinkProcessingOptions);
-GC_DEFINE_ALLOCATOR(HTMLLinkElement::PreloadEntry);
 
 }
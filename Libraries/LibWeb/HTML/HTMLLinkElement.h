@@ -15,6 +15,7 @@
 #include <LibWeb/Forward.h>
 #include <LibWeb/HTML/CORSSettingAttribute.h>
 #include <LibWeb/HTML/HTMLElement.h>
+#include <LibWeb/HTML/Preload.h>
 
 namespace Web::HTML {
 
@@ -127,47 +128,6 @@ private:
         Fetch::Infrastructure::Request::Priority fetch_priority { Fetch::Infrastructure::Request::Priority::Auto };
     };
 
-    // https://html.spec.whatwg.org/multipage/links.html#preload-key
-    struct PreloadKey {
-        static PreloadKey create(Fetch::Infrastructure::Request const&);
-
-        // URL
-        //     A URL
-        URL::URL url;
-
-        // destination
-        //     A string
-        Optional<Fetch::Infrastructure::Request::Destination> destination;
-
-        // mode
-        //     A request mode, either "same-origin", "cors", or "no-cors"
-        Fetch::Infrastructure::Request::Mode mode;
-
-        // credentials mode
-        //     A credentials mode
-        Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
-    };
-
-    // https://html.spec.whatwg.org/multipage/links.html#preload-entry
-    struct PreloadEntry final : public JS::Cell {
-        GC_CELL(PreloadEntry, JS::Cell);
-        GC_DECLARE_ALLOCATOR(PreloadEntry);
-
-        virtual void visit_edges(Cell::Visitor& visitor) override;
-
-        // integrity metadata
-        //     A string
-        String integrity_metadata;
-
-        // response
-        //     Null or a response
-        GC::Ptr<Fetch::Infrastructure::Response> response;
-
-        // on response available
-        //     Null, or an algorithm accepting a response or null
-        GC::Ptr<GC::Function<void(GC::Ptr<Fetch::Infrastructure::Response>)>> on_response_available;
-    };
-
     HTMLLinkElement(DOM::Document&, DOM::QualifiedName);
 
     virtual void initialize(JS::Realm&) override;
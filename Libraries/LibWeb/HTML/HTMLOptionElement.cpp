@@ -97,6 +97,7 @@ void HTMLOptionElement::set_selected_internal(bool selected)
         m_selectedness_update_index = m_next_selectedness_update_index++;
 
     // this is here to invalidate the cache on the HTMLCollection in HTMLSelectElement::selected_options
+    did_change_subtree(DOM::SubtreeChange::Attributes);
     document().bump_dom_tree_version();
 }
 
@@ -134,6 +134,7 @@ GC::Ptr<HTMLOptionsCollection> const& HTMLSelectElement::options() const
             auto const* maybe_option = as_if<HTML::HTMLOptionElement>(element);
             return maybe_option && maybe_option->nearest_select_element() == this;
         });
+        m_options->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return m_options;
 }
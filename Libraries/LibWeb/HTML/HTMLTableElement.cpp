@@ -367,6 +367,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableElement::t_bodies()
         m_t_bodies = DOM::HTMLCollection::create(*this, DOM::HTMLCollection::Scope::Children, [](DOM::Element const& element) {
             return element.local_name() == TagNames::tbody;
         });
+        m_t_bodies->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return *m_t_bodies;
 }
@@ -439,6 +440,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableElement::rows()
                     return prio_a < prio_b;
 
                 return false; });
+        m_rows->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return *m_rows;
 }
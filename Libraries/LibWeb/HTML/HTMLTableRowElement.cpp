@@ -89,6 +89,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableRowElement::cells() const
         m_cells = DOM::HTMLCollection::create(const_cast<HTMLTableRowElement&>(*this), DOM::HTMLCollection::Scope::Children, [](Element const& element) {
             return is<HTMLTableCellElement>(element);
         });
+        m_cells->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return *m_cells;
 }
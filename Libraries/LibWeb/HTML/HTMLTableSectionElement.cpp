@@ -51,6 +51,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableSectionElement::rows() const
         m_rows = DOM::HTMLCollection::create(const_cast<HTMLTableSectionElement&>(*this), DOM::HTMLCollection::Scope::Children, [](Element const& element) {
             return is<HTMLTableRowElement>(element);
         });
+        m_rows->set_dependencies(DOM::LiveCollectionDependencies::Structure);
     }
     return *m_rows;
 }
@@ -7,6 +7,7 @@
  */
 
 #include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/MediaQuery.h>
 #include <LibWeb/CSS/SystemColor.h>
 #include <LibWeb/CSS/VisualViewport.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
@@ -25,6 +26,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
 #include <LibWeb/FileAPI/File.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
 #include <LibWeb/HTML/DocumentState.h>
@@ -324,6 +326,11 @@ void Navigable::activate_history_entry(GC::Ptr<SessionHistoryEntry> entry)
     // 4. Set navigable's active session history entry to entry.
     m_active_session_history_entry = entry;
 
+    // AD-HOC: If newDocument comes out of the back/forward cache, the cache has to let go of it (and put the navigables of
+    //         its iframes back) before it becomes active again.
+    if (is_traversable())
+        as<TraversableNavigable>(*this).back_forward_cache().did_restore(*new_document);
+
     // 5. Make active newDocument.
     new_document->make_active();
 
@@ -2508,7 +2515,8 @@ void Navigable::set_viewport_size(CSSPixelSize size)
     if (auto document = active_document()) {
         // NOTE: Resizing the viewport changes the reference value for viewport-relative CSS lengths.
         document->invalidate_style(DOM::StyleInvalidationReason::NavigableSetViewportSize);
-        document->set_needs_media_query_evaluation();
+        // NOTE: Browser zoom is applied through the viewport size as well, so the resolution may have changed too.
+        document->set_needs_media_query_evaluation(CSS::MediaFeatureDependencies::Viewport | CSS::MediaFeatureDependencies::Resolution);
         if (auto layout_node = document->layout_node())
             layout_node->set_needs_layout_update(DOM::SetNeedsLayoutReason::NavigableSetViewportSize);
     }
@@ -2556,7 +2564,13 @@ bool Navigable::has_a_rendering_opportunity() const
     // or whether its active document's visibility state is "visible".
     // Rendering opportunities typically occur at regular intervals.
 
-    // FIXME: Return `false` here if we're an inactive browser tab.
+    // NOTE: Hidden documents don't get rendered (nor run their animation frame callbacks) anyway, so don't wake up to
+    //       queue rendering tasks for them.
+    if (BackgroundThrottlingPolicy::the().enabled) {
+        if (auto document = active_document(); document && document->hidden())
+            return false;
+    }
+
     return is_ready_to_paint();
 }
 
@@ -5,6 +5,7 @@
  */
 
 #include <LibGC/Heap.h>
+#include <LibGC/HeapVector.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
@@ -1447,6 +1448,68 @@ void Navigation::initialize_the_navigation_api_entries_for_a_new_document(Vector
     m_current_entry_index = get_the_navigation_api_entry_index(*initial_she);
 }
 
+// https://html.spec.whatwg.org/multipage/nav-history-apis.html#update-the-navigation-api-entries-for-reactivation
+void Navigation::update_the_navigation_api_entries_for_reactivation(Vector<GC::Ref<SessionHistoryEntry>> const& new_shes, GC::Ref<SessionHistoryEntry> reactivated_she)
+{
+    auto& realm = relevant_realm(*this);
+
+    // 1. If navigation has entries and events disabled, then return.
+    if (has_entries_and_events_disabled())
+        return;
+
+    // 2. Let newNHEs be a new empty list.
+    GC::RootVector<GC::Ref<NavigationHistoryEntry>> new_nhes(heap());
+
+    // 3. Let oldNHEs be a clone of navigation's entry list.
+    // NOTE: The entries left in oldNHEs are only kept alive by it until they have been disposed of.
+    auto old_nhes_vector = heap().allocate<GC::HeapVector<GC::Ref<NavigationHistoryEntry>>>();
+    auto& old_nhes = old_nhes_vector->elements();
+    old_nhes = m_entry_list;
+
+    // 4. For each newSHE of newSHEs:
+    for (auto const& new_she : new_shes) {
+        // 1. Let newNHE be null.
+        GC::Ptr<NavigationHistoryEntry> new_nhe;
+
+        // 2. If oldNHEs contains a NavigationHistoryEntry matchingOldNHE whose session history entry is newSHE, then:
+        auto matching_old_nhe = old_nhes.find_first_index_if([&](auto const& old_nhe) {
+            return &old_nhe->session_history_entry() == new_she.ptr();
+        });
+        if (matching_old_nhe.has_value()) {
+            // 1. Set newNHE to matchingOldNHE.
+            new_nhe = old_nhes[*matching_old_nhe];
+
+            // 2. Remove matchingOldNHE from oldNHEs.
+            old_nhes.remove(*matching_old_nhe);
+        }
+        // 3. Otherwise:
+        else {
+            // 1. Set newNHE to a new NavigationHistoryEntry created in the relevant realm of navigation.
+            // 2. Set newNHE's session history entry to newSHE.
+            new_nhe = NavigationHistoryEntry::create(realm, new_she);
+        }
+
+        // 4. Append newNHE to newNHEs.
+        new_nhes.append(*new_nhe);
+    }
+
+    // 5. Set navigation's entry list to newNHEs.
+    m_entry_list.clear_with_capacity();
+    m_entry_list.extend(new_nhes);
+
+    // 6. Set navigation's current entry index to the result of getting the navigation API entry index of reactivatedSHE within navigation.
+    m_current_entry_index = get_the_navigation_api_entry_index(reactivated_she);
+
+    // 7. Queue a global task on the navigation and traversal task source given navigation's relevant global object to run the following steps:
+    queue_global_task(Task::Source::NavigationAndTraversal, relevant_global_object(*this), GC::create_function(heap(), [&realm, old_nhes_vector] {
+        // 1. For each disposedNHE of oldNHEs:
+        for (auto& disposed_nhe : old_nhes_vector->elements()) {
+            // 1. Fire an event named dispose at disposedNHE.
+            disposed_nhe->dispatch_event(DOM::Event::create(realm, EventNames::dispose, {}));
+        }
+    }));
+}
+
 // https://html.spec.whatwg.org/multipage/nav-history-apis.html#update-the-navigation-api-entries-for-a-same-document-navigation
 // https://whatpr.org/html/9893/nav-history-apis.html#update-the-navigation-api-entries-for-a-same-document-navigation
 void Navigation::update_the_navigation_api_entries_for_a_same_document_navigation(GC::Ref<SessionHistoryEntry> destination_she, Bindings::NavigationType navigation_type)
@@ -10,7 +10,9 @@
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
 #include <AK/Utf32View.h>
+#include <LibGC/WeakInlines.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
@@ -48,6 +50,7 @@
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/MathML/TagNames.h>
 #include <LibWeb/Namespace.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/SVG/SVGScriptElement.h>
 #include <LibWeb/SVG/TagNames.h>
 
@@ -57,6 +60,14 @@
 
 namespace Web::HTML {
 
+// How long a document that's parsed incrementally is parsed for, before the event loop gets to run other tasks.
+static constexpr auto parsing_slice_duration = AK::Duration::from_milliseconds(50);
+
+// OPTIMIZATION: Looking at the clock for every token would cost more than parsing most of them.
+static constexpr size_t tokens_between_slice_deadline_checks = 256;
+
+static constexpr size_t minimum_input_size_to_decode_off_main_thread = 64 * KiB;
+
 GC_DEFINE_ALLOCATOR(HTMLParser);
 
 static inline void log_parse_error(SourceLocation const& location = SourceLocation::current())
@@ -159,7 +170,12 @@ static bool is_html_integration_point(DOM::Element const& element)
 }
 
 HTMLParser::HTMLParser(DOM::Document& document, StringView input, StringView encoding)
-    : m_tokenizer(input, encoding)
+    : HTMLParser(document, HTMLTokenizer::decode_input(input, encoding), encoding)
+{
+}
+
+HTMLParser::HTMLParser(DOM::Document& document, HTMLTokenizer::DecodedInput decoded_input, StringView encoding)
+    : m_tokenizer(move(decoded_input))
     , m_scripting_enabled(document.is_scripting_enabled())
     , m_document(document)
 {
@@ -223,39 +239,10 @@ void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point
 
         dbgln_if(HTML_PARSER_DEBUG, "[{}] {}", insertion_mode_name(), token.to_string());
 
-        if (m_next_line_feed_can_be_ignored) {
-            m_next_line_feed_can_be_ignored = false;
-            if (token.is_character() && token.code_point() == '\n') {
-                continue;
-            }
-        }
-
-        // https://html.spec.whatwg.org/multipage/parsing.html#tree-construction-dispatcher
-        // As each token is emitted from the tokenizer, the user agent must follow the appropriate steps from the following list, known as the tree construction dispatcher:
-        if (m_stack_of_open_elements.is_empty()
-            || adjusted_current_node()->namespace_uri() == Namespace::HTML
-            || (is_mathml_text_integration_point(*adjusted_current_node()) && token.is_start_tag() && token.tag_name() != MathML::TagNames::mglyph && token.tag_name() != MathML::TagNames::malignmark)
-            || (is_mathml_text_integration_point(*adjusted_current_node()) && token.is_character())
-            || (adjusted_current_node()->namespace_uri() == Namespace::MathML && adjusted_current_node()->local_name() == MathML::TagNames::annotation_xml && token.is_start_tag() && token.tag_name() == SVG::TagNames::svg)
-            || (is_html_integration_point(*adjusted_current_node()) && (token.is_start_tag() || token.is_character()))
-            || token.is_end_of_file()) {
-            // -> If the stack of open elements is empty
-            // -> If the adjusted current node is an element in the HTML namespace
-            // -> If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
-            // -> If the adjusted current node is a MathML text integration point and the token is a character token
-            // -> If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
-            // -> If the adjusted current node is an HTML integration point and the token is a start tag
-            // -> If the adjusted current node is an HTML integration point and the token is a character token
-            // -> If the token is an end-of-file token
-
-            // Process the token according to the rules given in the section corresponding to the current insertion mode in HTML content.
-            process_using_the_rules_for(m_insertion_mode, token);
-        } else {
-            // -> Otherwise
-
-            // Process the token according to the rules given in the section for parsing tokens in foreign content.
-            process_using_the_rules_for_foreign_content(token);
-        }
+        if (token.is_character_run())
+            process_character_run(token);
+        else
+            process_token(token);
 
         if (token.is_end_of_file() && m_tokenizer.is_eof_inserted())
             break;
@@ -264,6 +251,16 @@ void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point
             dbgln_if(HTML_PARSER_DEBUG, "Stop parsing{}! :^)", m_parsing_fragment ? " fragment" : "");
             break;
         }
+
+        // NOTE: Only the outermost invocation of the parser can return to the event loop, not one for document.write()
+        //       or while a script is being executed.
+        if (m_slice_deadline.has_value() && m_script_nesting_level == 0 && --m_tokens_until_slice_deadline_check == 0) {
+            m_tokens_until_slice_deadline_check = tokens_between_slice_deadline_checks;
+            if (MonotonicTime::now() >= *m_slice_deadline) {
+                m_did_reach_slice_deadline = true;
+                break;
+            }
+        }
     }
 
     flush_character_insertions();
@@ -271,6 +268,84 @@ void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point
     m_tokenizer.parser_did_run({});
 }
 
+void HTMLParser::process_token(HTMLToken& token)
+{
+    if (m_next_line_feed_can_be_ignored) {
+        m_next_line_feed_can_be_ignored = false;
+        if (token.is_character() && token.code_point() == '\n') {
+            return;
+        }
+    }
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#tree-construction-dispatcher
+    // As each token is emitted from the tokenizer, the user agent must follow the appropriate steps from the following list, known as the tree construction dispatcher:
+    if (m_stack_of_open_elements.is_empty()
+        || adjusted_current_node()->namespace_uri() == Namespace::HTML
+        || (is_mathml_text_integration_point(*adjusted_current_node()) && token.is_start_tag() && token.tag_name() != MathML::TagNames::mglyph && token.tag_name() != MathML::TagNames::malignmark)
+        || (is_mathml_text_integration_point(*adjusted_current_node()) && token.is_character())
+        || (adjusted_current_node()->namespace_uri() == Namespace::MathML && adjusted_current_node()->local_name() == MathML::TagNames::annotation_xml && token.is_start_tag() && token.tag_name() == SVG::TagNames::svg)
+        || (is_html_integration_point(*adjusted_current_node()) && (token.is_start_tag() || token.is_character()))
+        || token.is_end_of_file()) {
+        // -> If the stack of open elements is empty
+        // -> If the adjusted current node is an element in the HTML namespace
+        // -> If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
+        // -> If the adjusted current node is a MathML text integration point and the token is a character token
+        // -> If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
+        // -> If the adjusted current node is an HTML integration point and the token is a start tag
+        // -> If the adjusted current node is an HTML integration point and the token is a character token
+        // -> If the token is an end-of-file token
+
+        // Process the token according to the rules given in the section corresponding to the current insertion mode in HTML content.
+        process_using_the_rules_for(m_insertion_mode, token);
+    } else {
+        // -> Otherwise
+
+        // Process the token according to the rules given in the section for parsing tokens in foreign content.
+        process_using_the_rules_for_foreign_content(token);
+    }
+}
+
+// OPTIMIZATION: A character run stands for a character token for each of its code points. Where all of them would just
+//               be inserted, insert them at once; otherwise, process them one at a time.
+void HTMLParser::process_character_run(HTMLToken const& token)
+{
+    auto characters = token.character_run().utf16_view();
+
+    if (m_next_line_feed_can_be_ignored) {
+        m_next_line_feed_can_be_ignored = false;
+        if (characters.code_unit_at(0) == '\n')
+            characters = characters.substring_view(1);
+    }
+
+    // NOTE: The tree construction dispatcher would process these using the rules for the current insertion mode.
+    auto is_in_html_content = !m_stack_of_open_elements.is_empty() && adjusted_current_node()->namespace_uri() == Namespace::HTML;
+
+    if (is_in_html_content && m_insertion_mode == InsertionMode::Text) {
+        insert_characters(characters);
+        return;
+    }
+
+    // NOTE: A run never contains U+0000 NULL, so each of its characters is either whitespace or any other character.
+    if (is_in_html_content && m_insertion_mode == InsertionMode::InBody) {
+        // NOTE: Once the active formatting elements are reconstructed, doing so again before the next character does
+        //       nothing, as inserting characters doesn't change the stack of open elements.
+        reconstruct_the_active_formatting_elements();
+        insert_characters(characters);
+        for (auto code_point : characters) {
+            if (!first_is_one_of(code_point, '\t', '\n', '\f', '\r', ' ')) {
+                m_frameset_ok = false;
+                break;
+            }
+        }
+        return;
+    }
+
+    for (auto code_point : characters) {
+        auto character_token = HTMLToken::make_character(code_point);
+        process_token(character_token);
+    }
+}
+
 void HTMLParser::run(URL::URL const& url, HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
     m_document->set_url(url);
@@ -279,6 +354,83 @@ void HTMLParser::run(URL::URL const& url, HTMLTokenizer::StopAtInsertionPoint st
     the_end(*m_document, this);
 }
 
+void HTMLParser::parse_document_incrementally(DOM::Document& document, ByteBuffer input, Optional<MimeSniff::MimeType> maybe_mime_type, URL::URL const& url)
+{
+    // NOTE: Encoding sniffing creates DOM objects, so it has to happen here. It only looks at the start of the input.
+    ByteString encoding;
+    if (document.has_encoding()) {
+        encoding = document.encoding().value().to_byte_string();
+    } else {
+        encoding = run_encoding_sniffing_algorithm(document, input, maybe_mime_type);
+        dbgln_if(HTML_PARSER_DEBUG, "The encoding sniffing algorithm returned encoding '{}'", encoding);
+    }
+
+    document.set_url(url);
+
+    // OPTIMIZATION: Handing a small document to another thread takes longer than decoding it right here.
+    if (input.size() < minimum_input_size_to_decode_off_main_thread) {
+        auto parser = document.realm().create<HTMLParser>(document, HTMLTokenizer::decode_input(input, encoding), encoding);
+        parser->start_parsing_incrementally();
+        return;
+    }
+
+    // NOTE: The parser is created before its input is decoded, so that it's already the document's active parser. If the
+    //       document is aborted or destroyed in the meantime, e.g. because it was navigated away from, so is the parser,
+    //       and it's never started.
+    auto parser = document.realm().create<HTMLParser>(document, HTMLTokenizer::DecodedInput {}, encoding);
+
+    // NOTE: Nothing that is handed to the background thread may be shared with the main thread, nor may it hold on to
+    //       GC objects. So the background thread only gets its own copy of the encoding, and the parser waits here. It's
+    //       only weakly referenced, so that waiting for its input doesn't keep a discarded document alive.
+    static HashMap<u64, GC::Weak<HTMLParser>> parsers_waiting_for_input;
+    static u64 next_id = 0;
+
+    auto id = ++next_id;
+    parsers_waiting_for_input.set(id, parser);
+
+    (void)Threading::BackgroundAction<HTMLTokenizer::DecodedInput>::construct(
+        [input = move(input), encoding = ByteString { encoding.view() }](auto&) -> ErrorOr<HTMLTokenizer::DecodedInput> {
+            return HTMLTokenizer::decode_input(input, encoding);
+        },
+        [id](HTMLTokenizer::DecodedInput decoded_input) -> ErrorOr<void> {
+            auto parser = parsers_waiting_for_input.take(id).release_value();
+            if (!parser || parser->aborted() || parser->m_document->has_been_destroyed())
+                return {};
+            parser->m_tokenizer.set_decoded_input(move(decoded_input));
+            parser->start_parsing_incrementally();
+            return {};
+        });
+}
+
+void HTMLParser::start_parsing_incrementally()
+{
+    m_document->set_source(m_tokenizer.source());
+    run_next_slice();
+}
+
+void HTMLParser::run_next_slice()
+{
+    // NOTE: The parser may have been aborted while it was waiting for its next slice, e.g. by document.open().
+    if (m_aborted)
+        return;
+
+    m_slice_deadline = MonotonicTime::now() + parsing_slice_duration;
+    m_tokens_until_slice_deadline_check = tokens_between_slice_deadline_checks;
+    m_did_reach_slice_deadline = false;
+    run();
+    m_slice_deadline = {};
+
+    if (m_did_reach_slice_deadline) {
+        // NOTE: This stands in for the networking task source delivering the next chunk of the input.
+        Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(heap(), [parser = GC::Ref { *this }] {
+            parser->run_next_slice();
+        }));
+        return;
+    }
+
+    the_end(*m_document, this);
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end(GC::Ref<DOM::Document> document, GC::Ptr<HTMLParser> parser)
 {
@@ -1475,6 +1627,18 @@ void HTMLParser::insert_character(u32 data)
     m_character_insertion_builder.append_code_point(data);
 }
 
+void HTMLParser::insert_characters(Utf16View const& characters)
+{
+    if (characters.is_empty())
+        return;
+    auto node = find_character_insertion_node();
+    if (node != m_character_insertion_node.ptr()) {
+        flush_character_insertions();
+        m_character_insertion_node = node;
+    }
+    m_character_insertion_builder.append(characters);
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-after-head-insertion-mode
 void HTMLParser::handle_after_head(HTMLToken& token)
 {
@@ -3408,7 +3572,10 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The preload scanner stands in for the speculative HTML parser. It runs synchronously over
+                    //       the input that hasn't been parsed yet, and only starts fetches for what it finds there.
+                    m_preload_scanner.scan(*m_document, m_tokenizer);
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3427,7 +3594,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The preload scanner has finished by now, and the fetches it started carry on regardless.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4948,15 +5116,6 @@ GC::Ref<HTMLParser> HTMLParser::create_for_scripting(DOM::Document& document)
     return document.realm().create<HTMLParser>(document);
 }
 
-GC::Ref<HTMLParser> HTMLParser::create_with_uncertain_encoding(DOM::Document& document, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type)
-{
-    if (document.has_encoding())
-        return document.realm().create<HTMLParser>(document, input, document.encoding().value().to_byte_string());
-    auto encoding = run_encoding_sniffing_algorithm(document, input, maybe_mime_type);
-    dbgln_if(HTML_PARSER_DEBUG, "The encoding sniffing algorithm returned encoding '{}'", encoding);
-    return document.realm().create<HTMLParser>(document, input, encoding);
-}
-
 GC::Ref<HTMLParser> HTMLParser::create(DOM::Document& document, StringView input, StringView encoding)
 {
     return document.realm().create<HTMLParser>(document, input, encoding);
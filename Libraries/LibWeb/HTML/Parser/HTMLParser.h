@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include <AK/Time.h>
 #include <LibGfx/Color.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/Export.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
@@ -60,7 +62,10 @@ public:
     ~HTMLParser();
 
     static GC::Ref<HTMLParser> create_for_scripting(DOM::Document&);
-    static GC::Ref<HTMLParser> create_with_uncertain_encoding(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
+    // Parses a document that was loaded from the network. Large inputs are decoded on a background thread, and tree
+    // construction returns to the event loop every so often, so that the page can be rendered and respond to input
+    // while it's being parsed.
+    static void parse_document_incrementally(DOM::Document&, ByteBuffer input, Optional<MimeSniff::MimeType> maybe_mime_type, URL::URL const&);
     static GC::Ref<HTMLParser> create(DOM::Document&, StringView input, StringView encoding);
 
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
@@ -103,8 +108,12 @@ public:
 
 private:
     HTMLParser(DOM::Document&, StringView input, StringView encoding);
+    HTMLParser(DOM::Document&, HTMLTokenizer::DecodedInput, StringView encoding);
     HTMLParser(DOM::Document&);
 
+    void start_parsing_incrementally();
+    void run_next_slice();
+
     virtual void visit_edges(Cell::Visitor&) override;
     virtual void initialize(JS::Realm&) override;
 
@@ -161,9 +170,12 @@ private:
     [[nodiscard]] GC::Ptr<DOM::Element> adjusted_current_node();
     [[nodiscard]] GC::Ptr<DOM::Element> node_before_current_node();
     void insert_character(u32 data);
+    void insert_characters(Utf16View const&);
     void insert_comment(HTMLToken&);
     void reconstruct_the_active_formatting_elements();
     void close_a_p_element();
+    void process_token(HTMLToken&);
+    void process_character_run(HTMLToken const&);
     void process_using_the_rules_for(InsertionMode, HTMLToken&);
     void process_using_the_rules_for_foreign_content(HTMLToken&);
     void parse_generic_raw_text_element(HTMLToken&);
@@ -197,6 +209,7 @@ private:
     ListOfActiveFormattingElements m_list_of_active_formatting_elements;
 
     HTMLTokenizer m_tokenizer;
+    HTMLPreloadScanner m_preload_scanner;
 
     bool m_next_line_feed_can_be_ignored { false };
 
@@ -214,6 +227,11 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // Set while parsing incrementally, for the time at which run() should return to the event loop.
+    Optional<MonotonicTime> m_slice_deadline;
+    size_t m_tokens_until_slice_deadline_check { 0 };
+    bool m_did_reach_slice_deadline { false };
+
     JS::Realm& realm();
 
     GC::Ptr<DOM::Document> m_document;
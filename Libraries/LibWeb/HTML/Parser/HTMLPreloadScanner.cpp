@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/Preload.h>
+#include <LibWeb/HTML/SourceSet.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/MathML/TagNames.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+#include <LibWeb/SVG/TagNames.h>
+
+namespace Web::HTML {
+
+using Destination = Fetch::Infrastructure::Request::Destination;
+using InitiatorType = Fetch::Infrastructure::Request::InitiatorType;
+
+static bool rel_contains(Optional<String> const& rel, StringView keyword)
+{
+    if (!rel.has_value())
+        return false;
+    for (auto part : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+        if (part.equals_ignoring_ascii_case(keyword))
+            return true;
+    }
+    return false;
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#translate-a-preload-destination
+static Optional<Destination> preload_destination(Optional<String> const& as)
+{
+    if (!as.has_value())
+        return {};
+    if (as->equals_ignoring_ascii_case("script"sv))
+        return Destination::Script;
+    if (as->equals_ignoring_ascii_case("style"sv))
+        return Destination::Style;
+    if (as->equals_ignoring_ascii_case("image"sv))
+        return Destination::Image;
+    if (as->equals_ignoring_ascii_case("font"sv))
+        return Destination::Font;
+    // NOTE: Other destinations aren't worth fetching speculatively.
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/scripting.html#prepare-the-script-element
+static Optional<bool> script_type_is_module(HTMLToken const& token)
+{
+    auto type = token.attribute(AttributeNames::type);
+    auto language = token.attribute(AttributeNames::language);
+
+    if ((type.has_value() && type->is_empty()) || (!type.has_value() && (!language.has_value() || language->is_empty())))
+        return false;
+    if (!type.has_value()) {
+        auto type_from_language = MUST(String::formatted("text/{}", *language));
+        if (MimeSniff::is_javascript_mime_type_essence_match(type_from_language))
+            return false;
+        return {};
+    }
+
+    auto trimmed_type = type->bytes_as_string_view().trim(Infra::ASCII_WHITESPACE);
+    if (MimeSniff::is_javascript_mime_type_essence_match(trimmed_type))
+        return false;
+    if (trimmed_type.equals_ignoring_ascii_case("module"sv))
+        return true;
+
+    // Data blocks and import maps don't fetch anything.
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/images.html#select-an-image-source
+static Optional<String> image_source(HTMLToken const& token, double device_pixel_ratio)
+{
+    auto src = token.attribute(AttributeNames::src);
+    auto srcset = token.attribute(AttributeNames::srcset);
+    if (!srcset.has_value() || srcset->is_empty())
+        return src;
+
+    auto source_set = parse_a_srcset_attribute(*srcset);
+    bool has_src_with_density_one = false;
+    for (auto const& source : source_set.m_sources) {
+        // NOTE: Selecting from width descriptors needs the sizes attribute to be resolved, which needs layout.
+        if (source.descriptor.has<ImageSource::WidthDescriptorValue>())
+            return src;
+        if (auto const* density = source.descriptor.get_pointer<ImageSource::PixelDensityDescriptorValue>(); !density || density->value == 1)
+            has_src_with_density_one = true;
+    }
+    if (src.has_value() && !src->is_empty() && !has_src_with_density_one)
+        source_set.m_sources.append({ .url = *src, .descriptor = ImageSource::PixelDensityDescriptorValue { 1 } });
+    if (source_set.is_empty())
+        return {};
+
+    // Pick the lowest density that is at least the device pixel ratio, otherwise the highest one.
+    Optional<ImageSource const&> selected_source;
+    auto density_of = [](ImageSource const& source) {
+        if (auto const* density = source.descriptor.get_pointer<ImageSource::PixelDensityDescriptorValue>())
+            return density->value;
+        return 1.0;
+    };
+    for (auto const& source : source_set.m_sources) {
+        if (!selected_source.has_value()) {
+            selected_source = source;
+            continue;
+        }
+        auto density = density_of(source);
+        auto selected_density = density_of(*selected_source);
+        if (selected_density < device_pixel_ratio ? density > selected_density : (density >= device_pixel_ratio && density < selected_density))
+            selected_source = source;
+    }
+    return selected_source->url;
+}
+
+Vector<SpeculativeFetch> HTMLPreloadScanner::find_speculative_fetches(StringView input, Options const& options)
+{
+    Vector<SpeculativeFetch> fetches;
+    HTMLTokenizer tokenizer { input, "utf-8"sv };
+
+    URL::URL base_url = options.base_url;
+    bool found_base_element = options.document_has_base_element;
+    size_t template_depth = 0;
+    size_t foreign_content_depth = 0;
+
+    auto add_fetch = [&](Optional<String> const& url_string, Optional<Destination> destination, CORSSettingAttribute cors_setting, InitiatorType initiator_type) {
+        if (!url_string.has_value() || url_string->is_empty())
+            return;
+        auto url = base_url.complete_url(url_string->bytes_as_string_view().trim(Infra::ASCII_WHITESPACE));
+        if (!url.has_value() || !url->scheme().is_one_of("http"sv, "https"sv))
+            return;
+        fetches.append({ url.release_value(), destination, cors_setting, initiator_type });
+    };
+
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_end_tag()) {
+            auto const& tag_name = token->tag_name();
+            if (tag_name == TagNames::template_ && template_depth > 0)
+                --template_depth;
+            else if ((tag_name == SVG::TagNames::svg || tag_name == MathML::TagNames::math) && foreign_content_depth > 0)
+                --foreign_content_depth;
+            continue;
+        }
+        if (!token->is_start_tag())
+            continue;
+
+        auto const& tag_name = token->tag_name();
+
+        // Switch the tokenizer to the state the tree builder would switch it to for this element.
+        // NOTE: Inside foreign content, these are just ordinary elements.
+        if (foreign_content_depth == 0) {
+            if (tag_name == TagNames::script)
+                tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+            else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)
+                || (tag_name == TagNames::noscript && options.scripting_enabled))
+                tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+            else if (tag_name.is_one_of(TagNames::textarea, TagNames::title))
+                tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+            else if (tag_name == TagNames::plaintext)
+                tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+        }
+
+        if ((tag_name == SVG::TagNames::svg || tag_name == MathML::TagNames::math) && !token->is_self_closing()) {
+            ++foreign_content_depth;
+            continue;
+        }
+        if (tag_name == TagNames::template_) {
+            ++template_depth;
+            continue;
+        }
+
+        // NOTE: Elements in template contents or foreign content don't load anything (or not as HTML elements do).
+        if (template_depth > 0 || foreign_content_depth > 0)
+            continue;
+
+        if (tag_name == TagNames::base) {
+            // Only the first base element with an href affects the document's base URL.
+            auto href = token->attribute(AttributeNames::href);
+            if (!href.has_value() || found_base_element)
+                continue;
+            found_base_element = true;
+            if (auto url = options.base_url.complete_url(*href); url.has_value() && !url->scheme().is_one_of("data"sv, "javascript"sv))
+                base_url = url.release_value();
+            continue;
+        }
+
+        if (tag_name == TagNames::script) {
+            auto is_module = script_type_is_module(*token);
+            if (!is_module.has_value() || (!*is_module && token->has_attribute(AttributeNames::nomodule)))
+                continue;
+
+            // NOTE: Module scripts are always fetched in CORS mode, with "anonymous" being the default.
+            auto cors_setting = cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin));
+            if (*is_module && cors_setting == CORSSettingAttribute::NoCORS)
+                cors_setting = CORSSettingAttribute::Anonymous;
+            add_fetch(token->attribute(AttributeNames::src), Destination::Script, cors_setting, InitiatorType::Script);
+            continue;
+        }
+
+        if (tag_name == TagNames::link) {
+            auto rel = token->attribute(AttributeNames::rel);
+            auto cors_setting = cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin));
+            auto href = token->attribute(AttributeNames::href);
+
+            if (rel_contains(rel, "stylesheet"sv) && !rel_contains(rel, "alternate"sv) && !token->has_attribute(AttributeNames::disabled)) {
+                add_fetch(href, Destination::Style, cors_setting, InitiatorType::CSS);
+            } else if (rel_contains(rel, "preload"sv)) {
+                auto destination = preload_destination(token->attribute(AttributeNames::as));
+                if (!destination.has_value())
+                    continue;
+                // NOTE: Fonts are always fetched in CORS mode.
+                if (destination == Destination::Font && cors_setting == CORSSettingAttribute::NoCORS)
+                    cors_setting = CORSSettingAttribute::Anonymous;
+                add_fetch(href, destination, cors_setting, InitiatorType::Link);
+            } else if (rel_contains(rel, "modulepreload"sv)) {
+                if (cors_setting == CORSSettingAttribute::NoCORS)
+                    cors_setting = CORSSettingAttribute::Anonymous;
+                add_fetch(href, Destination::Script, cors_setting, InitiatorType::Link);
+            }
+            continue;
+        }
+
+        if (tag_name == TagNames::img) {
+            // Lazily loaded images may never be needed.
+            if (auto loading = token->attribute(AttributeNames::loading); loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv) && options.scripting_enabled)
+                continue;
+            auto cors_setting = cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin));
+            add_fetch(image_source(*token, options.device_pixel_ratio), Destination::Image, cors_setting, InitiatorType::IMG);
+            continue;
+        }
+    }
+
+    return fetches;
+}
+
+void HTMLPreloadScanner::scan(DOM::Document& document, HTMLTokenizer const& tokenizer)
+{
+    // NOTE: Only the input in front of what has been scanned before is new. That's normally nothing, unless some of
+    //       it has been inserted with document.write() in the meantime.
+    auto unconsumed_input = tokenizer.unconsumed_input();
+    auto unscanned_length = unconsumed_input.size() > m_scanned_code_points_at_end ? unconsumed_input.size() - m_scanned_code_points_at_end : 0;
+    m_scanned_code_points_at_end = unconsumed_input.size();
+    if (unscanned_length == 0)
+        return;
+
+    StringBuilder builder;
+    for (auto code_point : unconsumed_input.trim(unscanned_length))
+        builder.append_code_point(code_point);
+
+    auto window = document.window();
+    Options options {
+        .base_url = document.base_url(),
+        .document_has_base_element = document.first_base_element_with_href_in_tree_order() != nullptr,
+        .scripting_enabled = document.is_scripting_enabled(),
+        .device_pixel_ratio = window ? window->device_pixel_ratio() : 1,
+    };
+
+    for (auto const& speculative_fetch : find_speculative_fetches(builder.string_view(), options)) {
+        if (m_fetched_urls.set(speculative_fetch.url) != HashSetResult::InsertedNewEntry)
+            continue;
+        start_speculative_fetch(document, speculative_fetch);
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void HTMLPreloadScanner::start_speculative_fetch(DOM::Document& document, SpeculativeFetch const& speculative_fetch)
+{
+    auto& realm = document.realm();
+    auto& vm = realm.vm();
+
+    auto request = create_potential_CORS_request(vm, speculative_fetch.url, speculative_fetch.destination, speculative_fetch.cors_setting);
+    request->set_client(&document.relevant_settings_object());
+    request->set_initiator_type(speculative_fetch.initiator_type);
+    // NOTE: Speculative fetches shouldn't hold up anything the page actually asked for.
+    request->set_priority(Fetch::Infrastructure::Request::Priority::Low);
+
+    // NOTE: The fetch is kept in the document's map of preloaded resources, the same way <link rel=preload> fetches
+    //       are, so that the real fetch for the same URL, destination and CORS mode adopts its response instead of
+    //       fetching it again. If it is still in flight by then, the real fetch waits for it.
+    auto entry = realm.create<PreloadEntry>();
+    auto key = PreloadKey::create(request);
+
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [&realm, entry](GC::Ref<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+        // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
+        //        https://github.com/whatwg/html/issues/9355
+        response = response->unsafe_response();
+
+        if (auto* byte_sequence = body_bytes.get_pointer<ByteBuffer>())
+            response->set_body(Fetch::Infrastructure::byte_sequence_as_body(realm, *byte_sequence));
+        else
+            response = Fetch::Infrastructure::Response::network_error(realm.vm(), "Expected speculative fetch response to contain a body"_string);
+
+        if (!entry->on_response_available)
+            entry->response = response;
+        else
+            entry->on_response_available->function()(response);
+    };
+    Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
+
+    document.map_of_preloaded_resources().set(move(key), entry);
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+
+namespace Web::HTML {
+
+// A resource that the preload scanner found a reference to.
+struct SpeculativeFetch {
+    URL::URL url;
+    Optional<Fetch::Infrastructure::Request::Destination> destination;
+    CORSSettingAttribute cors_setting { CORSSettingAttribute::NoCORS };
+    Fetch::Infrastructure::Request::InitiatorType initiator_type;
+
+    bool operator==(SpeculativeFetch const&) const = default;
+};
+
+// Stands in for the speculative HTML parser: while the HTML parser is blocked on a parser-blocking script, the rest of
+// the input is tokenized to find the scripts, style sheets and images it references, and fetches for those are started
+// right away instead of once the parser gets to them. The fetches are kept in the document's map of preloaded resources,
+// where the real fetches for the same resources pick them up.
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+class WEB_API HTMLPreloadScanner {
+public:
+    struct Options {
+        URL::URL base_url;
+        // Whether a <base> element with an href has been inserted into the document already.
+        bool document_has_base_element { false };
+        bool scripting_enabled { true };
+        double device_pixel_ratio { 1 };
+    };
+
+    static Vector<SpeculativeFetch> find_speculative_fetches(StringView input, Options const&);
+
+    // Scans the input that the parser's tokenizer hasn't consumed yet and starts a fetch for everything found there.
+    void scan(DOM::Document&, HTMLTokenizer const&);
+
+private:
+    static void start_speculative_fetch(DOM::Document&, SpeculativeFetch const&);
+
+    HashTable<URL::URL> m_fetched_urls;
+    // Everything from this many code points before the end of the input has been scanned already. Since the input
+    // only changes by inserting things at the insertion point, this stays valid when it does.
+    size_t m_scanned_code_points_at_end { 0 };
+};
+
+}
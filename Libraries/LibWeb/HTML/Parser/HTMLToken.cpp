@@ -61,7 +61,9 @@ String HTMLToken::to_string() const
 
     if (is_character()) {
         builder.append(" { data: '"sv);
-        builder.append_code_point(code_point());
+        for_each_code_point([&](u32 code_point) {
+            builder.append_code_point(code_point);
+        });
         builder.append("' }"sv);
     }
 
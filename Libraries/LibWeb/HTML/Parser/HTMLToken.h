@@ -11,6 +11,7 @@
 #include <AK/Function.h>
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
+#include <AK/Utf16String.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibWeb/Export.h>
@@ -109,10 +110,39 @@ public:
         return m_data.get<u32>();
     }
 
+    // OPTIMIZATION: The tokenizer emits a run of text that contains no markup as a single character token, which stands
+    //               for a character token for each of its code points. Such a run never contains U+0000 NULL or
+    //               U+000D CARRIAGE RETURN, and has at least two code points.
+    bool is_character_run() const { return m_data.has<Utf16String>(); }
+
+    Utf16String const& character_run() const
+    {
+        VERIFY(is_character());
+        return m_data.get<Utf16String>();
+    }
+
+    void set_character_run(Utf16String characters)
+    {
+        VERIFY(is_character());
+        m_data.set(move(characters));
+    }
+
+    template<typename Callback>
+    void for_each_code_point(Callback callback) const
+    {
+        VERIFY(is_character());
+        if (!is_character_run()) {
+            callback(code_point());
+            return;
+        }
+        for (auto code_point : character_run().utf16_view())
+            callback(code_point);
+    }
+
     bool is_parser_whitespace() const
     {
         // NOTE: The parser considers '\r' to be whitespace, while the tokenizer does not.
-        if (!is_character())
+        if (!is_character() || is_character_run())
             return false;
         switch (code_point()) {
         case '\t':
@@ -129,7 +159,7 @@ public:
     void set_code_point(u32 code_point)
     {
         VERIFY(is_character());
-        m_data.get<u32>() = code_point;
+        m_data.set(code_point);
     }
 
     String const& comment() const
@@ -368,7 +398,7 @@ private:
     // Type::Comment (comment data)
     String m_comment_data;
 
-    Variant<Empty, u32, OwnPtr<DoctypeData>, OwnPtr<Vector<Attribute>>> m_data {};
+    Variant<Empty, u32, Utf16String, OwnPtr<DoctypeData>, OwnPtr<Vector<Attribute>>> m_data {};
 
     Position m_start_position;
     Position m_end_position;
@@ -8,7 +8,11 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf32View.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
@@ -165,6 +169,35 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+// OPTIMIZATION: Text in the data and text states mostly consists of code points that are emitted as they are, so the
+//               whole run of them up to the next delimiter is emitted as a single character token, instead of going
+//               around the state machine and through the tree builder for every one of them.
+//               The run is capped in length, so that a large text node doesn't become a single token that the parser
+//               can't yield in the middle of.
+#define EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL(...)                                                             \
+    do {                                                                                                              \
+        create_new_token(HTMLToken::Type::Character);                                                                 \
+        auto run = consume_code_points_until<__VA_ARGS__>(stop_at_insertion_point, maximum_character_run_length - 1); \
+        if (run.is_empty()) {                                                                                         \
+            m_current_token.set_code_point(current_input_character.value());                                          \
+        } else {                                                                                                      \
+            StringBuilder characters { StringBuilder::Mode::UTF16, run.size() + 1 };                                  \
+            characters.append_code_point(current_input_character.value());                                            \
+            characters.append(Utf32View { run.data(), run.size() });                                                  \
+            m_current_token.set_character_run(characters.to_utf16_string());                                          \
+        }                                                                                                             \
+        m_queued_tokens.enqueue(move(m_current_token));                                                               \
+        return m_queued_tokens.dequeue();                                                                             \
+    } while (0)
+
+// OPTIMIZATION: Same as above, for the code points that are appended to attribute values as they are.
+#define APPEND_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL(...)                                     \
+    do {                                                                                        \
+        m_current_builder.append_code_point(current_input_character.value());                   \
+        for (auto code_point : consume_code_points_until<__VA_ARGS__>(stop_at_insertion_point)) \
+            m_current_builder.append_code_point(code_point);                                    \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -238,6 +271,73 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+static void advance_position(HTMLToken::Position& position, u32 code_point)
+{
+    if (code_point == '\n') {
+        position.column = 0;
+        position.line++;
+    } else {
+        position.column++;
+    }
+}
+
+// Returns the offset of the first code point at or after the given one, and before the given end, that is one of the
+// given delimiters.
+template<u32... delimiters>
+static size_t find_first_of(ReadonlySpan<u32> input, size_t offset, size_t end)
+{
+    using VectorType = AK::SIMD::u32x8;
+    static constexpr size_t lane_count = sizeof(VectorType) / sizeof(u32);
+
+    // OPTIMIZATION: Look at a whole vector of code points at once, and only at the individual ones once one of them is
+    //               a delimiter.
+    for (; offset + lane_count <= end; offset += lane_count) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(input.data() + offset);
+        auto special = (bit_cast<VectorType>(chunk == delimiters) | ...);
+
+        auto words = bit_cast<AK::SIMD::u64x4>(special);
+        if ((words[0] | words[1] | words[2] | words[3]) != 0)
+            break;
+    }
+
+    for (; offset < end; ++offset) {
+        if (((input[offset] == delimiters) || ...))
+            return offset;
+    }
+
+    return end;
+}
+
+template<u32... delimiters>
+ReadonlySpan<u32> HTMLTokenizer::consume_code_points_until(StopAtInsertionPoint stop_at_insertion_point, size_t maximum_length)
+{
+    auto end = m_decoded_input.size();
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && m_insertion_point.has_value())
+        end = min(end, static_cast<size_t>(max(*m_insertion_point, 0)));
+
+    auto start = static_cast<size_t>(m_current_offset);
+    if (start >= end)
+        return {};
+    end = start + min(end - start, maximum_length);
+
+    // NOTE: Carriage returns have to be normalized by next_code_point(), so they end the run as well.
+    auto run_end = find_first_of<delimiters..., 0, '\r'>(m_decoded_input.span(), start, end);
+    if (run_end == start)
+        return {};
+
+    auto run = m_decoded_input.span().slice(start, run_end - start);
+    if (!m_source_positions.is_empty()) {
+        auto position = m_source_positions.last();
+        for (auto code_point : run)
+            advance_position(position, code_point);
+        m_source_positions.append(position);
+    }
+
+    m_current_offset = static_cast<ssize_t>(run_end);
+    m_prev_offset = m_current_offset - 1;
+    return run;
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(ssize_t offset, StopAtInsertionPoint stop_at_insertion_point) const
 {
     auto it = m_current_offset + offset;
@@ -303,7 +403,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('&', '<');
                 }
             }
             END_STATE
@@ -1315,7 +1415,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('"', '&');
                     continue;
                 }
             }
@@ -1347,7 +1447,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('\'', '&');
                     continue;
                 }
             }
@@ -1990,7 +2090,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('&', '<');
                 }
             }
             END_STATE
@@ -2109,7 +2209,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('<');
                 }
             }
             END_STATE
@@ -2228,7 +2328,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL('<');
                 }
             }
             END_STATE
@@ -2247,7 +2347,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_CODE_POINTS_UNTIL();
                 }
             }
             END_STATE
@@ -2884,18 +2984,39 @@ HTMLTokenizer::HTMLTokenizer()
 }
 
 HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
+    : HTMLTokenizer(decode_input(input, encoding))
+{
+}
+
+HTMLTokenizer::HTMLTokenizer(DecodedInput decoded_input)
+    : m_source(move(decoded_input.source))
+    , m_decoded_input(move(decoded_input.code_points))
 {
-    auto decoder = TextCodec::decoder_for(encoding);
-    VERIFY(decoder.has_value());
-    m_source = MUST(decoder->to_utf8(input));
-    m_decoded_input.ensure_capacity(m_source.bytes().size());
-    for (auto code_point : m_source.code_points())
-        m_decoded_input.append(code_point);
     m_current_offset = 0;
     m_prev_offset = 0;
     m_source_positions.empend(0u, 0u);
 }
 
+void HTMLTokenizer::set_decoded_input(DecodedInput decoded_input)
+{
+    VERIFY(m_decoded_input.is_empty() && m_current_offset == 0);
+    m_source = move(decoded_input.source);
+    m_decoded_input = move(decoded_input.code_points);
+}
+
+HTMLTokenizer::DecodedInput HTMLTokenizer::decode_input(StringView input, StringView encoding)
+{
+    auto decoder = TextCodec::decoder_for(encoding);
+    VERIFY(decoder.has_value());
+
+    DecodedInput decoded_input;
+    decoded_input.source = MUST(decoder->to_utf8(input));
+    decoded_input.code_points.ensure_capacity(decoded_input.source.bytes().size());
+    for (auto code_point : decoded_input.source.code_points())
+        decoded_input.code_points.append(code_point);
+    return decoded_input;
+}
+
 void HTMLTokenizer::parser_did_run(Badge<HTMLParser>)
 {
     // OPTIMIZATION: If we've consumed all input and the insertion point is at the start,
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/NumericLimits.h>
 #include <AK/Queue.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
@@ -104,8 +105,20 @@ namespace Web::HTML {
 
 class WEB_API HTMLTokenizer {
 public:
+    // The input stream, decoded from the bytes of a document.
+    struct DecodedInput {
+        String source;
+        Vector<u32> code_points;
+    };
+    // NOTE: This only touches its arguments and what it returns, so it can run on any thread.
+    static DecodedInput decode_input(StringView input, StringView encoding);
+
     explicit HTMLTokenizer();
     explicit HTMLTokenizer(StringView input, ByteString const& encoding);
+    explicit HTMLTokenizer(DecodedInput);
+
+    // Sets the input stream of a tokenizer that was created before its input was decoded, and hasn't run yet.
+    void set_decoded_input(DecodedInput);
 
     enum class State {
 #define __ENUMERATE_TOKENIZER_STATE(state) state,
@@ -119,6 +132,9 @@ public:
     };
     Optional<HTMLToken> next_token(StopAtInsertionPoint = StopAtInsertionPoint::No);
 
+    // The most code points that a single character token stands for. See HTMLToken::is_character_run().
+    static constexpr size_t maximum_character_run_length = 4096;
+
     void set_parser(Badge<HTMLParser>, HTMLParser& parser) { m_parser = &parser; }
 
     void switch_to(Badge<HTMLParser>, State new_state);
@@ -132,6 +148,13 @@ public:
 
     auto const& source() const { return m_source; }
 
+    // The part of the input stream that hasn't been consumed yet.
+    ReadonlySpan<u32> unconsumed_input() const
+    {
+        auto offset = min(static_cast<size_t>(max(m_current_offset, 0)), m_decoded_input.size());
+        return m_decoded_input.span().slice(offset);
+    }
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -152,6 +175,12 @@ public:
 
 private:
     void skip(size_t count);
+
+    // Consumes the code points up to the next one of the given delimiters, U+0000 NULL, U+000D CR, the insertion point
+    // or the end of the input, whichever comes first, but no more than the given maximum, and returns them.
+    template<u32... delimiters>
+    ReadonlySpan<u32> consume_code_points_until(StopAtInsertionPoint, size_t maximum_length = NumericLimits<size_t>::max());
+
     Optional<u32> next_code_point(StopAtInsertionPoint);
     Optional<u32> peek_code_point(ssize_t offset, StopAtInsertionPoint) const;
 
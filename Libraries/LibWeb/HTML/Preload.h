@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGC/Function.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-key
+struct PreloadKey {
+    static PreloadKey create(Fetch::Infrastructure::Request const&);
+
+    // URL
+    //     A URL
+    URL::URL url;
+
+    // destination
+    //     A string
+    Optional<Fetch::Infrastructure::Request::Destination> destination;
+
+    // mode
+    //     A request mode, either "same-origin", "cors", or "no-cors"
+    Fetch::Infrastructure::Request::Mode mode;
+
+    // credentials mode
+    //     A credentials mode
+    Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
+
+    [[nodiscard]] bool operator==(PreloadKey const&) const = default;
+    [[nodiscard]] u32 hash() const;
+};
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-entry
+struct PreloadEntry final : public JS::Cell {
+    GC_CELL(PreloadEntry, JS::Cell);
+    GC_DECLARE_ALLOCATOR(PreloadEntry);
+
+    virtual void visit_edges(Cell::Visitor& visitor) override;
+
+    // integrity metadata
+    //     A string
+    String integrity_metadata;
+
+    // response
+    //     Null or a response
+    GC::Ptr<Fetch::Infrastructure::Response> response;
+
+    // on response available
+    //     Null, or an algorithm accepting a response or null
+    GC::Ptr<GC::Function<void(GC::Ptr<Fetch::Infrastructure::Response>)>> on_response_available;
+};
+
+WEB_API bool consume_a_preloaded_resource(Window&, URL::URL const&, Optional<Fetch::Infrastructure::Request::Destination>, Fetch::Infrastructure::Request::Mode, Fetch::Infrastructure::Request::CredentialsMode, StringView integrity_metadata, GC::Ref<GC::Function<void(GC::Ptr<Fetch::Infrastructure::Response>)>> on_response_available);
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Web::HTML::PreloadKey> : public DefaultTraits<Web::HTML::PreloadKey> {
+    static unsigned hash(Web::HTML::PreloadKey const& key)
+    {
+        return key.hash();
+    }
+};
+
+}
@@ -121,7 +121,9 @@ void SyntaxHighlighter::rehighlight(Palette const& palette)
             }
         } else if (state != State::HTML) {
             VERIFY(token->is_character());
-            substring_builder.append_code_point(token->code_point());
+            token->for_each_code_point([&](u32 code_point) {
+                substring_builder.append_code_point(code_point);
+            });
             continue;
         }
 
@@ -6,6 +6,8 @@
 
 #include <LibCore/Timer.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
 #include <LibWeb/HTML/Timer.h>
 #include <LibWeb/HTML/Window.h>
 
@@ -13,26 +15,30 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(Timer);
 
-GC::Ref<Timer> Timer::create(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id, Repeating repeating)
+GC::Ref<Timer> Timer::create(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id, u32 nesting_level)
 {
-    return window_or_worker_global_scope.heap().allocate<Timer>(window_or_worker_global_scope, milliseconds, move(callback), id, repeating);
+    return window_or_worker_global_scope.heap().allocate<Timer>(window_or_worker_global_scope, milliseconds, move(callback), id, nesting_level);
 }
 
-Timer::Timer(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id, Repeating repeating)
-    : m_window_or_worker_global_scope(window_or_worker_global_scope)
+Timer::Timer(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id, u32 nesting_level)
+    : m_callback(move(callback))
+    , m_window_or_worker_global_scope(window_or_worker_global_scope)
     , m_id(id)
+    , m_timeout(AK::Duration::from_milliseconds(milliseconds))
+    , m_nesting_level(nesting_level)
 {
-    if (repeating == Repeating::Yes)
-        m_timer = Core::Timer::create_repeating(milliseconds, move(callback));
-    else
-        m_timer = Core::Timer::create_single_shot(milliseconds, move(callback));
+    m_timer = Core::Timer::create_single_shot(milliseconds, [this] {
+        TimerWakeUpMetrics::the().did_fire_timer(MonotonicTime::now(), m_is_throttled);
+        m_due_time = {};
+        m_callback();
+    });
 }
 
 void Timer::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_window_or_worker_global_scope);
-    visitor.visit_possible_values(m_timer->on_timeout.raw_capture_range());
+    visitor.visit_possible_values(m_callback.raw_capture_range());
 }
 
 Timer::~Timer()
@@ -42,17 +48,73 @@ Timer::~Timer()
 
 void Timer::start()
 {
-    m_timer->start();
+    m_due_time = MonotonicTime::now() + m_timeout;
+    m_is_suspended = false;
+    schedule();
 }
 
 void Timer::stop()
 {
+    m_due_time = {};
+    m_is_suspended = false;
     m_timer->stop();
 }
 
 void Timer::set_callback(Function<void()> callback)
 {
-    m_timer->on_timeout = move(callback);
+    m_callback = move(callback);
+}
+
+void Timer::set_timeout(i32 milliseconds, u32 nesting_level)
+{
+    m_timeout = AK::Duration::from_milliseconds(milliseconds);
+    m_nesting_level = nesting_level;
+}
+
+void Timer::reschedule()
+{
+    if (!m_due_time.has_value() || !m_timer->is_active())
+        return;
+    m_timer->stop();
+    schedule();
+}
+
+void Timer::suspend()
+{
+    if (!m_due_time.has_value() || !m_timer->is_active())
+        return;
+    m_timer->stop();
+    m_is_suspended = true;
+}
+
+void Timer::resume(AK::Duration suspend_duration)
+{
+    if (!m_is_suspended)
+        return;
+    m_is_suspended = false;
+    *m_due_time += suspend_duration;
+    schedule();
+}
+
+Optional<MonotonicTime> Timer::hidden_since() const
+{
+    // NOTE: Only timers in windows are throttled; workers don't have a visibility state.
+    if (auto* window = as_if<Window>(*m_window_or_worker_global_scope))
+        return window->associated_document().hidden_since();
+    return {};
+}
+
+void Timer::schedule()
+{
+    VERIFY(m_due_time.has_value());
+
+    auto now = MonotonicTime::now();
+    auto delay = max(*m_due_time - now, AK::Duration::zero());
+    auto throttled_delay = BackgroundThrottlingPolicy::the().throttled_timer_delay(now, delay, hidden_since(), m_nesting_level);
+    m_is_throttled = throttled_delay != delay;
+
+    // NOTE: Aligning a timeout that is already close to the maximum can take it past what Core::Timer accepts.
+    m_timer->start(static_cast<int>(min(throttled_delay.to_milliseconds(), static_cast<i64>(NumericLimits<int>::max()))));
 }
 
 }
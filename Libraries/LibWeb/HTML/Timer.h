@@ -8,6 +8,7 @@
 
 #include <AK/Forward.h>
 #include <AK/Function.h>
+#include <AK/Time.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
 #include <LibGC/Function.h>
@@ -22,27 +23,43 @@ class Timer final : public JS::Cell {
     GC_DECLARE_ALLOCATOR(Timer);
 
 public:
-    enum class Repeating {
-        No,
-        Yes,
-    };
-
-    static GC::Ref<Timer> create(JS::Object&, i32 milliseconds, Function<void()> callback, i32 id, Repeating);
+    static GC::Ref<Timer> create(JS::Object&, i32 milliseconds, Function<void()> callback, i32 id, u32 nesting_level = 0);
     virtual ~Timer() override;
 
     void start();
     void stop();
 
     void set_callback(Function<void()>);
+    void set_timeout(i32 milliseconds, u32 nesting_level);
+
+    // Works out again when the timer should fire, e.g. after its document was hidden or shown.
+    void reschedule();
+
+    // Keeps the timer from firing while its document is in the back/forward cache. Once resumed, it fires as much later
+    // as it was suspended for.
+    void suspend();
+    void resume(AK::Duration suspend_duration);
 
 private:
-    Timer(JS::Object& window, i32 milliseconds, Function<void()> callback, i32 id, Repeating);
+    Timer(JS::Object& window, i32 milliseconds, Function<void()> callback, i32 id, u32 nesting_level);
 
     virtual void visit_edges(Cell::Visitor&) override;
 
+    Optional<MonotonicTime> hidden_since() const;
+    void schedule();
+
+    // NOTE: Repeating timers are started again by the timer initialization steps each time they run, so the underlying
+    //       timer is always single-shot.
     RefPtr<Core::Timer> m_timer;
+    Function<void()> m_callback;
     GC::Ref<JS::Object> m_window_or_worker_global_scope;
     i32 m_id { 0 };
+
+    AK::Duration m_timeout;
+    u32 m_nesting_level { 0 };
+    Optional<MonotonicTime> m_due_time;
+    bool m_is_throttled { false };
+    bool m_is_suspended { false };
 };
 
 }
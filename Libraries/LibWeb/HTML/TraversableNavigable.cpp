@@ -34,6 +34,7 @@ TraversableNavigable::TraversableNavigable(GC::Ref<Page> page)
     : Navigable(page, page->client().is_svg_page_client())
     , m_storage_shed(StorageAPI::StorageShed::create(page->heap()))
     , m_session_history_traversal_queue(vm().heap().allocate<SessionHistoryTraversalQueue>())
+    , m_back_forward_cache(BackForwardCache::create(*this))
 {
 }
 
@@ -47,6 +48,7 @@ void TraversableNavigable::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_session_history_entries);
     visitor.visit(m_session_history_traversal_queue);
     visitor.visit(m_storage_shed);
+    visitor.visit(m_back_forward_cache);
 }
 
 static OrderedHashTable<TraversableNavigable*>& user_agent_top_level_traversable_set()
@@ -390,8 +392,15 @@ static void deactivate_a_document_for_cross_document_navigation(GC::Ref<DOM::Doc
         // 2. Set the ongoing navigation for navigable to null.
         navigable->set_ongoing_navigation({});
 
+        // AD-HOC: displayedDocument may only be kept in the back/forward cache if it keeps a session history entry of its
+        //         own to be traversed back to, which it doesn't when it is being reloaded or replaced.
+        auto displayed_entry = displayed_document->latest_entry();
+        auto keep_in_back_forward_cache = displayed_entry && displayed_entry->step() != target_entry->step()
+            ? DOM::Document::KeepInBackForwardCache::Yes
+            : DOM::Document::KeepInBackForwardCache::No;
+
         // 3. Unload a document and its descendants given displayedDocument, targetEntry's document, afterPotentialUnloads, and firePageSwapBeforeUnload.
-        displayed_document->unload_a_document_and_its_descendants(target_entry->document(), after_potential_unloads);
+        displayed_document->unload_a_document_and_its_descendants(target_entry->document(), after_potential_unloads, keep_in_back_forward_cache);
     }
     // FIXME: 6. Otherwise, queue a global task on the navigation and traversal task source given navigable's active window to run the steps:
     else {
@@ -1121,6 +1130,9 @@ void TraversableNavigable::clear_the_forward_session_history()
             }
         }
     }
+
+    // AD-HOC: Nothing can traverse to the documents of the removed entries anymore, so stop keeping them alive.
+    m_back_forward_cache->evict_documents_without_session_history_entries();
 }
 
 bool TraversableNavigable::can_go_forward() const
@@ -1275,6 +1287,9 @@ void TraversableNavigable::destroy_top_level_traversable()
     // 1. Let browsingContext be traversable's active browsing context.
     auto browsing_context = active_browsing_context();
 
+    // AD-HOC: Destroy the documents in the back/forward cache first, along with the documents in their child navigables.
+    m_back_forward_cache->evict_all("traversable destroyed"sv);
+
     // 2. For each historyEntry in traversable's session history entries:
     for (auto& history_entry : m_session_history_entries) {
         // 1. Let document be historyEntry's document.
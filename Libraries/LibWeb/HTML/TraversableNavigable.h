@@ -11,6 +11,7 @@
 #include <AK/Vector.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Geolocation/Geolocation.h>
+#include <LibWeb/HTML/BackForwardCache.h>
 #include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/HTML/NavigationType.h>
 #include <LibWeb/HTML/SessionHistoryTraversalQueue.h>
@@ -109,6 +110,9 @@ public:
     };
     CheckIfUnloadingIsCanceledResult check_if_unloading_is_canceled(Vector<GC::Root<Navigable>> navigables_that_need_before_unload);
 
+    BackForwardCache& back_forward_cache() { return m_back_forward_cache; }
+    BackForwardCache const& back_forward_cache() const { return m_back_forward_cache; }
+
     StorageAPI::StorageShed& storage_shed() { return m_storage_shed; }
     StorageAPI::StorageShed const& storage_shed() const { return m_storage_shed; }
 
@@ -169,6 +173,8 @@ private:
 
     GC::Ref<SessionHistoryTraversalQueue> m_session_history_traversal_queue;
 
+    GC::Ref<BackForwardCache> m_back_forward_cache;
+
     String m_window_handle;
 
     // https://w3c.github.io/geolocation/#dfn-emulated-position-data
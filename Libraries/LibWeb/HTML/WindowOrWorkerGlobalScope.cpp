@@ -9,6 +9,7 @@
 
 #include <AK/QuickSort.h>
 #include <AK/String.h>
+#include <AK/TemporaryChange.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
 #include <LibGC/Function.h>
@@ -22,6 +23,7 @@
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
 #include <LibWeb/Crypto/Crypto.h>
 #include <LibWeb/Fetch/FetchMethod.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
 #include <LibWeb/HTML/CanvasRenderingContext2D.h>
 #include <LibWeb/HTML/ErrorEvent.h>
 #include <LibWeb/HTML/ErrorInformation.h>
@@ -529,6 +531,31 @@ void WindowOrWorkerGlobalScopeMixin::clear_interval(i32 id)
     m_timers.remove(id);
 }
 
+void WindowOrWorkerGlobalScopeMixin::reschedule_timers()
+{
+    for (auto& it : m_timers)
+        it.value->reschedule();
+}
+
+Vector<i32> WindowOrWorkerGlobalScopeMixin::suspend_timers()
+{
+    Vector<i32> handles;
+    handles.ensure_capacity(m_timers.size());
+    for (auto& it : m_timers) {
+        it.value->suspend();
+        handles.unchecked_append(it.key);
+    }
+    return handles;
+}
+
+void WindowOrWorkerGlobalScopeMixin::resume_timers(ReadonlySpan<i32> handles, AK::Duration suspend_duration)
+{
+    for (auto handle : handles) {
+        if (auto timer = m_timers.get(handle); timer.has_value())
+            timer.value()->resume(suspend_duration);
+    }
+}
+
 void WindowOrWorkerGlobalScopeMixin::clear_map_of_active_timers()
 {
     for (auto& it : m_timers)
@@ -536,6 +563,10 @@ void WindowOrWorkerGlobalScopeMixin::clear_map_of_active_timers()
     m_timers.clear();
 }
 
+// The timer nesting level of the event loop's currently running task, if that task was created by the timer
+// initialization steps.
+static Optional<u32> s_timer_nesting_level_of_currently_running_task;
+
 // https://html.spec.whatwg.org/multipage/timers-and-user-prompts.html#timer-initialisation-steps
 // With no active script fix from https://github.com/whatwg/html/pull/9712
 i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler handler, i32 timeout, GC::RootVector<JS::Value> arguments, Repeat repeat, Optional<i32> previous_id)
@@ -545,13 +576,16 @@ i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler
     // 2. If previousId was given, let id be previousId; otherwise, let id be an implementation-defined integer that is greater than zero and does not already exist in global's map of setTimeout and setInterval IDs.
     auto id = previous_id.has_value() ? previous_id.value() : m_timer_id_allocator.allocate();
 
-    // FIXME: 3. If the surrounding agent's event loop's currently running task is a task that was created by this algorithm, then let nesting level be the task's timer nesting level. Otherwise, let nesting level be 0.
+    // 3. If the surrounding agent's event loop's currently running task is a task that was created by this algorithm, then let nesting level be the task's timer nesting level. Otherwise, let nesting level be 0.
+    auto nesting_level = s_timer_nesting_level_of_currently_running_task.value_or(0);
 
     // 4. If timeout is less than 0, then set timeout to 0.
     if (timeout < 0)
         timeout = 0;
 
-    // FIXME: 5. If nesting level is greater than 5, and timeout is less than 4, then set timeout to 4.
+    // 5. If nesting level is greater than 5, and timeout is less than 4, then set timeout to 4.
+    if (nesting_level > BackgroundThrottlingPolicy::maximum_unclamped_timer_nesting_level && timeout < BackgroundThrottlingPolicy::minimum_clamped_timer_timeout_ms)
+        timeout = BackgroundThrottlingPolicy::minimum_clamped_timer_timeout_ms;
 
     // 6. Let realm be global's relevant realm.
     auto& realm = relevant_realm(this_impl());
@@ -659,13 +693,17 @@ i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler
         }
     }));
 
-    // FIXME: 10. Increment nesting level by one.
-    // FIXME: 11. Set task's timer nesting level to nesting level.
+    // 10. Increment nesting level by one.
+    ++nesting_level;
+
+    // 11. Set task's timer nesting level to nesting level.
+    // NOTE: The task we actually queue is the one that wraps task below, so that's what remembers the nesting level.
 
     // 12. Let completionStep be an algorithm step which queues a global task on the timer task source given global to run task.
-    Function<void()> completion_step = [this, task = move(task)]() mutable {
-        queue_global_task(Task::Source::TimerTask, this_impl(), GC::create_function(this_impl().heap(), [this, task] {
+    Function<void()> completion_step = [this, task = move(task), nesting_level]() mutable {
+        queue_global_task(Task::Source::TimerTask, this_impl(), GC::create_function(this_impl().heap(), [this, task, nesting_level] {
             HTML::TemporaryExecutionContext execution_context { this_impl().realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+            TemporaryChange change_nesting_level { s_timer_nesting_level_of_currently_running_task, Optional<u32> { nesting_level } };
             task->function()();
         }));
     };
@@ -673,7 +711,7 @@ i32 WindowOrWorkerGlobalScopeMixin::run_timer_initialization_steps(TimerHandler
     // 13. Set uniqueHandle to the result of running steps after a timeout given global, "setTimeout/setInterval",
     //     timeout, and completionStep.
     //     FIXME: run_steps_after_a_timeout() needs to be updated to return a unique internal value that can be used here.
-    run_steps_after_a_timeout_impl(timeout, move(completion_step), id, repeat);
+    run_steps_after_a_timeout_impl(timeout, move(completion_step), id, repeat, nesting_level);
 
     // FIXME: 14. Set global's map of setTimeout and setInterval IDs[id] to uniqueHandle.
 
@@ -1075,10 +1113,10 @@ WindowOrWorkerGlobalScopeMixin::AffectedAnyWebSockets WindowOrWorkerGlobalScopeM
 // https://html.spec.whatwg.org/multipage/timers-and-user-prompts.html#run-steps-after-a-timeout
 void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout(i32 timeout, Function<void()> completion_step)
 {
-    return run_steps_after_a_timeout_impl(timeout, move(completion_step), {}, Repeat::No);
+    return run_steps_after_a_timeout_impl(timeout, move(completion_step), {}, Repeat::No, 0);
 }
 
-void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout, Function<void()> completion_step, Optional<i32> timer_key, Repeat repeat)
+void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout, Function<void()> completion_step, Optional<i32> timer_key, Repeat, u32 nesting_level)
 {
     // 1. Assert: if timerKey is given, then the caller of this algorithm is the timer initialization steps. (Other specifications must not pass timerKey.)
     // Note: This is enforced by the caller.
@@ -1090,6 +1128,7 @@ void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout,
         if (result.has_value()) {
             existing_timer = result.value().ptr();
             existing_timer->set_callback(move(completion_step));
+            existing_timer->set_timeout(timeout, nesting_level);
         }
     } else {
         // 2. If timerKey is not given, then set it to a new unique non-numeric value.
@@ -1097,7 +1136,7 @@ void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout,
     }
 
     // FIXME: 3. Let startTime be the current high resolution time given global.
-    auto timer = existing_timer ? GC::Ref { *existing_timer } : Timer::create(this_impl(), timeout, move(completion_step), timer_key.value(), repeat == Repeat::Yes ? Timer::Repeating::Yes : Timer::Repeating::No);
+    auto timer = existing_timer ? GC::Ref { *existing_timer } : Timer::create(this_impl(), timeout, move(completion_step), timer_key.value(), nesting_level);
 
     // FIXME: 4. Set global's map of active timers[timerKey] to startTime plus milliseconds.
     m_timers.set(timer_key.value(), timer);
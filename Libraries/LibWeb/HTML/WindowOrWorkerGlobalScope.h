@@ -49,6 +49,13 @@ public:
     void clear_interval(i32);
     void clear_map_of_active_timers();
 
+    // Called when something that affects how timers are throttled changed, like the visibility of the document.
+    void reschedule_timers();
+
+    // Suspends all active timers and returns their handles, for the document's suspended timer handles.
+    Vector<i32> suspend_timers();
+    void resume_timers(ReadonlySpan<i32> handles, AK::Duration suspend_duration);
+
     enum class CheckIfPerformanceBufferIsFull {
         No,
         Yes,
@@ -77,6 +84,7 @@ public:
 
     void register_web_socket(Badge<WebSockets::WebSocket>, GC::Ref<WebSockets::WebSocket>);
     void unregister_web_socket(Badge<WebSockets::WebSocket>, GC::Ref<WebSockets::WebSocket>);
+    bool has_registered_web_sockets() const { return !m_registered_web_sockets.is_empty(); }
 
     enum class AffectedAnyWebSockets {
         No,
@@ -119,7 +127,7 @@ private:
         No,
     };
     i32 run_timer_initialization_steps(TimerHandler handler, i32 timeout, GC::RootVector<JS::Value> arguments, Repeat repeat, Optional<i32> previous_id = {});
-    void run_steps_after_a_timeout_impl(i32 timeout, Function<void()> completion_step, Optional<i32> timer_key, Repeat);
+    void run_steps_after_a_timeout_impl(i32 timeout, Function<void()> completion_step, Optional<i32> timer_key, Repeat, u32 nesting_level);
 
     GC::Ref<WebIDL::Promise> create_image_bitmap_impl(ImageBitmapSource& image, Optional<WebIDL::Long> sx, Optional<WebIDL::Long> sy, Optional<WebIDL::Long> sw, Optional<WebIDL::Long> sh, Optional<ImageBitmapOptions>& options) const;
 
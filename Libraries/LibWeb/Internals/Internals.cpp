@@ -15,14 +15,21 @@
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/DOM/NodeList.h>
 #include <LibWeb/DOMURL/DOMURL.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/HTML/BackForwardCache.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/HTMLElement.h>
 #include <LibWeb/HTML/Navigable.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/InternalGamepad.h>
 #include <LibWeb/Internals/Internals.h>
@@ -344,6 +351,15 @@ bool Internals::set_http_memory_cache_enabled(bool enabled)
     return was_enabled;
 }
 
+bool Internals::set_back_forward_cache_enabled(bool enabled)
+{
+    auto policy = HTML::BackForwardCachePolicy::the();
+    auto was_enabled = policy.enabled;
+    policy.enabled = enabled;
+    HTML::BackForwardCachePolicy::set_the(policy);
+    return was_enabled;
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static
 String Internals::get_computed_role(DOM::Element& element)
 {
@@ -410,4 +426,135 @@ GC::Ref<InternalGamepad> Internals::connect_virtual_gamepad()
     return realm.create<InternalGamepad>(realm);
 }
 
+JS::Object* Internals::timer_wake_up_metrics()
+{
+    auto const& metrics = HTML::TimerWakeUpMetrics::the();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("wakeUps"_utf16_fly_string, JS::Value(static_cast<double>(metrics.wake_ups())), JS::default_attributes);
+    object->define_direct_property("wakeUpsPerSecond"_utf16_fly_string, JS::Value(static_cast<double>(metrics.wake_ups_per_second())), JS::default_attributes);
+    object->define_direct_property("throttledTimers"_utf16_fly_string, JS::Value(static_cast<double>(metrics.throttled_timers())), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::event_loop_task_metrics()
+{
+    auto& task_queue = HTML::main_thread_event_loop().task_queue();
+    auto object = JS::Object::create(realm(), nullptr);
+
+    auto add_metrics = [&](Utf16FlyString const& name, HTML::Task::Priority priority) {
+        auto const& metrics = task_queue.metrics(priority);
+        auto priority_object = JS::Object::create(realm(), nullptr);
+        priority_object->define_direct_property("queuedTasks"_utf16_fly_string, JS::Value(static_cast<double>(metrics.queued_tasks)), JS::default_attributes);
+        priority_object->define_direct_property("peakQueuedTasks"_utf16_fly_string, JS::Value(static_cast<double>(metrics.peak_queued_tasks)), JS::default_attributes);
+        priority_object->define_direct_property("takenTasks"_utf16_fly_string, JS::Value(static_cast<double>(metrics.taken_tasks)), JS::default_attributes);
+        priority_object->define_direct_property("totalWaitTime"_utf16_fly_string, JS::Value(metrics.total_wait_time.to_microseconds() / 1000.0), JS::default_attributes);
+        priority_object->define_direct_property("longestWaitTime"_utf16_fly_string, JS::Value(metrics.longest_wait_time.to_microseconds() / 1000.0), JS::default_attributes);
+        object->define_direct_property(name, priority_object, JS::default_attributes);
+    };
+    add_metrics("userBlocking"_utf16_fly_string, HTML::Task::Priority::UserBlocking);
+    add_metrics("userVisible"_utf16_fly_string, HTML::Task::Priority::UserVisible);
+    add_metrics("background"_utf16_fly_string, HTML::Task::Priority::Background);
+    return object;
+}
+
+JS::Object* Internals::computed_property_value_memory_usage()
+{
+    auto& document = window().associated_document();
+    document.update_style();
+
+    size_t styled_elements = 0;
+    size_t unshared_bytes = 0;
+    Array<HashTable<CSS::ComputedPropertyValueGroup const*>, CSS::number_of_computed_value_groups> distinct_groups;
+    document.for_each_in_inclusive_subtree_of_type<DOM::Element>([&](DOM::Element const& element) {
+        if (auto computed_properties = element.computed_properties()) {
+            ++styled_elements;
+            for (size_t i = 0; i < CSS::number_of_computed_value_groups; ++i) {
+                auto const& group = computed_properties->property_value_group(static_cast<CSS::ComputedValueGroup>(i));
+                unshared_bytes += group.memory_usage();
+                distinct_groups[i].set(&group);
+            }
+        }
+        return TraversalDecision::Continue;
+    });
+
+    size_t shared_bytes = 0;
+    auto groups = JS::Object::create(realm(), nullptr);
+    for (size_t i = 0; i < CSS::number_of_computed_value_groups; ++i) {
+        for (auto const* group : distinct_groups[i])
+            shared_bytes += group->memory_usage();
+        auto name = CSS::computed_value_group_name(static_cast<CSS::ComputedValueGroup>(i));
+        groups->define_direct_property(Utf16FlyString::from_utf8(name), JS::Value(static_cast<double>(distinct_groups[i].size())), JS::default_attributes);
+    }
+
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("styledElements"_utf16_fly_string, JS::Value(static_cast<double>(styled_elements)), JS::default_attributes);
+    object->define_direct_property("groups"_utf16_fly_string, groups, JS::default_attributes);
+    object->define_direct_property("unsharedBytes"_utf16_fly_string, JS::Value(static_cast<double>(unshared_bytes)), JS::default_attributes);
+    object->define_direct_property("sharedBytes"_utf16_fly_string, JS::Value(static_cast<double>(shared_bytes)), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::style_sharing_metrics()
+{
+    auto& document = window().associated_document();
+    document.update_style();
+
+    auto const& statistics = document.style_computer().total_style_sharing_statistics();
+
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("sharedStyles"_utf16_fly_string, JS::Value(static_cast<double>(statistics.shared_styles)), JS::default_attributes);
+    object->define_direct_property("unsharedStyles"_utf16_fly_string, JS::Value(static_cast<double>(statistics.unshared_styles)), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::element_index_memory_usage()
+{
+    auto& document = window().associated_document();
+    auto const& element_index = document.element_index();
+
+    size_t elements = 0;
+    document.for_each_in_subtree_of_type<DOM::Element>([&](DOM::Element const&) {
+        ++elements;
+        return TraversalDecision::Continue;
+    });
+
+    // NOTE: Every element has a pointer to the tree scope whose index it is in, even before any index is built.
+    auto scope_pointer_bytes = elements * sizeof(GC::Ptr<DOM::ParentNode>);
+
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("elements"_utf16_fly_string, JS::Value(static_cast<double>(elements)), JS::default_attributes);
+    object->define_direct_property("indexBytes"_utf16_fly_string, JS::Value(static_cast<double>(element_index.memory_usage_in_bytes())), JS::default_attributes);
+    object->define_direct_property("scopePointerBytes"_utf16_fly_string, JS::Value(static_cast<double>(scope_pointer_bytes)), JS::default_attributes);
+    return object;
+}
+
+JS::Object* Internals::back_forward_cache_metrics()
+{
+    auto& realm = this->realm();
+    auto object = JS::Object::create(realm, nullptr);
+
+    auto navigable = window().associated_document().navigable();
+    if (!navigable)
+        return object;
+    auto traversable = navigable->traversable_navigable();
+    if (!traversable)
+        return object;
+
+    auto const& back_forward_cache = traversable->back_forward_cache();
+    auto const& metrics = back_forward_cache.metrics();
+
+    auto not_stored_reasons = JS::Object::create(realm, nullptr);
+    for (auto const& [reason, count] : metrics.not_stored_reasons)
+        not_stored_reasons->define_direct_property(Utf16FlyString::from_utf8(reason), JS::Value(static_cast<double>(count)), JS::default_attributes);
+
+    object->define_direct_property("cachedDocuments"_utf16_fly_string, JS::Value(static_cast<double>(back_forward_cache.size())), JS::default_attributes);
+    object->define_direct_property("storedDocuments"_utf16_fly_string, JS::Value(static_cast<double>(metrics.stored_documents)), JS::default_attributes);
+    object->define_direct_property("restoredDocuments"_utf16_fly_string, JS::Value(static_cast<double>(metrics.restored_documents)), JS::default_attributes);
+    object->define_direct_property("restoredDocumentsWithLayoutTree"_utf16_fly_string, JS::Value(static_cast<double>(metrics.restored_documents_with_layout_tree)), JS::default_attributes);
+    object->define_direct_property("evictedDocuments"_utf16_fly_string, JS::Value(static_cast<double>(metrics.evicted_documents)), JS::default_attributes);
+    object->define_direct_property("notStoredDocuments"_utf16_fly_string, JS::Value(static_cast<double>(metrics.not_stored_documents)), JS::default_attributes);
+    object->define_direct_property("notStoredReasons"_utf16_fly_string, not_stored_reasons, JS::default_attributes);
+    return object;
+}
+
 }
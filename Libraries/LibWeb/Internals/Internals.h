@@ -60,6 +60,7 @@ public:
     void expire_cookies_with_time_offset(WebIDL::LongLong seconds);
 
     bool set_http_memory_cache_enabled(bool enabled);
+    bool set_back_forward_cache_enabled(bool enabled);
 
     String get_computed_role(DOM::Element& element);
     String get_computed_label(DOM::Element& element);
@@ -81,6 +82,13 @@ public:
 
     GC::Ref<InternalGamepad> connect_virtual_gamepad();
 
+    JS::Object* timer_wake_up_metrics();
+    JS::Object* event_loop_task_metrics();
+    JS::Object* computed_property_value_memory_usage();
+    JS::Object* style_sharing_metrics();
+    JS::Object* element_index_memory_usage();
+    JS::Object* back_forward_cache_metrics();
+
 private:
     explicit Internals(JS::Realm&);
 
@@ -666,7 +666,6 @@ void NodeWithStyle::apply_style(CSS::ComputedProperties const& computed_style)
     computed_values.set_text_shadow(computed_style.text_shadow(*this));
 
     computed_values.set_z_index(computed_style.z_index());
-    computed_values.set_opacity(computed_style.opacity());
 
     computed_values.set_visibility(computed_style.visibility());
 
@@ -684,18 +683,8 @@ void NodeWithStyle::apply_style(CSS::ComputedProperties const& computed_style)
 
     computed_values.set_box_shadow(computed_style.box_shadow(*this));
 
-    if (auto rotate_value = computed_style.rotate())
-        computed_values.set_rotate(rotate_value.release_nonnull());
-
-    if (auto translate_value = computed_style.translate())
-        computed_values.set_translate(translate_value.release_nonnull());
-
-    if (auto scale_value = computed_style.scale())
-        computed_values.set_scale(scale_value.release_nonnull());
-
-    computed_values.set_transformations(computed_style.transformations());
+    apply_transform_and_opacity_values(computed_style);
     computed_values.set_transform_box(computed_style.transform_box());
-    computed_values.set_transform_origin(computed_style.transform_origin());
     computed_values.set_transform_style(computed_style.transform_style());
     computed_values.set_perspective(computed_style.perspective());
     computed_values.set_perspective_origin(computed_style.perspective_origin());
@@ -935,6 +924,33 @@ void NodeWithStyle::apply_style(CSS::ComputedProperties const& computed_style)
         box_node->propagate_style_along_continuation(computed_style);
 }
 
+void NodeWithStyle::apply_transform_and_opacity_style(CSS::ComputedProperties const& computed_style)
+{
+    apply_transform_and_opacity_values(computed_style);
+
+    if (auto* box_node = as_if<NodeWithStyleAndBoxModelMetrics>(*this))
+        box_node->propagate_style_along_continuation(computed_style);
+}
+
+void NodeWithStyle::apply_transform_and_opacity_values(CSS::ComputedProperties const& computed_style)
+{
+    auto& computed_values = mutable_computed_values();
+
+    computed_values.set_opacity(computed_style.opacity());
+
+    if (auto rotate_value = computed_style.rotate())
+        computed_values.set_rotate(rotate_value.release_nonnull());
+
+    if (auto translate_value = computed_style.translate())
+        computed_values.set_translate(translate_value.release_nonnull());
+
+    if (auto scale_value = computed_style.scale())
+        computed_values.set_scale(scale_value.release_nonnull());
+
+    computed_values.set_transformations(computed_style.transformations());
+    computed_values.set_transform_origin(computed_style.transform_origin());
+}
+
 void NodeWithStyle::propagate_non_inherit_values(NodeWithStyle& target_node) const
 {
     // NOTE: These properties are not inherited, but we still have to propagate them to anonymous wrappers.
@@ -248,6 +248,8 @@ public:
     CSS::MutableComputedValues& mutable_computed_values() { return static_cast<CSS::MutableComputedValues&>(*m_computed_values); }
 
     void apply_style(CSS::ComputedProperties const&);
+    // Only applies the transform and opacity properties, for when nothing else about the style has changed.
+    void apply_transform_and_opacity_style(CSS::ComputedProperties const&);
 
     Gfx::Font const& first_available_font() const;
     Vector<CSS::BackgroundLayerData> const& background_layers() const { return computed_values().background_layers(); }
@@ -272,6 +274,8 @@ private:
     virtual bool is_node_with_style() const final { return true; }
 
     void reset_table_box_computed_values_used_by_wrapper_to_init_values();
+    // Shared by apply_style() and apply_transform_and_opacity_style(), so the fast path can't drift from the full one.
+    void apply_transform_and_opacity_values(CSS::ComputedProperties const&);
     void propagate_non_inherit_values(NodeWithStyle& target_node) const;
     void propagate_style_to_anonymous_wrappers();
 
@@ -16,6 +16,8 @@ struct Metadata {
     String algorithm;    // "alg"
     String base64_value; // "val"
     String options {};   // "opt"
+
+    bool operator==(Metadata const&) const = default;
 };
 
 ErrorOr<String> apply_algorithm_to_bytes(StringView algorithm, ByteBuffer const& bytes);
@@ -126,6 +126,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
     bool disable_scrollbar_painting = false;
+    bool disable_background_throttling = false;
+    Optional<u32> background_timer_alignment_ms;
+    bool disable_back_forward_cache = false;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("The CryFox web browser :^)");
@@ -177,6 +180,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation", 'g');
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical scrollbars on the main viewport", "disable-scrollbar-painting");
+    args_parser.add_option(disable_background_throttling, "Don't throttle timers and rendering in hidden pages", "disable-background-throttling");
+    args_parser.add_option(background_timer_alignment_ms, "Align timers in hidden pages to multiples of this (default: 1000)", "background-timer-alignment", 0, "milliseconds");
+    args_parser.add_option(disable_back_forward_cache, "Don't keep pages alive for back/forward navigation", "disable-back-forward-cache");
     args_parser.add_option(dns_server_address, "Set the DNS server address", "dns-server", 0, "host|address");
     args_parser.add_option(dns_server_port, "Set the DNS server port", "dns-port", 0, "port (default: 53 or 853 if --dot)");
     args_parser.add_option(use_dns_over_tls, "Use DNS over TLS", "dot");
@@ -283,6 +289,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .collect_garbage_on_every_allocation = collect_garbage_on_every_allocation ? CollectGarbageOnEveryAllocation::Yes : CollectGarbageOnEveryAllocation::No,
         .paint_viewport_scrollbars = disable_scrollbar_painting ? PaintViewportScrollbars::No : PaintViewportScrollbars::Yes,
         .default_time_zone = default_time_zone,
+        .enable_background_throttling = disable_background_throttling ? EnableBackgroundThrottling::No : EnableBackgroundThrottling::Yes,
+        .background_timer_alignment_ms = background_timer_alignment_ms,
+        .enable_back_forward_cache = disable_back_forward_cache ? EnableBackForwardCache::No : EnableBackForwardCache::Yes,
     };
 
     create_platform_options(m_browser_options, m_request_server_options, m_web_content_options);
@@ -124,6 +124,14 @@ static ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_proc
         arguments.append("--collect-garbage-on-every-allocation"sv);
     if (web_content_options.paint_viewport_scrollbars == PaintViewportScrollbars::No)
         arguments.append("--disable-scrollbar-painting"sv);
+    if (web_content_options.enable_background_throttling == EnableBackgroundThrottling::No)
+        arguments.append("--disable-background-throttling"sv);
+    if (auto const maybe_alignment = web_content_options.background_timer_alignment_ms; maybe_alignment.has_value()) {
+        arguments.append("--background-timer-alignment"sv);
+        arguments.append(ByteString::number(maybe_alignment.value()));
+    }
+    if (web_content_options.enable_back_forward_cache == EnableBackForwardCache::No)
+        arguments.append("--disable-back-forward-cache"sv);
 
     if (auto const maybe_echo_server_port = web_content_options.echo_server_port; maybe_echo_server_port.has_value()) {
         arguments.append("--echo-server-port"sv);
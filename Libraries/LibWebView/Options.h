@@ -154,6 +154,16 @@ enum class PaintViewportScrollbars {
     No,
 };
 
+enum class EnableBackgroundThrottling {
+    Yes,
+    No,
+};
+
+enum class EnableBackForwardCache {
+    Yes,
+    No,
+};
+
 struct WebContentOptions {
     String command_line;
     String executable_path;
@@ -172,6 +182,9 @@ struct WebContentOptions {
     Optional<u16> echo_server_port {};
     PaintViewportScrollbars paint_viewport_scrollbars { PaintViewportScrollbars::Yes };
     Optional<StringView> default_time_zone {};
+    EnableBackgroundThrottling enable_background_throttling { EnableBackgroundThrottling::Yes };
+    Optional<u32> background_timer_alignment_ms {};
+    EnableBackForwardCache enable_back_forward_cache { EnableBackForwardCache::Yes };
 };
 
 }
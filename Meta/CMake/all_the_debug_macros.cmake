@@ -1,5 +1,6 @@
 set(AK_STRINGBASE_VERIFY_LAUNDER_DEBUG ON)
 set(AUDIO_DEBUG ON)
+set(BACK_FORWARD_CACHE_DEBUG ON)
 set(BMP_DEBUG ON)
 set(CACHE_DEBUG ON)
 set(CALLBACK_MACHINE_DEBUG ON)
@@ -59,6 +60,7 @@ set(RSA_PARSE_DEBUG ON)
 set(SHARED_QUEUE_DEBUG ON)
 set(SPAM_DEBUG ON)
 set(STYLE_INVALIDATION_DEBUG ON)
+set(STYLE_SHARING_DEBUG ON)
 set(SYNTAX_HIGHLIGHTING_DEBUG ON)
 set(TEXTEDITOR_DEBUG ON)
 set(TIFF_DEBUG ON)
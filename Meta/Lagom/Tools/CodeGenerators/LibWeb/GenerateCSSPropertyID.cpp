@@ -26,6 +26,60 @@ static bool is_legacy_alias(JsonObject const& property)
     return property.has_string("legacy-alias-for"sv);
 }
 
+// Computed values are stored in groups of related properties, so that an element can share a whole group with its parent
+// or a sibling, see ComputedProperties. A group only holds inherited or only non-inherited properties, and the inherited
+// groups come first.
+static constexpr Array computed_value_group_names {
+    "InheritedFont"sv,
+    "InheritedText"sv,
+    "InheritedSVG"sv,
+    "InheritedOther"sv,
+    "Box"sv,
+    "Border"sv,
+    "Background"sv,
+    "FlexAndGrid"sv,
+    "Effects"sv,
+    "Animation"sv,
+    "Other"sv,
+};
+static constexpr size_t number_of_inherited_computed_value_groups = 4;
+
+static size_t computed_value_group_for_longhand(String const& name, bool inherited)
+{
+    auto group = [](StringView group_name) {
+        return *computed_value_group_names.first_index_of(group_name);
+    };
+    auto starts_with_any_of = [&](auto... prefixes) {
+        return (name.starts_with_bytes(prefixes) || ...);
+    };
+
+    if (inherited) {
+        if (starts_with_any_of("font-"sv) || name == "line-height"sv)
+            return group("InheritedFont"sv);
+        if (starts_with_any_of("fill"sv, "stroke"sv) || first_is_one_of(name, "clip-rule"sv, "color-interpolation"sv, "paint-order"sv, "shape-rendering"sv, "text-anchor"sv))
+            return group("InheritedSVG"sv);
+        if (starts_with_any_of("text-"sv, "white-space-"sv, "word-"sv) || first_is_one_of(name, "-webkit-text-fill-color"sv, "direction"sv, "letter-spacing"sv, "overflow-wrap"sv, "tab-size"sv, "writing-mode"sv))
+            return group("InheritedText"sv);
+        return group("InheritedOther"sv);
+    }
+
+    if (starts_with_any_of("margin-"sv, "padding-"sv, "inset-"sv, "min-"sv, "max-"sv, "overflow-"sv)
+        || first_is_one_of(name, "aspect-ratio"sv, "block-size"sv, "bottom"sv, "box-sizing"sv, "clear"sv, "display"sv, "float"sv, "height"sv, "inline-size"sv, "left"sv, "position"sv, "right"sv, "top"sv, "vertical-align"sv, "width"sv, "z-index"sv))
+        return group("Box"sv);
+    if (starts_with_any_of("border-"sv, "corner-"sv, "outline-"sv) || name == "box-shadow"sv)
+        return group("Border"sv);
+    if (starts_with_any_of("background-"sv, "mask-"sv))
+        return group("Background"sv);
+    if (starts_with_any_of("align-"sv, "column-"sv, "flex-"sv, "grid-"sv, "justify-"sv) || first_is_one_of(name, "order"sv, "row-gap"sv))
+        return group("FlexAndGrid"sv);
+    if (starts_with_any_of("transform"sv, "perspective"sv)
+        || first_is_one_of(name, "backdrop-filter"sv, "clip"sv, "clip-path"sv, "filter"sv, "isolation"sv, "mix-blend-mode"sv, "opacity"sv, "rotate"sv, "scale"sv, "translate"sv, "will-change"sv))
+        return group("Effects"sv);
+    if (starts_with_any_of("animation-"sv, "transition-"sv, "scroll-timeline-"sv, "view-timeline-"sv) || name == "view-transition-name"sv)
+        return group("Animation"sv);
+    return group("Other"sv);
+}
+
 ErrorOr<int> cryfox_main(Main::Arguments arguments)
 {
     StringView generated_header_path;
@@ -159,6 +213,7 @@ ErrorOr<void> generate_header_file(JsonObject& properties, JsonObject& logical_p
     generator.append(R"~~~(
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/StringView.h>
 #include <AK/Traits.h>
@@ -236,6 +291,33 @@ enum class PropertyID : @property_id_underlying_type@ {
     generator.set("first_inherited_property_id", title_casify(inherited_longhand_property_ids.first()));
     generator.set("last_inherited_property_id", title_casify(inherited_longhand_property_ids.last()));
 
+    Array<size_t, computed_value_group_names.size()> computed_value_group_sizes {};
+    StringBuilder computed_value_slots;
+    auto append_computed_value_slots = [&](auto& property_ids, bool inherited) {
+        for (auto& name : property_ids) {
+            auto group = computed_value_group_for_longhand(name, inherited);
+            computed_value_slots.appendff("\n    {{ ComputedValueGroup::{}, {} }}, // {}", computed_value_group_names[group], computed_value_group_sizes[group]++, name);
+        }
+    };
+    append_computed_value_slots(inherited_longhand_property_ids, true);
+    append_computed_value_slots(noninherited_longhand_property_ids, false);
+    generator.set("computed_value_slots", computed_value_slots.to_byte_string());
+
+    StringBuilder computed_value_group_enumerators;
+    StringBuilder computed_value_group_size_list;
+    for (size_t group = 0; group < computed_value_group_names.size(); ++group) {
+        if (computed_value_group_sizes[group] == 0) {
+            dbgln("Computed value group '{}' has no properties", computed_value_group_names[group]);
+            VERIFY_NOT_REACHED();
+        }
+        computed_value_group_enumerators.appendff("\n    {},", computed_value_group_names[group]);
+        computed_value_group_size_list.appendff("{}{}", group == 0 ? "" : ", ", computed_value_group_sizes[group]);
+    }
+    generator.set("computed_value_group_enumerators", computed_value_group_enumerators.to_byte_string());
+    generator.set("computed_value_group_sizes", computed_value_group_size_list.to_byte_string());
+    generator.set("number_of_computed_value_groups", String::number(computed_value_group_names.size()));
+    generator.set("last_inherited_computed_value_group", ByteString { computed_value_group_names[number_of_inherited_computed_value_groups - 1] });
+
     // FIXME: property_accepts_{number,percentage}() has a different range from accepted_type_ranges() despite the names sounding similar.
     generator.append(R"~~~(
 };
@@ -305,6 +387,24 @@ constexpr PropertyID first_longhand_property_id = PropertyID::@first_longhand_pr
 constexpr PropertyID last_longhand_property_id = PropertyID::@last_longhand_property_id@;
 constexpr size_t number_of_longhand_properties = to_underlying(last_longhand_property_id) - to_underlying(first_longhand_property_id) + 1;
 
+// Computed values are stored in groups of related properties, which elements can share. See ComputedProperties.
+enum class ComputedValueGroup : u8 {@computed_value_group_enumerators@
+};
+constexpr size_t number_of_computed_value_groups = @number_of_computed_value_groups@;
+constexpr Array<size_t, number_of_computed_value_groups> computed_value_group_sizes { @computed_value_group_sizes@ };
+
+// Inherited and non-inherited properties are never in the same group, and the inherited groups come first.
+constexpr bool is_inherited_computed_value_group(ComputedValueGroup group) { return group <= ComputedValueGroup::@last_inherited_computed_value_group@; }
+
+struct ComputedValueSlot {
+    ComputedValueGroup group;
+    u16 index;
+};
+constexpr Array<ComputedValueSlot, number_of_longhand_properties> computed_value_slots { {@computed_value_slots@
+} };
+constexpr ComputedValueSlot computed_value_slot(PropertyID property_id) { return computed_value_slots[to_underlying(property_id) - to_underlying(first_longhand_property_id)]; }
+StringView computed_value_group_name(ComputedValueGroup);
+
 enum class Quirk {
     // https://quirks.spec.whatwg.org/#the-hashless-hex-color-quirk
     HashlessHexColor,
@@ -651,6 +751,25 @@ bool is_inherited_property(PropertyID property_id)
     return false;
 }
 
+StringView computed_value_group_name(ComputedValueGroup group)
+{
+    switch (group) {
+)~~~");
+
+    for (auto group_name : computed_value_group_names) {
+        auto group_generator = generator.fork();
+        group_generator.set("group_name", ByteString { group_name });
+        group_generator.append(R"~~~(
+    case ComputedValueGroup::@group_name@:
+        return "@group_name@"sv;
+)~~~");
+    }
+
+    generator.append(R"~~~(
+    }
+    VERIFY_NOT_REACHED();
+}
+
 bool property_affects_layout(PropertyID property_id)
 {
     switch (property_id) {
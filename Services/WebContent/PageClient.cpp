@@ -16,11 +16,13 @@
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/CSSImportRule.h>
+#include <LibWeb/CSS/MediaQuery.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/MutationType.h>
 #include <LibWeb/DOM/NodeList.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
 #include <LibWeb/HTML/HTMLLinkElement.h>
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
@@ -104,6 +106,19 @@ void PageClient::set_has_focus(bool has_focus)
     m_has_focus = has_focus;
 }
 
+void PageClient::set_system_visibility_state(Web::HTML::VisibilityState visibility_state)
+{
+    page().top_level_traversable()->set_system_visibility_state(visibility_state);
+
+    // OPTIMIZATION: Hidden pages have no rendering opportunities, so there's no point in waking up to look for them.
+    if (!Web::HTML::BackgroundThrottlingPolicy::the().enabled)
+        return;
+    if (visibility_state == Web::HTML::VisibilityState::Hidden)
+        m_paint_refresh_timer->stop();
+    else if (!m_paint_refresh_timer->is_active())
+        m_paint_refresh_timer->start();
+}
+
 void PageClient::setup_palette()
 {
     // FIXME: Get the proper palette from our peer somehow
@@ -143,12 +158,19 @@ void PageClient::set_palette_impl(Gfx::PaletteImpl& impl)
         document->invalidate_style(Web::DOM::StyleInvalidationReason::SettingsChange);
 }
 
+void PageClient::set_device_pixel_ratio(double device_pixel_ratio)
+{
+    m_device_pixel_ratio = device_pixel_ratio;
+    if (auto* document = page().top_level_browsing_context().active_document())
+        document->set_needs_media_query_evaluation(Web::CSS::MediaFeatureDependencies::Resolution);
+}
+
 void PageClient::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
 {
     m_preferred_color_scheme = color_scheme;
     if (auto* document = page().top_level_browsing_context().active_document()) {
         document->invalidate_style(Web::DOM::StyleInvalidationReason::SettingsChange);
-        document->set_needs_media_query_evaluation();
+        document->set_needs_media_query_evaluation(Web::CSS::MediaFeatureDependencies::UserPreferences);
     }
 }
 
@@ -157,7 +179,7 @@ void PageClient::set_preferred_contrast(Web::CSS::PreferredContrast contrast)
     m_preferred_contrast = contrast;
     if (auto* document = page().top_level_browsing_context().active_document()) {
         document->invalidate_style(Web::DOM::StyleInvalidationReason::SettingsChange);
-        document->set_needs_media_query_evaluation();
+        document->set_needs_media_query_evaluation(Web::CSS::MediaFeatureDependencies::UserPreferences);
     }
 }
 
@@ -166,7 +188,7 @@ void PageClient::set_preferred_motion(Web::CSS::PreferredMotion motion)
     m_preferred_motion = motion;
     if (auto* document = page().top_level_browsing_context().active_document()) {
         document->invalidate_style(Web::DOM::StyleInvalidationReason::SettingsChange);
-        document->set_needs_media_query_evaluation();
+        document->set_needs_media_query_evaluation(Web::CSS::MediaFeatureDependencies::UserPreferences);
     }
 }
 
@@ -22,6 +22,8 @@
 #include <LibUnicode/TimeZone.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/HTML/BackForwardCache.h>
+#include <LibWeb/HTML/BackgroundThrottling.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
 #include <LibWeb/Loader/ContentFilter.h>
@@ -101,6 +103,9 @@ ErrorOr<int> cryfox_main(Main::Arguments arguments)
     bool collect_garbage_on_every_allocation = false;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
+    bool disable_background_throttling = false;
+    Optional<u32> background_timer_alignment_ms;
+    bool disable_back_forward_cache = false;
     StringView echo_server_port_string_view {};
     StringView default_time_zone {};
 
@@ -123,6 +128,9 @@ ErrorOr<int> cryfox_main(Main::Arguments arguments)
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
+    args_parser.add_option(disable_background_throttling, "Don't throttle timers and rendering in hidden pages", "disable-background-throttling");
+    args_parser.add_option(background_timer_alignment_ms, "Align timers in hidden pages to multiples of this", "background-timer-alignment", 0, "milliseconds");
+    args_parser.add_option(disable_back_forward_cache, "Don't keep pages alive for back/forward navigation", "disable-back-forward-cache");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
     args_parser.add_option(default_time_zone, "Default time zone", "default-time-zone", 0, "time-zone-id");
@@ -148,6 +156,11 @@ ErrorOr<int> cryfox_main(Main::Arguments arguments)
     if (is_layout_test_mode) {
         expose_internals_object = true;
         force_cpu_painting = true;
+        // NOTE: Tests shouldn't take longer (or behave differently) depending on whether their page is visible.
+        disable_background_throttling = true;
+        // NOTE: Likewise, going back to a test page should load it again rather than show it as it was left. Tests of
+        //       the cache itself turn it on with internals.setBackForwardCacheEnabled().
+        disable_back_forward_cache = true;
     }
 
     Web::set_browser_process_command_line(command_line);
@@ -166,6 +179,16 @@ ErrorOr<int> cryfox_main(Main::Arguments arguments)
 
     Web::Painting::set_paint_viewport_scrollbars(!disable_scrollbar_painting);
 
+    Web::HTML::BackgroundThrottlingPolicy background_throttling_policy;
+    background_throttling_policy.enabled = !disable_background_throttling;
+    if (background_timer_alignment_ms.has_value())
+        background_throttling_policy.hidden_timer_alignment = AK::Duration::from_milliseconds(*background_timer_alignment_ms);
+    Web::HTML::BackgroundThrottlingPolicy::set_the(background_throttling_policy);
+
+    Web::HTML::BackForwardCachePolicy back_forward_cache_policy;
+    back_forward_cache_policy.enabled = !disable_back_forward_cache;
+    Web::HTML::BackForwardCachePolicy::set_the(back_forward_cache_policy);
+
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
             Web::Internals::Internals::set_echo_server_port(maybe_echo_server_port.value());
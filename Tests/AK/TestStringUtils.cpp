@@ -211,6 +211,26 @@ TEST_CASE(find_last)
     EXPECT(!AK::StringUtils::find_last(test_string, "abd"sv).has_value());
 }
 
+TEST_CASE(find_with_many_partial_matches)
+{
+    // Every position is a candidate that only fails at the needle's last character, which must not make the search
+    // quadratic.
+    auto haystack = ByteString::repeated('a', 200'000);
+    auto needle = ByteString::formatted("{}b", ByteString::repeated('a', 2'000));
+
+    EXPECT(!AK::StringUtils::find(haystack, needle).has_value());
+    EXPECT(!AK::StringUtils::find_last(haystack, needle).has_value());
+
+    auto haystack_with_match = ByteString::formatted("{}b{}", ByteString::repeated('a', 150'000), ByteString::repeated('a', 50'000));
+    EXPECT_EQ(AK::StringUtils::find(haystack_with_match, needle), 148'000u);
+    EXPECT_EQ(AK::StringUtils::find_last(haystack_with_match, needle), 148'000u);
+
+    auto haystack_with_matches = ByteString::formatted("{}b{}b{}", ByteString::repeated('a', 60'000), ByteString::repeated('a', 90'000), ByteString::repeated('a', 50'000));
+    EXPECT_EQ(AK::StringUtils::find(haystack_with_matches, needle), 58'000u);
+    EXPECT_EQ(AK::StringUtils::find_last(haystack_with_matches, needle), 148'001u);
+    EXPECT_EQ(AK::StringUtils::find(haystack_with_matches, needle, 58'001), 148'001u);
+}
+
 TEST_CASE(replace_all_overlapping)
 {
     // Replace only should take into account non-overlapping instances of the
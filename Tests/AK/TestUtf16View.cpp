@@ -835,6 +835,36 @@ TEST_CASE(find_code_unit_offset)
     EXPECT(!view.find_code_unit_offset(u"baz"sv).has_value());
 }
 
+TEST_CASE(find_code_unit_offset_in_long_strings)
+{
+    // Long enough that the vectorized search is used, with the needle straddling the vector boundaries.
+    auto ascii = Utf16String::from_utf8("the quick brown fox jumps over the lazy dog, the quick brown cat"sv);
+    auto utf16 = Utf16String::from_utf8("the quick brown fox jumps over the lazy 🐕, the quick brown 🐈"sv);
+    Utf16View const ascii_view { ascii };
+    Utf16View const utf16_view { utf16 };
+
+    EXPECT(ascii_view.has_ascii_storage());
+    EXPECT(!utf16_view.has_ascii_storage());
+
+    for (auto const& view : { ascii_view, utf16_view }) {
+        EXPECT_EQ(4u, view.find_code_unit_offset(u"quick"sv).value());
+        EXPECT_EQ(16u, view.find_code_unit_offset(u"fox"sv).value());
+        EXPECT_EQ(31u, view.find_code_unit_offset(u"the"sv, 1).value());
+        EXPECT(!view.find_code_unit_offset(u"quick brown fox jumped"sv).has_value());
+        EXPECT(!view.find_code_unit_offset(u"😀"sv).has_value());
+
+        EXPECT_EQ(0u, view.find_last_code_unit_offset(u"the"sv, 30).value());
+        EXPECT_EQ(31u, view.find_last_code_unit_offset(u"the"sv, 34).value());
+        EXPECT(!view.find_last_code_unit_offset(u"the"sv, 2).has_value());
+        EXPECT_EQ(view.length_in_code_units(), view.find_last_code_unit_offset(u""sv).value());
+    }
+
+    EXPECT_EQ(40u, ascii_view.find_last_code_unit_offset(u"dog"sv).value());
+    EXPECT_EQ(49u, ascii_view.find_last_code_unit_offset(u"quick"sv).value());
+    EXPECT_EQ(40u, utf16_view.find_code_unit_offset(u"🐕"sv).value());
+    EXPECT_EQ(60u, utf16_view.find_last_code_unit_offset(u"🐈"sv).value());
+}
+
 TEST_CASE(find_code_unit_offset_ignoring_case)
 {
     auto conversion_result = Utf16String::from_utf8("😀Foo😀Bar"sv);
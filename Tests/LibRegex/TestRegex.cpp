@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h> // import first, to prevent warning of VERIFY* redefinition
 
 #include <AK/Debug.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <AK/Tuple.h>
 #include <LibRegex/Regex.h>
@@ -1175,6 +1176,186 @@ BENCHMARK_CASE(anchor_performance)
     }
 }
 
+TEST_CASE(lazy_dfa_agrees_with_backtracking)
+{
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        ECMAScriptFlags flags {};
+    };
+
+    constexpr Test tests[] {
+        { "foo|bar"sv, "xxfoo bar baz"sv },
+        { "a[bc]+d"sv, "abcbcd abd ad"sv },
+        { "^abc"sv, "abcabc"sv },
+        { "abc$"sv, "abcabc"sv },
+        { "(a|ab)(c|bcd)"sv, "abcd"sv },
+        { "x*"sv, "aaa"sv },
+        { "(\\d+)\\.(\\d+)"sv, "v1.2 and 3.14"sv },
+        { "hello"sv, "HeLLo world, hello"sv, ECMAScriptFlags::Insensitive },
+        { "[^a]b"sv, "aabcb"sv },
+        { "a.c"sv, "a\nc abc"sv },
+        { "a.c"sv, "a\nc abc"sv, ECMAScriptFlags::SingleLine },
+        { "(?:ab)*c"sv, "ababab abc c"sv },
+        { "\\u{1F600}+"sv, "x\xF0\x9F\x98\x80\xF0\x9F\x98\x80y"sv, ECMAScriptFlags::Unicode },
+    };
+
+    auto global = static_cast<ECMAScriptFlags>(AllFlags::Global);
+    auto no_lazy_dfa = static_cast<ECMAScriptFlags>(AllFlags::Internal_NoLazyDFA);
+
+    for (auto const& test : tests) {
+        Regex<ECMA262> dfa_re(test.pattern, combine_flags(test.flags, global));
+        Regex<ECMA262> vm_re(test.pattern, combine_flags(test.flags, global, no_lazy_dfa));
+        EXPECT(dfa_re.parser_result.optimization_data.can_use_lazy_dfa);
+
+        auto utf16_subject = Utf16String::from_utf8(test.subject);
+
+        for (auto view : { RegexStringView { test.subject }, RegexStringView { Utf16View { utf16_subject } } }) {
+            auto dfa_result = dfa_re.match(view);
+            auto vm_result = vm_re.match(view);
+
+            EXPECT_EQ(dfa_result.success, vm_result.success);
+            EXPECT_EQ(dfa_result.count, vm_result.count);
+            if (dfa_result.count != vm_result.count)
+                continue;
+
+            for (size_t i = 0; i < dfa_result.count; ++i) {
+                EXPECT_EQ(dfa_result.matches[i].global_offset, vm_result.matches[i].global_offset);
+                EXPECT_EQ(dfa_result.matches[i].view.to_byte_string(), vm_result.matches[i].view.to_byte_string());
+                for (size_t group = 0; group < dfa_result.n_capture_groups; ++group)
+                    EXPECT_EQ(dfa_result.capture_group_matches[i][group].view.to_byte_string(), vm_result.capture_group_matches[i][group].view.to_byte_string());
+            }
+        }
+    }
+
+    Regex<ECMA262> backreference("(a)\\1"sv);
+    EXPECT(!backreference.parser_result.optimization_data.can_use_lazy_dfa);
+
+    Regex<ECMA262> lookahead("a(?=b)"sv);
+    EXPECT(!lookahead.parser_result.optimization_data.can_use_lazy_dfa);
+}
+
+static void run_email_scan_benchmark(ECMAScriptFlags extra_flags)
+{
+    // Every start position runs the VM to the end of the input before failing, unless the lazy DFA rejects the input up front.
+    auto input = g_lots_of_a_s.bytes_as_string_view().substring_view(0, 5'000);
+    Regex<ECMA262> re("[a-z]+@[a-z]+\\.com"sv, combine_flags(static_cast<ECMAScriptFlags>(AllFlags::Global), extra_flags));
+    for (auto i = 0; i < 10; i++) {
+        auto result = re.match(input);
+        EXPECT_EQ(result.success, false);
+    }
+}
+
+BENCHMARK_CASE(email_scan_performance_with_lazy_dfa)
+{
+    run_email_scan_benchmark({});
+}
+
+BENCHMARK_CASE(email_scan_performance_without_lazy_dfa)
+{
+    run_email_scan_benchmark(static_cast<ECMAScriptFlags>(AllFlags::Internal_NoLazyDFA));
+}
+
+TEST_CASE(literal_prefilter)
+{
+    auto literals_of = [](StringView pattern) -> Optional<Vector<ByteString>> {
+        Regex<ECMA262> re(pattern);
+        auto const& prefilter = re.parser_result.optimization_data.literal_prefilter;
+        if (!prefilter.has_value())
+            return {};
+        Vector<ByteString> literals;
+        for (auto const& literal : prefilter->literals())
+            literals.append(MUST(Utf16View { bit_cast<char16_t const*>(literal.data()), literal.size() }.to_byte_string()));
+        quick_sort(literals);
+        return literals;
+    };
+
+    EXPECT_EQ(literals_of("foo\\d+"sv), (Vector<ByteString> { "foo" }));
+    EXPECT_EQ(literals_of("(cat|dog)s?"sv), (Vector<ByteString> { "cat", "dog" }));
+    EXPECT_EQ(literals_of("(?:ab)+c"sv), (Vector<ByteString> { "ab" }));
+    EXPECT(!literals_of("\\d+foo"sv).has_value());
+    EXPECT(!literals_of("x*"sv).has_value());
+    EXPECT(!literals_of("^foo"sv).has_value());
+    EXPECT(!literals_of("(?<=a)b"sv).has_value());
+
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        Vector<StringView> matches;
+        ECMAScriptFlags flags {};
+    };
+
+    Test const tests[] {
+        { "foo\\d+"sv, "xx foo12 fo foo3 foo"sv, { "foo12"sv, "foo3"sv } },
+        { "(cat|dog)s?"sv, "hotdogs and a cat, catdog"sv, { "dogs"sv, "cat"sv, "cat"sv, "dog"sv } },
+        { "needle"sv, "haystack haystack haystack haystack needle!"sv, { "needle"sv } },
+        { "\u00e9t\u00e9"sv, "summer: \xC3\xA9t\xC3\xA9, \xC3\xA9t\xC3\xA9"sv, { "\xC3\xA9t\xC3\xA9"sv, "\xC3\xA9t\xC3\xA9"sv } },
+        { "needle"sv, "NEEDLE haystack Needle"sv, { "NEEDLE"sv, "Needle"sv }, ECMAScriptFlags::Insensitive },
+        { "b\u{1F600}"sv, "a\xF0\x9F\x98\x80b\xF0\x9F\x98\x80"sv, { "b\xF0\x9F\x98\x80"sv }, ECMAScriptFlags::Unicode },
+    };
+
+    for (auto const& test : tests) {
+        Regex<ECMA262> re(test.pattern, combine_flags(test.flags, static_cast<ECMAScriptFlags>(AllFlags::Global)));
+        auto subject = Utf16String::from_utf8(test.subject);
+        auto result = re.match(Utf16View { subject });
+
+        EXPECT_EQ(result.count, test.matches.size());
+        if (result.count != test.matches.size())
+            continue;
+        for (size_t i = 0; i < result.count; ++i)
+            EXPECT_EQ(result.matches[i].view.to_byte_string(), test.matches[i]);
+    }
+}
+
+BENCHMARK_CASE(literal_prefilter_performance)
+{
+    StringBuilder builder;
+    for (auto i = 0; i < 100'000; i++)
+        builder.append("lorem ipsum dolor sit amet "sv);
+    builder.append("consectetur"sv);
+    auto subject = Utf16String::from_utf8(builder.string_view());
+
+    Regex<ECMA262> re("consectetur|adipiscing"sv, static_cast<ECMAScriptFlags>(AllFlags::Global));
+    for (auto i = 0; i < 10; i++) {
+        auto result = re.match(Utf16View { subject });
+        EXPECT_EQ(result.count, 1u);
+    }
+}
+
+TEST_CASE(shared_regex_cache)
+{
+    SharedRegex<ECMA262>::clear_cache();
+
+    auto first = SharedRegex<ECMA262>::compile("shared(cache)?"sv, ECMAScriptFlags::Global);
+    auto second = SharedRegex<ECMA262>::compile("shared(cache)?"sv, ECMAScriptFlags::Global);
+    auto other_flags = SharedRegex<ECMA262>::compile("shared(cache)?"sv, ECMAScriptFlags::Insensitive);
+
+    EXPECT_EQ(first.ptr(), second.ptr());
+    EXPECT_NE(first.ptr(), other_flags.ptr());
+
+    auto statistics = SharedRegex<ECMA262>::cache_statistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 2u);
+    EXPECT_EQ(statistics.entry_count, 2u);
+
+    // Patterns that fail to compile are never cached.
+    auto invalid = SharedRegex<ECMA262>::compile("(unterminated"sv);
+    EXPECT_NE(invalid->regex().parser_result.error, regex::Error::NoError);
+    EXPECT_EQ(SharedRegex<ECMA262>::cache_statistics().entry_count, 2u);
+
+    // Regex instances get their own copy of the shared program.
+    Regex<ECMA262> re("shared(cache)?"sv, ECMAScriptFlags::Global);
+    EXPECT_EQ(SharedRegex<ECMA262>::cache_statistics().hits, 2u);
+    auto result = re.match("sharedcache shared"sv);
+    EXPECT_EQ(result.count, 2u);
+    EXPECT_EQ(first->regex().match("sharedcache shared"sv).count, 2u);
+
+    // Parse results handed in from elsewhere (e.g. JS regex literals) hit the same cache entries.
+    auto parse_result = Regex<ECMA262>::parse_pattern("shared(cache)?"sv, ECMAScriptFlags::Global);
+    auto from_parse_result = SharedRegex<ECMA262>::compile(move(parse_result), "shared(cache)?", ECMAScriptFlags::Global);
+    EXPECT_EQ(from_parse_result.ptr(), first.ptr());
+}
+
 TEST_CASE(optimizer_atomic_groups)
 {
     Array tests {
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibWeb/HTML/BackForwardCache.h>
+
+using Web::HTML::BackForwardCachePolicy;
+
+static BackForwardCachePolicy::Entry entry_stored_at(MonotonicTime stored_at, size_t estimated_memory_bytes = 1 * MiB)
+{
+    return { .estimated_memory_bytes = estimated_memory_bytes, .stored_at = stored_at };
+}
+
+TEST_CASE(entries_within_budget_are_kept)
+{
+    BackForwardCachePolicy policy;
+    auto now = MonotonicTime::now();
+
+    EXPECT_EQ(policy.number_of_entries_to_evict({}, now), 0u);
+
+    Vector<BackForwardCachePolicy::Entry> entries;
+    for (size_t i = 0; i < policy.maximum_documents; ++i)
+        entries.append(entry_stored_at(now - AK::Duration::from_seconds(60)));
+    EXPECT_EQ(policy.number_of_entries_to_evict(entries, now), 0u);
+}
+
+TEST_CASE(least_recently_stored_entries_are_evicted_over_the_document_limit)
+{
+    BackForwardCachePolicy policy;
+    policy.maximum_documents = 2;
+    auto now = MonotonicTime::now();
+
+    Vector<BackForwardCachePolicy::Entry> entries;
+    for (size_t i = 0; i < 5; ++i)
+        entries.append(entry_stored_at(now));
+    EXPECT_EQ(policy.number_of_entries_to_evict(entries, now), 3u);
+}
+
+TEST_CASE(least_recently_stored_entries_are_evicted_over_the_memory_limit)
+{
+    BackForwardCachePolicy policy;
+    policy.maximum_memory_bytes = 10 * MiB;
+    auto now = MonotonicTime::now();
+
+    Vector<BackForwardCachePolicy::Entry> entries;
+    entries.append(entry_stored_at(now, 4 * MiB));
+    entries.append(entry_stored_at(now, 4 * MiB));
+    entries.append(entry_stored_at(now, 4 * MiB));
+    EXPECT_EQ(policy.number_of_entries_to_evict(entries, now), 1u);
+
+    // A single document that doesn't fit is evicted right away.
+    entries.append(entry_stored_at(now, 12 * MiB));
+    EXPECT_EQ(policy.number_of_entries_to_evict(entries, now), 4u);
+}
+
+TEST_CASE(expired_entries_are_evicted)
+{
+    BackForwardCachePolicy policy;
+    auto now = MonotonicTime::now() + policy.time_to_live + policy.time_to_live;
+
+    Vector<BackForwardCachePolicy::Entry> entries;
+    entries.append(entry_stored_at(now - policy.time_to_live - AK::Duration::from_seconds(1)));
+    entries.append(entry_stored_at(now - policy.time_to_live));
+    entries.append(entry_stored_at(now - AK::Duration::from_seconds(1)));
+    EXPECT_EQ(policy.number_of_entries_to_evict(entries, now), 2u);
+}
+
+TEST_CASE(next_expiry_is_that_of_the_least_recently_stored_entry)
+{
+    BackForwardCachePolicy policy;
+    auto now = MonotonicTime::now() + policy.time_to_live + policy.time_to_live;
+
+    EXPECT(!policy.time_until_next_expiry({}, now).has_value());
+
+    Vector<BackForwardCachePolicy::Entry> entries;
+    entries.append(entry_stored_at(now - AK::Duration::from_seconds(60)));
+    entries.append(entry_stored_at(now));
+    EXPECT_EQ(policy.time_until_next_expiry(entries, now), policy.time_to_live - AK::Duration::from_seconds(60));
+
+    // Entries that have already expired are due right away.
+    entries[0] = entry_stored_at(now - policy.time_to_live - AK::Duration::from_seconds(1));
+    EXPECT_EQ(policy.time_until_next_expiry(entries, now), AK::Duration::zero());
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibWeb/HTML/BackgroundThrottling.h>
+
+using Web::HTML::BackgroundThrottlingPolicy;
+
+// A point in time that lies exactly on a minute boundary, so that alignments are easy to reason about.
+static MonotonicTime minute_boundary()
+{
+    auto now = MonotonicTime::now() + AK::Duration::from_seconds(10 * 60);
+    return now - AK::Duration::from_nanoseconds(now.nanoseconds() % AK::Duration::from_seconds(60).to_nanoseconds());
+}
+
+TEST_CASE(timers_in_visible_documents_are_not_throttled)
+{
+    BackgroundThrottlingPolicy policy;
+    auto now = minute_boundary() + AK::Duration::from_milliseconds(100);
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(50), {}, 1), AK::Duration::from_milliseconds(50));
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(50), {}, 10), AK::Duration::from_milliseconds(50));
+}
+
+TEST_CASE(timers_in_hidden_documents_are_aligned_to_seconds)
+{
+    BackgroundThrottlingPolicy policy;
+    auto now = minute_boundary() + AK::Duration::from_milliseconds(100);
+    auto hidden_since = now - AK::Duration::from_seconds(1);
+
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(50), hidden_since, 1), AK::Duration::from_milliseconds(900));
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(900), hidden_since, 1), AK::Duration::from_milliseconds(900));
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(1000), hidden_since, 1), AK::Duration::from_milliseconds(1900));
+
+    // Chained timers are only throttled more once the document has been hidden for a while.
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(50), hidden_since, 10), AK::Duration::from_milliseconds(900));
+}
+
+TEST_CASE(chained_timers_in_documents_hidden_for_a_long_time_are_aligned_to_minutes)
+{
+    BackgroundThrottlingPolicy policy;
+    auto now = minute_boundary() + AK::Duration::from_seconds(1);
+    auto hidden_since = now - AK::Duration::from_seconds(6 * 60);
+
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(10), hidden_since, 6), AK::Duration::from_seconds(59));
+
+    // Timers that aren't chained still only get aligned to seconds.
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(10), hidden_since, 5), AK::Duration::from_milliseconds(990));
+}
+
+TEST_CASE(disabled_policy_does_not_throttle)
+{
+    BackgroundThrottlingPolicy policy;
+    policy.enabled = false;
+    auto now = minute_boundary() + AK::Duration::from_seconds(1);
+    auto hidden_since = now - AK::Duration::from_seconds(6 * 60);
+    EXPECT_EQ(policy.throttled_timer_delay(now, AK::Duration::from_milliseconds(10), hidden_since, 6), AK::Duration::from_milliseconds(10));
+}
+
+TEST_CASE(timers_firing_together_count_as_one_wake_up)
+{
+    Web::HTML::TimerWakeUpMetrics metrics;
+    auto start = minute_boundary();
+
+    metrics.did_fire_timer(start, true);
+    metrics.did_fire_timer(start, true);
+    metrics.did_fire_timer(start + AK::Duration::from_microseconds(100), false);
+    EXPECT_EQ(metrics.wake_ups(), 1u);
+    EXPECT_EQ(metrics.throttled_timers(), 2u);
+
+    metrics.did_fire_timer(start + AK::Duration::from_milliseconds(500), false);
+    EXPECT_EQ(metrics.wake_ups(), 2u);
+
+    // The per-second rate is updated once a second is over.
+    metrics.did_fire_timer(start + AK::Duration::from_milliseconds(1200), false);
+    EXPECT_EQ(metrics.wake_ups(), 3u);
+    EXPECT_EQ(metrics.wake_ups_per_second(), 2u);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Font/Font.h>
+#include <LibWeb/CSS/CalculationResolutionContext.h>
+#include <LibWeb/CSS/StyleValues/CalculatedStyleValue.h>
+
+using namespace Web::CSS;
+
+static CalculationContext const length_percentage_context { .percentages_resolve_as = ValueType::Length };
+
+static NonnullRefPtr<CalculationNode const> px(double value)
+{
+    return NumericCalculationNode::create(Length::make_px(value), length_percentage_context);
+}
+
+static NonnullRefPtr<CalculationNode const> em(double value)
+{
+    return NumericCalculationNode::create(Length { value, LengthUnit::Em }, length_percentage_context);
+}
+
+static NonnullRefPtr<CalculationNode const> percent(double value)
+{
+    return NumericCalculationNode::create(Percentage { value }, length_percentage_context);
+}
+
+static NonnullRefPtr<CalculationNode const> number(double value)
+{
+    return NumericCalculationNode::create(Number { Number::Type::Number, value }, length_percentage_context);
+}
+
+static NonnullRefPtr<CalculatedStyleValue const> length_percentage_calculation(NonnullRefPtr<CalculationNode const> calculation)
+{
+    NumericType type { NumericType::BaseType::Length, 1 };
+    type.set_percent_hint(NumericType::BaseType::Length);
+    return CalculatedStyleValue::create(move(calculation), type, length_percentage_context);
+}
+
+static CalculationResolutionContext resolution_context(double percentage_basis_px)
+{
+    Length::FontMetrics font_metrics { 16, Gfx::FontPixelMetrics {}, 20 };
+    return {
+        .percentage_basis = Length::make_px(percentage_basis_px),
+        .length_resolution_context = Length::ResolutionContext {
+            .viewport_rect = { 0, 0, 800, 600 },
+            .font_metrics = font_metrics,
+            .root_font_metrics = font_metrics,
+        },
+    };
+}
+
+// calc(50% - 2em + 10px)
+static NonnullRefPtr<CalculationNode const> percentage_minus_em_plus_px()
+{
+    return SumCalculationNode::create({ percent(50), NegateCalculationNode::create(em(2)), px(10) });
+}
+
+TEST_CASE(resolve_linear_calculations)
+{
+    auto context = resolution_context(200);
+
+    EXPECT_EQ(length_percentage_calculation(px(10))->resolve_length(context)->raw_value(), 10.0);
+    EXPECT_EQ(length_percentage_calculation(percentage_minus_em_plus_px())->resolve_length(context)->raw_value(), 78.0);
+
+    // calc((25% + 1em) * 2 / 4)
+    auto scaled_sum = ProductCalculationNode::create({ SumCalculationNode::create({ percent(25), em(1) }), number(2), InvertCalculationNode::create(number(4)) });
+    EXPECT_EQ(length_percentage_calculation(scaled_sum)->resolve_length(context)->raw_value(), 33.0);
+}
+
+TEST_CASE(flattened_calculation_matches_simplified_calculation_tree)
+{
+    // min() with a single argument isn't flattened, so it resolves the same calculation by simplifying the tree.
+    Vector<NonnullRefPtr<CalculationNode const>> calculations {
+        percentage_minus_em_plus_px(),
+        ProductCalculationNode::create({ number(3), SumCalculationNode::create({ percent(12.5), px(0.3) }) }),
+        NegateCalculationNode::create(SumCalculationNode::create({ em(1.25), percent(-7) })),
+    };
+
+    for (double basis : { 0.0, 1.0, 333.3, 1920.0 }) {
+        auto context = resolution_context(basis);
+        for (auto const& calculation : calculations) {
+            auto flattened = length_percentage_calculation(calculation)->resolve_length(context);
+            auto simplified = length_percentage_calculation(MinCalculationNode::create({ calculation }))->resolve_length(context);
+            EXPECT(flattened.has_value());
+            EXPECT(simplified.has_value());
+            EXPECT_APPROXIMATE(flattened->raw_value(), simplified->raw_value());
+        }
+    }
+}
+
+BENCHMARK_CASE(resolve_length_percentage_calculation)
+{
+    auto calculation = length_percentage_calculation(percentage_minus_em_plus_px());
+    auto context = resolution_context(640);
+
+    for (size_t i = 0; i < 1'000'000; ++i) {
+        auto length = calculation->resolve_length(context);
+        EXPECT(length.has_value());
+    }
+}
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/NonnullOwnPtr.h>
+#include <LibWeb/CSS/CompiledSelector.h>
+#include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/Namespace.h>
+
+using Web::CSS::CompiledSelector;
+using Web::CSS::Selector;
+
+static NonnullRefPtr<Selector> parse_single_selector(StringView selector_text)
+{
+    auto selectors = Web::parse_selector(Web::CSS::Parser::ParsingParams {}, selector_text);
+    VERIFY(selectors.has_value() && selectors->size() == 1);
+    return selectors->first();
+}
+
+static bool is_compiled(StringView selector_text)
+{
+    auto selector = parse_single_selector(selector_text);
+    selector->compile_if_possible();
+    return selector->compiled_selector() != nullptr;
+}
+
+// The unit tests can't create a DOM, so selectors are matched against this instead. It has the accessors of
+// DOM::Element that compiled selectors use.
+class TestElement {
+public:
+    TestElement(TestElement const* parent, StringView local_name, StringView classes)
+        : m_parent(parent)
+        , m_local_name(MUST(FlyString::from_utf8(local_name)))
+        , m_namespace_uri(Web::Namespace::HTML)
+    {
+        classes.for_each_split_view(' ', SplitBehavior::Nothing, [&](auto class_name) {
+            m_classes.append(MUST(FlyString::from_utf8(class_name)));
+        });
+    }
+
+    FlyString const& local_name() const { return m_local_name; }
+    Optional<FlyString> const& namespace_uri() const { return m_namespace_uri; }
+    Optional<FlyString> const& id() const { return m_id; }
+    TestElement const* parent_element() const { return m_parent; }
+
+    bool has_class(FlyString const& class_name, CaseSensitivity case_sensitivity = CaseSensitivity::CaseSensitive) const
+    {
+        for (auto const& name : m_classes) {
+            if (case_sensitivity == CaseSensitivity::CaseSensitive ? name == class_name : name.equals_ignoring_ascii_case(class_name))
+                return true;
+        }
+        return false;
+    }
+
+    Optional<String> get_attribute(FlyString const& name) const
+    {
+        for (auto const& attribute : m_attributes) {
+            if (attribute.name == name)
+                return attribute.value;
+        }
+        return {};
+    }
+
+    void set_id(StringView id) { m_id = MUST(FlyString::from_utf8(id)); }
+    void set_attribute(StringView name, StringView value) { m_attributes.append({ MUST(FlyString::from_utf8(name)), MUST(String::from_utf8(value)) }); }
+
+private:
+    struct Attribute {
+        FlyString name;
+        String value;
+    };
+
+    TestElement const* m_parent { nullptr };
+    FlyString m_local_name;
+    Optional<FlyString> m_namespace_uri;
+    Optional<FlyString> m_id;
+    Vector<FlyString> m_classes;
+    Vector<Attribute> m_attributes;
+};
+
+// A document in the style of the ones built with large CSS frameworks.
+static Vector<NonnullOwnPtr<TestElement>> create_framework_document()
+{
+    Vector<NonnullOwnPtr<TestElement>> elements;
+    auto append = [&](TestElement const* parent, StringView local_name, StringView classes = {}) -> TestElement& {
+        elements.append(make<TestElement>(parent, local_name, classes));
+        return *elements.last();
+    };
+
+    auto& html = append(nullptr, "html"sv);
+    auto& body = append(&html, "body"sv);
+    body.set_id("app"sv);
+
+    auto& navbar = append(&body, "nav"sv, "navbar"sv);
+    auto& nav = append(&navbar, "ul"sv, "nav"sv);
+    for (size_t i = 0; i < 10; ++i) {
+        auto& item = append(&nav, "li"sv, "nav-item"sv);
+        append(&item, "a"sv, i == 0 ? "nav-link active"sv : "nav-link"sv);
+    }
+
+    auto& container = append(&body, "div"sv, "container"sv);
+    for (size_t i = 0; i < 20; ++i) {
+        auto& row = append(&container, "div"sv, "row"sv);
+        for (size_t j = 0; j < 3; ++j) {
+            auto& col = append(&row, "div"sv, "col"sv);
+            auto& card = append(&col, "div"sv, "card"sv);
+            auto& card_body = append(&card, "div"sv, "card-body"sv);
+            append(&card_body, "h5"sv, "card-title"sv);
+            append(&card_body, "p"sv, "card-text"sv);
+            append(&card_body, "button"sv, j == 0 ? "btn btn-primary"sv : "btn btn-secondary"sv);
+            auto& checkbox = append(&card_body, "input"sv, "form-check-input"sv);
+            checkbox.set_attribute("type"sv, "checkbox"sv);
+            if (j == 2)
+                checkbox.set_attribute("hidden"sv, ""sv);
+        }
+    }
+
+    auto& table = append(&container, "table"sv, "table"sv);
+    auto& tbody = append(&table, "tbody"sv);
+    for (size_t i = 0; i < 30; ++i) {
+        auto& tr = append(&tbody, "tr"sv);
+        for (size_t j = 0; j < 4; ++j)
+            append(&tr, "td"sv);
+    }
+
+    auto& modal = append(&body, "div"sv, "modal show"sv);
+    auto& dialog = append(&modal, "div"sv, "modal-dialog"sv);
+    append(&dialog, "div"sv, "modal-content"sv);
+
+    return elements;
+}
+
+// Selectors in the style of the ones found in large framework style sheets.
+static constexpr Array framework_selectors {
+    ".btn"sv,
+    ".btn.btn-primary"sv,
+    "a.nav-link"sv,
+    ".navbar .nav-item"sv,
+    ".card > .card-body"sv,
+    ".table > tbody > tr > td"sv,
+    "input[type=checkbox]"sv,
+    "[hidden]"sv,
+    ".modal.show .modal-dialog"sv,
+    "#app .container .row > .col"sv,
+    ".container .card-body > .btn"sv,
+    "body > .container td"sv,
+};
+
+// This interprets the selector the same way SelectorEngine::fast_matches() does, one simple selector at a time, to
+// compare compiled selectors against.
+static bool interpreted_matches_compound_selector(Selector::CompoundSelector const& compound_selector, TestElement const& element)
+{
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        switch (simple_selector.type) {
+        case Selector::SimpleSelector::Type::Universal:
+            break;
+        case Selector::SimpleSelector::Type::TagName:
+            if (element.namespace_uri() == Web::Namespace::HTML) {
+                if (simple_selector.qualified_name().name.lowercase_name != element.local_name())
+                    return false;
+            } else if (simple_selector.qualified_name().name.name != element.local_name()) {
+                return false;
+            }
+            break;
+        case Selector::SimpleSelector::Type::Class:
+            if (!element.has_class(simple_selector.name()))
+                return false;
+            break;
+        case Selector::SimpleSelector::Type::Id:
+            if (simple_selector.name() != element.id())
+                return false;
+            break;
+        case Selector::SimpleSelector::Type::Attribute: {
+            auto const& attribute = simple_selector.attribute();
+            auto value = element.get_attribute(attribute.qualified_name.name.name);
+            if (!value.has_value())
+                return false;
+            if (attribute.match_type == Selector::SimpleSelector::Attribute::MatchType::ExactValueMatch && *value != attribute.value)
+                return false;
+            break;
+        }
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+    return true;
+}
+
+static bool interpreted_matches(Selector const& selector, TestElement const& element_to_match)
+{
+    TestElement const* current = &element_to_match;
+    ssize_t compound_selector_index = selector.compound_selectors().size() - 1;
+
+    if (!interpreted_matches_compound_selector(selector.compound_selectors().last(), *current))
+        return false;
+
+    struct {
+        TestElement const* element { nullptr };
+        ssize_t compound_selector_index = 0;
+    } backtrack_state;
+
+    for (;;) {
+        auto const* compound_selector = &selector.compound_selectors()[compound_selector_index];
+
+        switch (compound_selector->combinator) {
+        case Selector::Combinator::None:
+            return true;
+        case Selector::Combinator::Descendant:
+            backtrack_state = { current->parent_element(), compound_selector_index };
+            compound_selector = &selector.compound_selectors()[--compound_selector_index];
+            for (current = current->parent_element(); current; current = current->parent_element()) {
+                if (interpreted_matches_compound_selector(*compound_selector, *current))
+                    break;
+            }
+            if (!current)
+                return false;
+            break;
+        case Selector::Combinator::ImmediateChild:
+            compound_selector = &selector.compound_selectors()[--compound_selector_index];
+            current = current->parent_element();
+            if (!current)
+                return false;
+            if (!interpreted_matches_compound_selector(*compound_selector, *current)) {
+                if (backtrack_state.element) {
+                    current = backtrack_state.element;
+                    compound_selector_index = backtrack_state.compound_selector_index;
+                    continue;
+                }
+                return false;
+            }
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+}
+
+static CompiledSelector::MatchState<TestElement> const html_document_match_state { .is_html_document = true };
+
+static Vector<NonnullRefPtr<Selector>> compile_framework_selectors()
+{
+    Vector<NonnullRefPtr<Selector>> selectors;
+    for (auto selector_text : framework_selectors) {
+        auto selector = parse_single_selector(selector_text);
+        selector->compile_if_possible();
+        VERIFY(selector->compiled_selector());
+        selectors.append(move(selector));
+    }
+    return selectors;
+}
+
+TEST_CASE(compile_simple_selectors)
+{
+    EXPECT(is_compiled("div"sv));
+    EXPECT(is_compiled("*"sv));
+    EXPECT(is_compiled("*|div"sv));
+    EXPECT(is_compiled("|div"sv));
+    EXPECT(is_compiled("#main"sv));
+    EXPECT(is_compiled(".foo.bar"sv));
+    EXPECT(is_compiled("div.foo#main"sv));
+    EXPECT(is_compiled("input[type=text]"sv));
+    EXPECT(is_compiled("input[type=text i]"sv));
+    EXPECT(is_compiled("input[type=text s]"sv));
+    EXPECT(is_compiled("[hidden]"sv));
+    EXPECT(is_compiled(".a .b"sv));
+    EXPECT(is_compiled("ul > li"sv));
+    EXPECT(is_compiled(".a > .b .c > .d"sv));
+
+    for (auto selector_text : framework_selectors)
+        EXPECT(is_compiled(selector_text));
+}
+
+TEST_CASE(do_not_compile_other_selectors)
+{
+    EXPECT(!is_compiled("a:hover"sv));
+    EXPECT(!is_compiled("li:first-child"sv));
+    EXPECT(!is_compiled(":is(.a, .b)"sv));
+    EXPECT(!is_compiled("p::before"sv));
+    EXPECT(!is_compiled("h1 + p"sv));
+    EXPECT(!is_compiled("h1 ~ p"sv));
+    EXPECT(!is_compiled("a[href^=https]"sv));
+    EXPECT(!is_compiled("[lang|=en]"sv));
+    EXPECT(!is_compiled("[class~=foo]"sv));
+    EXPECT(!is_compiled("*|*[*|foo]"sv));
+    EXPECT(!is_compiled("#a#b"sv));
+}
+
+TEST_CASE(compiled_selectors_match_like_interpreted_selectors)
+{
+    auto elements = create_framework_document();
+    auto selectors = compile_framework_selectors();
+
+    for (auto const& selector : selectors) {
+        size_t matched_elements = 0;
+        for (auto const& element : elements) {
+            bool matches = selector->compiled_selector()->matches(*element, html_document_match_state);
+            EXPECT_EQ(matches, interpreted_matches(*selector, *element));
+            if (matches)
+                ++matched_elements;
+        }
+        EXPECT(matched_elements > 0);
+    }
+}
+
+TEST_CASE(compiled_selectors_backtrack_after_child_combinators)
+{
+    // <div class=a><div class=b><div class=b><span class=c>: `.a > .b .c` only matches through the outer .b.
+    Vector<NonnullOwnPtr<TestElement>> elements;
+    elements.append(make<TestElement>(nullptr, "div"sv, "a"sv));
+    elements.append(make<TestElement>(elements.last().ptr(), "div"sv, "b"sv));
+    elements.append(make<TestElement>(elements.last().ptr(), "div"sv, "b"sv));
+    elements.append(make<TestElement>(elements.last().ptr(), "span"sv, "c"sv));
+
+    auto selector = parse_single_selector(".a > .b .c"sv);
+    selector->compile_if_possible();
+    EXPECT(selector->compiled_selector()->matches(*elements.last(), html_document_match_state));
+
+    auto no_match = parse_single_selector(".a > .c"sv);
+    no_match->compile_if_possible();
+    EXPECT(!no_match->compiled_selector()->matches(*elements.last(), html_document_match_state));
+}
+
+BENCHMARK_CASE(match_framework_selectors_interpreted)
+{
+    auto elements = create_framework_document();
+    auto selectors = compile_framework_selectors();
+
+    size_t matches = 0;
+    for (size_t i = 0; i < 2'000; ++i) {
+        for (auto const& selector : selectors) {
+            for (auto const& element : elements) {
+                if (interpreted_matches(*selector, *element))
+                    ++matches;
+            }
+        }
+    }
+    EXPECT(matches > 0);
+}
+
+BENCHMARK_CASE(match_framework_selectors_compiled)
+{
+    auto elements = create_framework_document();
+    auto selectors = compile_framework_selectors();
+
+    size_t matches = 0;
+    for (size_t i = 0; i < 2'000; ++i) {
+        for (auto const& selector : selectors) {
+            auto const& compiled_selector = *selector->compiled_selector();
+            for (auto const& element : elements) {
+                if (compiled_selector.matches(*element, html_document_match_state))
+                    ++matches;
+            }
+        }
+    }
+    EXPECT(matches > 0);
+}
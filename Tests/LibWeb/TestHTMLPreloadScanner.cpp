@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026, CryFox Developers
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibURL/Parser.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+
+using Destination = Web::Fetch::Infrastructure::Request::Destination;
+using Web::HTML::CORSSettingAttribute;
+
+static Vector<Web::HTML::SpeculativeFetch> find_fetches(StringView input, double device_pixel_ratio = 1)
+{
+    Web::HTML::HTMLPreloadScanner::Options options {
+        .base_url = URL::Parser::basic_parse("https://example.com/dir/page.html"sv).release_value(),
+        .device_pixel_ratio = device_pixel_ratio,
+    };
+    return Web::HTML::HTMLPreloadScanner::find_speculative_fetches(input, options);
+}
+
+static Vector<String> find_urls(StringView input, double device_pixel_ratio = 1)
+{
+    Vector<String> urls;
+    for (auto const& fetch : find_fetches(input, device_pixel_ratio))
+        urls.append(fetch.url.serialize());
+    return urls;
+}
+
+TEST_CASE(scripts_style_sheets_and_images)
+{
+    auto fetches = find_fetches(R"~~~(
+        <!DOCTYPE html>
+        <link rel="stylesheet" href="style.css">
+        <script src="/app.js"></script>
+        <script type="module" src="module.js"></script>
+        <img src="https://cdn.example.com/image.png">
+    )~~~"sv);
+
+    EXPECT_EQ(fetches.size(), 4u);
+    EXPECT_EQ(fetches[0].url.serialize(), "https://example.com/dir/style.css"sv);
+    EXPECT_EQ(fetches[0].destination, Destination::Style);
+    EXPECT_EQ(fetches[1].url.serialize(), "https://example.com/app.js"sv);
+    EXPECT_EQ(fetches[1].destination, Destination::Script);
+    EXPECT_EQ(fetches[1].cors_setting, CORSSettingAttribute::NoCORS);
+    EXPECT_EQ(fetches[2].url.serialize(), "https://example.com/dir/module.js"sv);
+    EXPECT_EQ(fetches[2].cors_setting, CORSSettingAttribute::Anonymous);
+    EXPECT_EQ(fetches[3].url.serialize(), "https://cdn.example.com/image.png"sv);
+    EXPECT_EQ(fetches[3].destination, Destination::Image);
+}
+
+TEST_CASE(skip_what_would_not_be_fetched)
+{
+    auto urls = find_urls(R"~~~(
+        <script nomodule src="legacy.js"></script>
+        <script type="application/json" src="data.json"></script>
+        <link rel="alternate stylesheet" href="alternate.css">
+        <link rel="preload" as="track" href="captions.vtt">
+        <img src="lazy.png" loading="lazy">
+        <img src="data:image/png;base64,AAAA">
+        <script src="kept.js"></script>
+    )~~~"sv);
+
+    EXPECT_EQ(urls, Vector<String> { "https://example.com/dir/kept.js"_string });
+}
+
+TEST_CASE(preload_links)
+{
+    auto fetches = find_fetches(R"~~~(
+        <link rel="preload" as="font" href="font.woff2">
+        <link rel="preload" as="image" href="hero.jpg">
+        <link rel="modulepreload" href="chunk.js" crossorigin="use-credentials">
+    )~~~"sv);
+
+    EXPECT_EQ(fetches.size(), 3u);
+    EXPECT_EQ(fetches[0].destination, Destination::Font);
+    EXPECT_EQ(fetches[0].cors_setting, CORSSettingAttribute::Anonymous);
+    EXPECT_EQ(fetches[1].destination, Destination::Image);
+    EXPECT_EQ(fetches[1].cors_setting, CORSSettingAttribute::NoCORS);
+    EXPECT_EQ(fetches[2].destination, Destination::Script);
+    EXPECT_EQ(fetches[2].cors_setting, CORSSettingAttribute::UseCredentials);
+}
+
+TEST_CASE(first_base_element_sets_the_base_url)
+{
+    auto urls = find_urls(R"~~~(
+        <script src="before.js"></script>
+        <base href="https://static.example.com/assets/">
+        <base href="https://ignored.example.com/">
+        <script src="after.js"></script>
+    )~~~"sv);
+
+    EXPECT_EQ(urls, (Vector<String> { "https://example.com/dir/before.js"_string, "https://static.example.com/assets/after.js"_string }));
+}
+
+TEST_CASE(markup_in_text_content_is_not_scanned)
+{
+    auto urls = find_urls(R"~~~(
+        <script>document.write('<script src="written.js"></scr' + 'ipt>');</script>
+        <textarea><img src="textarea.png"></textarea>
+        <style>/* <link rel="stylesheet" href="style.css"> */</style>
+        <noscript><img src="noscript.png"></noscript>
+        <template><img src="template.png"></template>
+        <svg><script href="svg.js"></script></svg>
+        <!-- <script src="comment.js"></script> -->
+        <script src="real.js"></script>
+    )~~~"sv);
+
+    EXPECT_EQ(urls, Vector<String> { "https://example.com/dir/real.js"_string });
+}
+
+TEST_CASE(srcset_selection)
+{
+    auto input = R"~~~(<img src="1x.png" srcset="2x.png 2x, 3x.png 3x">)~~~"sv;
+    EXPECT_EQ(find_urls(input, 1), Vector<String> { "https://example.com/dir/1x.png"_string });
+    EXPECT_EQ(find_urls(input, 2), Vector<String> { "https://example.com/dir/2x.png"_string });
+    EXPECT_EQ(find_urls(input, 2.5), Vector<String> { "https://example.com/dir/3x.png"_string });
+    EXPECT_EQ(find_urls(input, 4), Vector<String> { "https://example.com/dir/3x.png"_string });
+
+    // Width descriptors depend on layout, so the src is fetched instead.
+    EXPECT_EQ(find_urls(R"~~~(<img src="fallback.png" srcset="small.png 480w, large.png 1080w">)~~~"sv),
+        Vector<String> { "https://example.com/dir/fallback.png"_string });
+}
@@ -73,7 +73,14 @@ using Token = Web::HTML::HTMLToken;
     VERIFY(last_token);                         \
     EXPECT_EQ(last_token->attribute_count(), (size_t)(count));
 
-static Vector<Token> run_tokenizer(StringView input)
+enum class SplitCharacterRuns {
+    No,
+    Yes,
+};
+
+// NOTE: Most tests only care about which characters are emitted, not how they are grouped into runs, so by default a
+//       run is split into a character token for each of its code points. Only the first of these has a position.
+static Vector<Token> run_tokenizer(StringView input, SplitCharacterRuns split_character_runs = SplitCharacterRuns::Yes)
 {
     Vector<Token> tokens;
     Tokenizer tokenizer { input, "UTF-8"sv };
@@ -81,17 +88,49 @@ static Vector<Token> run_tokenizer(StringView input)
         auto maybe_token = tokenizer.next_token();
         if (!maybe_token.has_value())
             break;
-        tokens.append(maybe_token.release_value());
+        auto token = maybe_token.release_value();
+        if (split_character_runs == SplitCharacterRuns::No || !token.is_character_run()) {
+            tokens.append(move(token));
+            continue;
+        }
+        Vector<u32> code_points;
+        token.for_each_code_point([&](u32 code_point) {
+            code_points.append(code_point);
+        });
+        token.set_code_point(code_points.first());
+        tokens.append(move(token));
+        for (auto code_point : code_points.span().slice(1))
+            tokens.append(Token::make_character(code_point));
     }
     return tokens;
 }
 
 // FIXME: It's not very nice to rely on the format of HTMLToken::to_string() to stay the same.
+// NOTE: Character runs are hashed as if each of their code points was a token of its own, positioned after the code point.
 static u32 hash_tokens(Vector<Token> const& tokens)
 {
     StringBuilder builder;
-    for (auto& token : tokens)
-        builder.append(token.to_string());
+    for (auto& token : tokens) {
+        if (!token.is_character_run()) {
+            builder.append(token.to_string());
+            continue;
+        }
+        auto position = token.start_position();
+        bool is_first_code_point = true;
+        token.for_each_code_point([&](u32 code_point) {
+            if (!exchange(is_first_code_point, false)) {
+                if (code_point == '\n') {
+                    position.column = 0;
+                    position.line++;
+                } else {
+                    position.column++;
+                }
+            }
+            builder.append("Character { data: '"sv);
+            builder.append_code_point(code_point);
+            builder.appendff("' }}@{}:{}", position.line, position.column);
+        });
+    }
     return (u32)builder.string_view().hash();
 }
 
@@ -275,3 +314,92 @@ TEST_CASE(ambiguous_ampersand_offset)
     EXPECT_EQ(token.start_position().line, 0u);
     EXPECT_EQ(token.start_position().column, 1u);
 }
+
+TEST_CASE(long_text_and_attribute_values)
+{
+    auto tokens = run_tokenizer("<p title=\"a long attribute value &amp; more\">Some longer text\r\nover &lt;two&gt; lines.</p>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 44u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(title, "a long attribute value & more", 3u, 8u, 9u, 44u);
+    EXPECT_CHARACTER_TOKENS(Some longer text);
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKENS(over);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN('<');
+    EXPECT_CHARACTER_TOKENS(two);
+    EXPECT_CHARACTER_TOKEN('>');
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(lines.);
+    EXPECT_EQ(current_token->start_position().line, 1u);
+    EXPECT_END_TAG_TOKEN(p, 25u, 26u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(text_is_emitted_in_runs)
+{
+    auto tokens = run_tokenizer("<p>Some text &amp; more</p>"sv, SplitCharacterRuns::No);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    EXPECT(current_token->is_character_run());
+    EXPECT_EQ(current_token->character_run().utf16_view(), u"Some text "sv);
+    EXPECT_EQ(current_token->start_position().column, 4u);
+    NEXT_TOKEN();
+    EXPECT_CHARACTER_TOKEN('&');
+    EXPECT(current_token->is_character_run());
+    EXPECT_EQ(current_token->character_run().utf16_view(), u" more"sv);
+    NEXT_TOKEN();
+    EXPECT_END_TAG_TOKEN(p, 25u, 26u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(text_longer_than_a_run)
+{
+    StringBuilder builder;
+    builder.append_repeated('a', 5000);
+    builder.append('\n');
+    builder.append_repeated('b', 10);
+    auto tokens = run_tokenizer(builder.string_view(), SplitCharacterRuns::No);
+
+    EXPECT_EQ(tokens.size(), 3u);
+    EXPECT(tokens[0].is_character_run());
+    EXPECT_EQ(tokens[0].character_run().length_in_code_units(), Tokenizer::maximum_character_run_length);
+    EXPECT_EQ(tokens[0].start_position().line, 0u);
+    EXPECT_EQ(tokens[0].start_position().column, 1u);
+
+    EXPECT(tokens[1].is_character_run());
+    EXPECT_EQ(tokens[1].character_run().length_in_code_units(), 5000 - Tokenizer::maximum_character_run_length + 1 + 10);
+    EXPECT_EQ(tokens[1].start_position().line, 0u);
+    EXPECT_EQ(tokens[1].start_position().column, Tokenizer::maximum_character_run_length + 1);
+
+    EXPECT(tokens.last().is_end_of_file());
+}
+
+BENCHMARK_CASE(tokenize_large_document)
+{
+    StringBuilder builder;
+    builder.append("<!DOCTYPE html><html><head><title>Benchmark</title></head><body>"sv);
+    for (size_t i = 0; i < 20'000; ++i) {
+        builder.appendff("<div class=\"row item-{}\" data-description=\"A fairly long attribute value, as server-rendered pages tend to have\">", i);
+        builder.append("<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>"sv);
+        builder.append("<script>var value = compute(1, 2, 3) * 4; if (value > 10) console.log(value);</script></div>\n"sv);
+    }
+    builder.append("</body></html>"sv);
+    auto input = builder.to_byte_string();
+
+    for (size_t i = 0; i < 5; ++i) {
+        Tokenizer tokenizer { input, "UTF-8"sv };
+        size_t token_count = 0;
+        while (true) {
+            auto token = tokenizer.next_token();
+            if (!token.has_value() || token->is_end_of_file())
+                break;
+            ++token_count;
+            // NOTE: The tree builder would do this when it sees the script element.
+            if (token->is_start_tag() && token->tag_name() == "script"sv)
+                tokenizer.switch_to(Tokenizer::State::ScriptData);
+        }
+        EXPECT(token_count > 20'000u);
+    }
+}